@@ -61,11 +61,19 @@ namespace cells{
    extern std::vector < double > num_macro_cells_fft; /// lateral size of local macro-cells (A)
    extern std::vector<double> fft_cell_id_array;
 
+   extern bool magnetisation_in_statistics; /// calculate cell magnetisation in statistics sweep
+   extern bool magnetisation_dirty; /// spins changed since statistics sweep calculated cell magnetisation
+
    //---------------------------------------------------------------------------
    // Function to calculate magnetisation in cells
    //---------------------------------------------------------------------------
    extern int mag();
 
+   //---------------------------------------------------------------------------
+   // Function to set cell magnetisation calculated in statistics sweep
+   //---------------------------------------------------------------------------
+   void set_magnetisation_from_statistics(const double* moments);
+
    //-----------------------------------------------------------------------------
    // Function to initialise cells module
    //-----------------------------------------------------------------------------
@@ -191,6 +191,12 @@ namespace create{
 	// Variable for total number of atoms that are not filler
 	extern int num_total_atoms_non_filler;
 
+   // Atom numbers in creation order (only set if atoms are reordered in memory)
+   extern std::vector<uint64_t> original_atom_number;
+
+   // Decomposition independent atom id (unit cell and atom in unit cell)
+   extern std::vector<uint64_t> global_atom_id;
+
 
 	// Functions
    void initialize();
@@ -55,6 +55,7 @@ public:
    int mpi_cpuid;             // CPU id atom is located on
    int mpi_atom_number;       //
    int mpi_old_atom_number;   //
+   uint64_t original_atom_number; // atom number before space filling curve reordering
    unsigned int nn;           // number of neighbours
    unsigned int nbqn;         // number of biquadratic neighbours
 
@@ -81,6 +82,7 @@ public:
       mpi_cpuid(0),
       mpi_atom_number(0),
       mpi_old_atom_number(0),
+      original_atom_number(0),
 
       nn(0),
       nbqn(0)
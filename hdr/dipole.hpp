@@ -70,6 +70,34 @@ namespace dipole{
                         std::vector <double>& m_spin_array, // atomic spin moment
                         std::vector < bool >& magnetic);    // is magnetic
 
+   //------------------------------------------------------------------------------
+   // Function to calculate dipole interaction tensor on a regular FFT grid
+   //------------------------------------------------------------------------------
+   void calculate_fft_kernel(const int nx, const int ny, const int nz,
+                             const int x_start, const int x_end, const int z_stride,
+                             const double dx, const double dy, const double dz,
+                             const double scale, double* kernel);
+
+   //------------------------------------------------------------------------------
+   // Function to multiply k-space magnetisation m by symmetric tensor w stored
+   // as [xx xy xz yy yz zz][re im] in double or single precision, with complex
+   // values stored as [re im] (as fftw_complex)
+   //------------------------------------------------------------------------------
+   template <typename T>
+   inline void fft_tensor_product(const T* w, const double (*m)[2], double (*h)[2]){
+      h[0][0] = w[0]*m[0][0] - w[1]*m[0][1] + w[2]*m[1][0] - w[3]*m[1][1] + w[4] *m[2][0] - w[5] *m[2][1];
+      h[0][1] = w[0]*m[0][1] + w[1]*m[0][0] + w[2]*m[1][1] + w[3]*m[1][0] + w[4] *m[2][1] + w[5] *m[2][0];
+      h[1][0] = w[2]*m[0][0] - w[3]*m[0][1] + w[6]*m[1][0] - w[7]*m[1][1] + w[8] *m[2][0] - w[9] *m[2][1];
+      h[1][1] = w[2]*m[0][1] + w[3]*m[0][0] + w[6]*m[1][1] + w[7]*m[1][0] + w[8] *m[2][1] + w[9] *m[2][0];
+      h[2][0] = w[4]*m[0][0] - w[5]*m[0][1] + w[8]*m[1][0] - w[9]*m[1][1] + w[10]*m[2][0] - w[11]*m[2][1];
+      h[2][1] = w[4]*m[0][1] + w[5]*m[0][0] + w[8]*m[1][1] + w[9]*m[1][0] + w[10]*m[2][1] + w[11]*m[2][0];
+   }
+
+   //------------------------------------------------------------------------------
+   // Function to output number of dipole field updates in adaptive mode
+   //------------------------------------------------------------------------------
+   void output_update_statistics();
+
    //------------------------------------------------------------------------------
    // Function to calculate energy of spin in dipole (magnetostatic) field
    //------------------------------------------------------------------------------
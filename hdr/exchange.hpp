@@ -77,8 +77,19 @@ namespace exchange{
    //-----------------------------------------------------------------------------
    // Function to initialise exchange module
    //-----------------------------------------------------------------------------
-   void initialize(std::vector<std::vector <neighbours::neighbour_t> >& bilinear,
-                   std::vector<std::vector <neighbours::neighbour_t> >& biquadratic);
+   void initialize(neighbours::list_t& bilinear,
+                   neighbours::list_t& biquadratic);
+
+   //-----------------------------------------------------------------------------
+   // Function to initialise lattice stencil form of exchange list (if enabled)
+   //-----------------------------------------------------------------------------
+   void initialize_lattice_stencil(const std::vector<cs::catom_t>& atom_array);
+
+   //-----------------------------------------------------------------------------
+   // Function to release interaction types of bilinear exchange list once
+   // all other modules have been initialised
+   //-----------------------------------------------------------------------------
+   void release_interaction_types();
 
    //-----------------------------------------------------------------------------
    // Functions to set exchange type isotropic, vectorial or tensorial
@@ -91,6 +102,12 @@ namespace exchange{
    //-----------------------------------------------------------------------------
    unsigned int get_exchange_type();
 
+   //-----------------------------------------------------------------------------
+   // Function to get list of atoms interacting with atom via exchange
+   // (bilinear, biquadratic and four spin)
+   //-----------------------------------------------------------------------------
+   void get_neighbours(const int atom, std::vector<int>& neighbours);
+
    //---------------------------------------------------------------------------
    // Calculate  exchange energy for single spin selecting the correct type
    //---------------------------------------------------------------------------
@@ -98,6 +115,37 @@ namespace exchange{
    double single_spin_biquadratic_energy(const int atom, const double sx, const double sy, const double sz);
    double single_spin_four_spin_energy(const int atom, const double sx, const double sy, const double sz);
 
+   //---------------------------------------------------------------------------
+   // Calculate bilinear plus biquadratic exchange energy for single spin, in a
+   // single pass over neighbours if the two share the same neighbour list
+   //---------------------------------------------------------------------------
+   double single_spin_bilinear_biquadratic_energy(const int atom, const double sx, const double sy, const double sz);
+
+   //---------------------------------------------------------------------------
+   // Calculate bilinear exchange field for single spin (E = -S.H)
+   //---------------------------------------------------------------------------
+   void single_spin_field(const int atom, double& hx, double& hy, double& hz);
+
+   //---------------------------------------------------------------------------
+   // Calculate bilinear exchange field for single spin and return change in
+   // biquadratic exchange energy for a trial move from old_spin to new_spin
+   //---------------------------------------------------------------------------
+   double single_spin_field_and_biquadratic_delta_energy(const int atom, const double old_spin[3], const double new_spin[3],
+                                                         double& hx, double& hy, double& hz);
+
+   //-----------------------------------------------------------------------------
+   // Function to calculate bilinear exchange fields only for spins between
+   // start and end index (used to derive exchange energies from fields)
+   //-----------------------------------------------------------------------------
+   void bilinear_fields(const int start_index, // first atom for exchange interactions to be calculated
+                        const int end_index, // last +1 atom to be calculated
+                        const std::vector<double>& spin_array_x, // spin vectors for atoms
+                        const std::vector<double>& spin_array_y,
+                        const std::vector<double>& spin_array_z,
+                        std::vector<double>& field_array_x, // field vectors for atoms
+                        std::vector<double>& field_array_y,
+                        std::vector<double>& field_array_z);
+
    //-----------------------------------------------------------------------------
    // Function to calculate exchange fields for spins between start and end index
    //-----------------------------------------------------------------------------
@@ -107,10 +155,6 @@ namespace exchange{
                const std::vector<int>& neighbour_list_end_index,
                const std::vector<int>& type_array, // type for atom
                const std::vector<int>& neighbour_list_array, // list of interactions between atoms
-               const std::vector<int>& neighbour_interaction_type_array, // list of interaction type for each pair of atoms with value given in exchange list
-               const std::vector <zval_t>& i_exchange_list, // list of isotropic exchange constants
-               const std::vector <zvec_t>& v_exchange_list, // list of vectorial exchange constants
-               const std::vector <zten_t>& t_exchange_list, // list of tensorial exchange constants
                const std::vector<double>& spin_array_x, // spin vectors for atoms
                const std::vector<double>& spin_array_y,
                const std::vector<double>& spin_array_z,
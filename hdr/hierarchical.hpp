@@ -53,7 +53,8 @@ namespace hierarchical{
                std::vector <double>& y_spin_array,
                std::vector <double>& z_spin_array,
                std::vector <double>& m_spin_array, // atomic spin moment
-               std::vector < bool >& magnetic);    // is magnetic);
+               std::vector < bool >& magnetic,     // is magnetic
+               const bool update_magnetisation);   // update cell magnetisation before calculating field
 
 } // end of hierarchical namespace
 
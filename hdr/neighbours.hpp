@@ -14,7 +14,9 @@
 #define NEIGHBOURS_H_
 
 // C++ standard library headers
+#include <cstdint>
 #include <string>
+#include <vector>
 
 // Vampire headers
 #include "create_atoms_class.hpp"
@@ -43,13 +45,43 @@ namespace neighbours{
 	};
 
    //-----------------------------------------------------------------------------
-   // Simple class of neighbour list definining a set of interactions
+   // Simple class of neighbour list definining a set of interactions, stored in
+   // compact (CSR) form with the neighbours of each atom stored contiguously
    //-----------------------------------------------------------------------------
    class list_t{
    public:
 
-      // list of neighbours in terms of atom IDs
-      std::vector<std::vector <neighbours::neighbour_t> > list;
+      //--------------------------------------------------------------------------
+      // Simple class giving access to the neighbours of a single atom
+      //--------------------------------------------------------------------------
+      class row_t{
+      public:
+
+         row_t(neighbours::neighbour_t* first, const uint64_t num): first(first), num(num){}
+
+         uint64_t size() const { return num; }
+         neighbours::neighbour_t& operator[](const uint64_t nn) const { return first[nn]; }
+
+      private:
+
+         neighbours::neighbour_t* first; // first neighbour of atom
+         uint64_t num; // number of neighbours of atom
+
+      };
+
+      // index of first neighbour for each atom (num_atoms+1)
+      std::vector<uint64_t> start_index;
+
+      // list of neighbours of all atoms in terms of atom IDs
+      std::vector<neighbours::neighbour_t> list;
+
+      // neighbours of atom
+      row_t operator[](const uint64_t atom){
+         return row_t(list.data() + start_index[atom], start_index[atom+1] - start_index[atom]);
+      }
+
+      // number of atoms in neighbour list
+      uint64_t num_atoms() const { return start_index.empty() ? 0 : start_index.size() - 1; }
 
       // generate neighbour list from interaction template and list of atoms
       void generate(std::vector<cs::catom_t>& atoms,
@@ -24,6 +24,8 @@
 //
 #ifndef RANDOM_H_
 #define RANDOM_H_
+#include <random>
+#include <vector>
 #include "mtrand.hpp"
 namespace mtrandom
 //==========================================================
@@ -32,10 +34,48 @@ namespace mtrandom
 {
 	extern MTRand grnd; /// single sequence of random numbers
 	extern double gaussian();
-	extern double gaussianc(MTRand&);
-	
+
+	// gaussian and uniform random numbers from a custom generator (instantiated
+	// for MTRand, std::mt19937 and philox_stream)
+	template <typename generator_t> double gaussianc(generator_t& grnd);
+	template <typename generator_t> double uniformc(generator_t& grnd);
+	template <> double uniformc<MTRand>(MTRand& grnd);
+
+	// independent sequences of random numbers for each shared memory thread
+	// (MTRand shares a single static state between all instances)
+	extern std::vector<std::mt19937> thread_grnd;
+	extern void initialise_thread_generators(const int num_threads, const uint32_t seed);
+
 	extern int voronoi_seed;
 	extern int integration_seed;
+
+	// counter based (Philox) random numbers for thermal noise, keyed by object
+	// id and time step and independent of threads and MPI ranks
+	class philox_stream{
+	public:
+		philox_stream(const uint32_t stream, const uint64_t id, const uint64_t step);
+		uint32_t operator()(){
+			if(index == 4) generate();
+			return bits[index++];
+		}
+	private:
+		void generate();
+		uint32_t counter[4];
+		uint32_t key[2];
+		uint32_t bits[4];
+		int index;
+	};
+
+	enum noise_stream_t { thermal_stream = 0, hamr_stream = 1, ltmp_stream = 2,
+	                      llb_perpendicular_stream = 3, llb_parallel_stream = 4,
+	                      micromagnetic_stream = 5, micromagnetic_parallel_stream = 6,
+	                      environment_stream = 7, environment_parallel_stream = 8 };
+	extern bool counter_based_noise;
+	extern uint64_t noise_counter; // incremented every time step
+	extern void counter_gaussian(const uint32_t stream, const uint64_t id, double gaussian[3]);
+	extern void counter_gaussian_fill(const uint32_t stream, const int start_index, const int end_index,
+	                                  const std::vector<uint64_t>& id,
+	                                  std::vector<double>& x, std::vector<double>& y, std::vector<double>& z);
 }
 
 
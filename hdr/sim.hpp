@@ -76,7 +76,8 @@ namespace sim{
 
 	// enumerated list for integrators
 	enum integrator_t{ llg_heun = 0, monte_carlo = 1, llg_midpoint = 2,
-							 cmc = 3, hybrid_cmc = 4, llg_quantum = 5};
+							 cmc = 3, hybrid_cmc = 4, llg_quantum = 5, llg_heun_fused = 6,
+							 monte_carlo_coloured = 7};
 
 	extern std::ofstream mag_file;
 	extern uint64_t time;
@@ -161,6 +162,7 @@ namespace sim{
 
 	extern integrator_t integrator; // variable to specify integrator
 	extern int program;
+	extern int num_threads; // number of shared memory threads used by CPU solvers
 
    // Local system variables
 	extern bool local_temperature; /// flag to enable material specific temperature
@@ -206,6 +208,7 @@ namespace sim{
 
 	// Field and energy functions
    extern double calculate_spin_energy(const int atom);
+   extern double calculate_spin_delta_energy(const int atom, const double old_spin[3], const double new_spin[3]);
    extern double spin_applied_field_energy(const double, const double, const double);
    extern double spin_magnetostatic_energy(const int, const double, const double, const double);
 
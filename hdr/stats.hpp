@@ -22,6 +22,7 @@ namespace stats
 //==========================================================
 {
 	extern int num_atoms;				//Number of atoms for statistic purposes
+	extern bool energy_from_fields;  // calculate bilinear exchange energy from exchange fields
 
 	// Member Functions
 	extern double max_torque();
@@ -109,6 +110,7 @@ namespace stats
       void get_mask(std::vector<int>& out_mask, std::vector<double>& out_normalisation);
       void calculate(const std::vector<double>& sx, const std::vector<double>& sy, const std::vector<double>& sz,
                      const std::vector<double>& mm, const std::vector<int>& mat, const double temperature);
+      void set_energy_sums(const double* sums);
 
       void reset_averages();
 
@@ -130,6 +132,8 @@ namespace stats
       std::string output_mean_energy(enum energy_t energy_type, bool header);
 
    private:
+      void normalize_energy();
+
       bool initialized;
       int num_atoms;
       int mask_size;
@@ -172,6 +176,7 @@ namespace stats
          void set_mask(const int mask_size, std::vector<int> inmask, const std::vector<double>& mm);
          void get_mask(std::vector<int>& out_mask, std::vector<double>& out_saturation);
          void calculate_magnetization(const std::vector<double>& sx, const std::vector<double>& sy, const std::vector<double>& sz, const std::vector<double>& mm);
+         void set_magnetization_sums(const double* sums);
          void set_magnetization(std::vector<double>& magnetization, std::vector<double>& mean_magnetization, long counter);
          void reset_magnetization_averages();
          const std::vector<double>& get_magnetization();
@@ -188,6 +193,8 @@ namespace stats
          std::string output_mean_magnetization(bool header);
 
       private:
+         void normalize_magnetization();
+
          bool initialized;
          int num_atoms;
          int mask_size;
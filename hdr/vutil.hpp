@@ -11,6 +11,9 @@
 
 // System headers
 #include <chrono>
+#ifdef _OPENMP
+   #include <omp.h>
+#endif
 
 // Program headers
 
@@ -46,6 +49,55 @@ namespace vutil{
       }
    };
 
+   //---------------------------------------------------------------------------
+   // Wrappers for shared memory (OpenMP) threads which also compile (as a
+   // single thread) when OpenMP is not available
+   //---------------------------------------------------------------------------
+   inline int thread_id(){
+      #ifdef _OPENMP
+         return omp_get_thread_num();
+      #else
+         return 0;
+      #endif
+   }
+
+   // true when called by a thread of an active (more than one thread) parallel region
+   inline bool in_parallel(){
+      #ifdef _OPENMP
+         return omp_in_parallel();
+      #else
+         return false;
+      #endif
+   }
+
+   inline int num_threads(){
+      #ifdef _OPENMP
+         return omp_get_num_threads();
+      #else
+         return 1;
+      #endif
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to determine contiguous range [start, end) of num_items to be
+   // processed by the calling thread, giving each thread an equal share
+   //---------------------------------------------------------------------------
+   inline void thread_range(const int num_items, int& start, int& end){
+
+      const int nt  = num_threads();
+      const int tid = thread_id();
+
+      const int block     = num_items / nt;
+      const int remainder = num_items % nt;
+
+      // first remainder threads take one extra item
+      start = tid * block + (tid < remainder ? tid : remainder);
+      end   = start + block + (tid < remainder ? 1 : 0);
+
+      return;
+
+   }
+
 } // end of namespace vutil
 
 #endif //VUTIL_H_
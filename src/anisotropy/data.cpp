@@ -119,6 +119,9 @@ namespace anisotropy{
       std::vector<double> klattice(0); // anisotropy constant
       std::vector<double> klattice_array(0); // array for unrolled anisotropy including temperature dependence
 
+      // active anisotropy terms and coefficients for each material
+      std::vector<material_terms_t> material_terms(0);
+
    } // end of internal namespace
 
 } // end of anisotropy namespace
@@ -33,25 +33,32 @@ namespace anisotropy{
       // variable to add energies
       double energy = 0.0;
 
-      // if not enabled then do nothing
-      if(internal::enable_uniaxial_second_order)         energy += internal::uniaxial_second_order_energy(atom, mat, sx, sy, sz);
-      if(internal::enable_uniaxial_fourth_order)         energy += internal::uniaxial_fourth_order_energy(atom, mat, sx, sy, sz);
-      if(internal::enable_biaxial_fourth_order_simple)   energy += internal::biaxial_fourth_order_simple_energy(atom, mat, sx, sy, sz);
-      if(internal::enable_uniaxial_sixth_order)          energy += internal::uniaxial_sixth_order_energy (atom, mat, sx, sy, sz);
+      // loop over active anisotropy terms for material
+      const std::vector<internal::term_t>& terms = internal::material_terms[mat].energy_terms;
+      const int num_terms = terms.size();
 
-      if(internal::enable_cubic_fourth_order)            energy += internal::cubic_fourth_order_energy(atom, mat, sx, sy, sz);
-      if(internal::enable_cubic_fourth_order_rotation)   energy += internal::cubic_fourth_order_rotation_energy(atom, mat, sx, sy, sz);
-      if(internal::enable_cubic_sixth_order)             energy += internal::cubic_sixth_order_energy (atom, mat, sx, sy, sz);
+      for(int i = 0; i < num_terms; i++){
+         switch(terms[i]){
+            case internal::uniaxial_second_term:         energy += internal::uniaxial_second_order_energy(atom, mat, sx, sy, sz); break;
+            case internal::uniaxial_fourth_term:         energy += internal::uniaxial_fourth_order_energy(atom, mat, sx, sy, sz); break;
+            case internal::biaxial_fourth_simple_term:   energy += internal::biaxial_fourth_order_simple_energy(atom, mat, sx, sy, sz); break;
+            case internal::uniaxial_sixth_term:          energy += internal::uniaxial_sixth_order_energy (atom, mat, sx, sy, sz); break;
 
-      if(internal::enable_fourth_order_rotational)       energy += internal::rotational_fourth_order_energy_fixed_basis(atom, mat, sx, sy, sz);
+            case internal::cubic_fourth_term:            energy += internal::cubic_fourth_order_energy(atom, mat, sx, sy, sz); break;
+            case internal::cubic_fourth_rotated_term:    energy += internal::cubic_fourth_order_rotation_energy(atom, mat, sx, sy, sz); break;
+            case internal::cubic_sixth_term:             energy += internal::cubic_sixth_order_energy (atom, mat, sx, sy, sz); break;
 
-      if(internal::enable_neel_anisotropy)               energy += internal::neel_energy(atom, mat, sx, sy, sz);
-      if(internal::enable_lattice_anisotropy)            energy += internal::lattice_energy(atom, mat, sx, sy, sz, temperature);
+            case internal::rotational_fourth_term:       energy += internal::rotational_fourth_order_energy_fixed_basis(atom, mat, sx, sy, sz); break;
 
-      if(internal::enable_triaxial_anisotropy)           energy += internal::triaxial_second_order_energy_fixed_basis(atom, mat, sx, sy, sz);
-      if(internal::enable_triaxial_anisotropy_rotated)   energy += internal::triaxial_second_order_energy(atom, mat, sx, sy, sz);
-      if(internal::enable_triaxial_fourth_order)         energy += internal::triaxial_fourth_order_energy_fixed_basis(atom, mat, sx, sy, sz);
-      if(internal::enable_triaxial_fourth_order_rotated) energy += internal::triaxial_fourth_order_energy(atom, mat, sx, sy, sz);
+            case internal::neel_term:                    energy += internal::neel_energy(atom, mat, sx, sy, sz); break;
+            case internal::lattice_term:                 energy += internal::lattice_energy(atom, mat, sx, sy, sz, temperature); break;
+
+            case internal::triaxial_second_fixed_term:   energy += internal::triaxial_second_order_energy_fixed_basis(atom, mat, sx, sy, sz); break;
+            case internal::triaxial_second_rotated_term: energy += internal::triaxial_second_order_energy(atom, mat, sx, sy, sz); break;
+            case internal::triaxial_fourth_fixed_term:   energy += internal::triaxial_fourth_order_energy_fixed_basis(atom, mat, sx, sy, sz); break;
+            case internal::triaxial_fourth_rotated_term: energy += internal::triaxial_fourth_order_energy(atom, mat, sx, sy, sz); break;
+         }
+      }
 
       return energy;
 
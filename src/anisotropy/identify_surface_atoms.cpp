@@ -31,7 +31,7 @@ namespace anisotropy{
    //---------------------------------------------------------------------------
    // Function to identify less than fully coordinated atoms
    //---------------------------------------------------------------------------
-   void identify_surface_atoms(std::vector<cs::catom_t> & catom_array, std::vector<std::vector <neighbours::neighbour_t> > & cneighbourlist){
+   void identify_surface_atoms(std::vector<cs::catom_t> & catom_array, neighbours::list_t& cneighbourlist){
 
       // initialise surface threshold if not overidden by input file
       if(internal::neel_anisotropy_threshold == 123456789) internal::neel_anisotropy_threshold = cs::unit_cell.surface_threshold;
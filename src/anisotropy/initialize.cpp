@@ -431,6 +431,11 @@ namespace anisotropy{
 
       }
 
+      //---------------------------------------------------------------------
+      // determine active anisotropy terms for each material
+      //---------------------------------------------------------------------
+      internal::initialize_material_terms();
+
       //---------------------------------------------------------------------
       // set flag after initialization
       //---------------------------------------------------------------------
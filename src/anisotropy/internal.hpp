@@ -174,6 +174,52 @@ namespace anisotropy{
 
       }; // end of anisotropy::internal::mp class
 
+      //-----------------------------------------------------------------------------
+      // enumerated list of single spin anisotropy terms
+      //-----------------------------------------------------------------------------
+      enum term_t{ uniaxial_second_term, uniaxial_fourth_term, biaxial_fourth_simple_term,
+                   triaxial_second_rotated_term, triaxial_second_fixed_term,
+                   triaxial_fourth_rotated_term, triaxial_fourth_fixed_term,
+                   uniaxial_sixth_term, rotational_fourth_term, cubic_fourth_term,
+                   cubic_fourth_rotated_term, cubic_sixth_term, neel_term, lattice_term };
+
+      //-----------------------------------------------------------------------------
+      // struct storing the list of active anisotropy terms for a material and
+      // the precomputed coefficients needed to evaluate them in a single pass
+      //-----------------------------------------------------------------------------
+      struct material_terms_t{
+
+         std::vector<term_t> field_terms;  // active local terms in order of field calculation
+         std::vector<term_t> energy_terms; // active terms in order of energy calculation
+
+         double e[3];      // uniaxial easy axis
+         double ku2;       // 2 ku2
+         double ku4;       // -ku4
+         double ku6;       // (1/16)(2/3) ku6
+         double kb4;       // 2 ku4 (biaxial)
+         double u1[3];     // biaxial axes
+         double u2[3];
+         double kc4;       // 2 kc4
+         double kc6;       // -2 kc6
+         double ec1[3];    // rotated cubic axes
+         double ec2[3];
+         double ec3[3];
+         double k4r_xy;    // 8 k4r
+         double k4r_z;     // 2 k4r
+         double kt2[3];    // 2 k (fixed basis second order triaxial)
+         double kt2A[3];   // kA eA (rotated basis second order triaxial)
+         double kt2B[3];
+         double kt2C[3];
+         double kt4[3];    // k (fixed basis fourth order triaxial)
+         double kt4A[3];   // kA eA (rotated basis fourth order triaxial)
+         double kt4B[3];
+         double kt4C[3];
+         double e4A[3];    // fourth order triaxial basis vectors
+         double e4B[3];
+         double e4C[3];
+
+      };
+
       //-----------------------------------------------------------------------------
       // Internal shared variables used for creation
       //-----------------------------------------------------------------------------
@@ -264,130 +310,12 @@ namespace anisotropy{
       extern std::vector< double > klattice; // anisotropy constant
       extern std::vector< double > klattice_array; // array for unrolled anisotropy including temperature dependence
 
+      // active anisotropy terms and coefficients for each material
+      extern std::vector<material_terms_t> material_terms;
+
       //-------------------------------------------------------------------------
       // internal function declarations
       //-------------------------------------------------------------------------
-      void uniaxial_second_order_fields(std::vector<double>& spin_array_x,
-                                        std::vector<double>& spin_array_y,
-                                        std::vector<double>& spin_array_z,
-                                        std::vector<int>&    atom_material_array,
-                                        std::vector<double>& field_array_x,
-                                        std::vector<double>& field_array_y,
-                                        std::vector<double>& field_array_z,
-                                        const int start_index,
-                                        const int end_index);
-
-
-      void triaxial_second_order_fields_fixed_basis(std::vector<double>& spin_array_x,
-                                                     std::vector<double>& spin_array_y,
-                                                     std::vector<double>& spin_array_z,
-                                                     std::vector<int>&    atom_material_array,
-                                                     std::vector<double>& field_array_x,
-                                                     std::vector<double>& field_array_y,
-                                                     std::vector<double>& field_array_z,
-                                                     const int start_index,
-                                                     const int end_index);
-
-      void triaxial_second_order_fields(std::vector<double>& spin_array_x,
-                                                    std::vector<double>& spin_array_y,
-                                                    std::vector<double>& spin_array_z,
-                                                    std::vector<int>&    atom_material_array,
-                                                    std::vector<double>& field_array_x,
-                                                    std::vector<double>& field_array_y,
-                                                    std::vector<double>& field_array_z,
-                                                    const int start_index,
-                                                    const int end_index);
-
-      void triaxial_fourth_order_fields_fixed_basis(std::vector<double>& spin_array_x,
-                                                  std::vector<double>& spin_array_y,
-                                                  std::vector<double>& spin_array_z,
-                                                  std::vector<int>&    atom_material_array,
-                                                  std::vector<double>& field_array_x,
-                                                  std::vector<double>& field_array_y,
-                                                  std::vector<double>& field_array_z,
-                                                  const int start_index,
-                                                  const int end_index);
-
-      void triaxial_fourth_order_fields(std::vector<double>& spin_array_x,
-                                        std::vector<double>& spin_array_y,
-                                        std::vector<double>& spin_array_z,
-                                        std::vector<int>&    atom_material_array,
-                                        std::vector<double>& field_array_x,
-                                        std::vector<double>& field_array_y,
-                                        std::vector<double>& field_array_z,
-                                        const int start_index,
-                                        const int end_index);
-
-      void uniaxial_fourth_order_fields(std::vector<double>& spin_array_x,
-                                        std::vector<double>& spin_array_y,
-                                        std::vector<double>& spin_array_z,
-                                        std::vector<int>&    atom_material_array,
-                                        std::vector<double>& field_array_x,
-                                        std::vector<double>& field_array_y,
-                                        std::vector<double>& field_array_z,
-                                        const int start_index,
-                                        const int end_index);
-
-      void biaxial_fourth_order_simple_fields(std::vector<double>& spin_array_x,
-                                        std::vector<double>& spin_array_y,
-                                        std::vector<double>& spin_array_z,
-                                        std::vector<int>&    atom_material_array,
-                                        std::vector<double>& field_array_x,
-                                        std::vector<double>& field_array_y,
-                                        std::vector<double>& field_array_z,
-                                        const int start_index,
-                                        const int end_index);
-
-      void uniaxial_sixth_order_fields( std::vector<double>& spin_array_x,
-                                        std::vector<double>& spin_array_y,
-                                        std::vector<double>& spin_array_z,
-                                        std::vector<int>&    atom_material_array,
-                                        std::vector<double>& field_array_x,
-                                        std::vector<double>& field_array_y,
-                                        std::vector<double>& field_array_z,
-                                        const int start_index,
-                                        const int end_index);
-
-      void rotational_fourth_order_fields_fixed_basis( std::vector<double>& spin_array_x,
-                                        std::vector<double>& spin_array_y,
-                                        std::vector<double>& spin_array_z,
-                                        std::vector<int>&    atom_material_array,
-                                        std::vector<double>& field_array_x,
-                                        std::vector<double>& field_array_y,
-                                        std::vector<double>& field_array_z,
-                                        const int start_index,
-                                        const int end_index);
-
-      void cubic_fourth_order_fields(std::vector<double>& spin_array_x,
-                                     std::vector<double>& spin_array_y,
-                                     std::vector<double>& spin_array_z,
-                                     std::vector<int>&    atom_material_array,
-                                     std::vector<double>& field_array_x,
-                                     std::vector<double>& field_array_y,
-                                     std::vector<double>& field_array_z,
-                                     const int start_index,
-                                     const int end_index);
-
-      void cubic_fourth_order_rotation_fields(std::vector<double>& spin_array_x,
-                                              std::vector<double>& spin_array_y,
-                                              std::vector<double>& spin_array_z,
-                                              std::vector<int>&    atom_material_array,
-                                              std::vector<double>& field_array_x,
-                                              std::vector<double>& field_array_y,
-                                              std::vector<double>& field_array_z,
-                                              const int start_index,
-                                              const int end_index);
-
-      void cubic_sixth_order_fields( std::vector<double>& spin_array_x,
-                                     std::vector<double>& spin_array_y,
-                                     std::vector<double>& spin_array_z,
-                                     std::vector<int>&    atom_material_array,
-                                     std::vector<double>& field_array_x,
-                                     std::vector<double>& field_array_y,
-                                     std::vector<double>& field_array_z,
-                                     const int start_index,
-                                     const int end_index);
-
       void neel_fields( std::vector<double>& spin_array_x,
                         std::vector<double>& spin_array_y,
                         std::vector<double>& spin_array_z,
@@ -491,8 +419,20 @@ namespace anisotropy{
 
       double lattice_energy(const int atom, const int mat, const double sx, const double sy, const double sz, const double temperature);
 
+      void initialize_material_terms();
+
+      void material_term_fields(std::vector<double>& spin_array_x,
+                                std::vector<double>& spin_array_y,
+                                std::vector<double>& spin_array_z,
+                                std::vector<int>&    atom_material_array,
+                                std::vector<double>& field_array_x,
+                                std::vector<double>& field_array_y,
+                                std::vector<double>& field_array_z,
+                                const int start_index,
+                                const int end_index);
+
       void initialise_neel_anisotropy_tensor(std::vector <std::vector <bool> >& nearest_neighbour_interactions_list,
-                                             std::vector<std::vector <neighbours::neighbour_t> >& cneighbourlist);
+                                             neighbours::list_t& cneighbourlist);
 
    } // end of internal namespace
 
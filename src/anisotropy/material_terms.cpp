@@ -0,0 +1,363 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2024. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+
+// Vampire headers
+#include "anisotropy.hpp"
+#include "material.hpp"
+#include "vio.hpp"
+
+// anisotropy module headers
+#include "internal.hpp"
+
+namespace anisotropy{
+
+   namespace internal{
+
+      //------------------------------------------------------------------------
+      // Function to determine if any component of a constant vector is set
+      //------------------------------------------------------------------------
+      inline bool nonzero(const double x, const double y, const double z){
+         return (x != 0.0 || y != 0.0 || z != 0.0);
+      }
+
+      //------------------------------------------------------------------------
+      // Function to determine active anisotropy terms for each material
+      //
+      // A term is active for a material if it is enabled globally and the
+      // material has a non-zero anisotropy constant for it. Coefficients are
+      // stored premultiplied by the constant factors used in the individual
+      // field functions, grouped in the same order so that the fused field
+      // calculation gives identical results. Must be called after all
+      // constants have been unrolled and the triaxial basis sets determined.
+      //------------------------------------------------------------------------
+      void initialize_material_terms(){
+
+         const int num_materials = internal::mp.size();
+
+         material_terms.resize(num_materials);
+
+         int total_terms = 0;
+
+         for(int m = 0; m < num_materials; m++){
+
+            material_terms_t& t = material_terms[m];
+
+            t.field_terms.clear();
+            t.energy_terms.clear();
+
+            //------------------------------------------------------------------
+            // unroll coefficients
+            //------------------------------------------------------------------
+            t.e[0] = internal::ku_vector[m].x;
+            t.e[1] = internal::ku_vector[m].y;
+            t.e[2] = internal::ku_vector[m].z;
+
+            for(int i = 0; i < 3; i++){
+               t.u1[i]  = internal::mp[m].u1_vector[i];
+               t.u2[i]  = internal::mp[m].u2_vector[i];
+               t.ec1[i] = internal::mp[m].kc_vector1[i];
+               t.ec2[i] = internal::mp[m].kc_vector2[i];
+               t.ec3[i] = internal::mp[m].kc_vector3[i];
+            }
+
+            const double ku2 = enable_uniaxial_second_order ? internal::ku2[m] : 0.0;
+            const double ku4 = (enable_uniaxial_fourth_order || enable_biaxial_fourth_order_simple) ? internal::ku4[m] : 0.0;
+            const double ku6 = enable_uniaxial_sixth_order ? internal::ku6[m] : 0.0;
+            const double kc4 = (enable_cubic_fourth_order || enable_cubic_fourth_order_rotation) ? internal::kc4[m] : 0.0;
+            const double kc6 = enable_cubic_sixth_order ? internal::kc6[m] : 0.0;
+            const double k4r = enable_fourth_order_rotational ? internal::k4r[m] : 0.0;
+
+            const double oneo16 = 1.0/16.0;
+
+            t.ku2 = 2.0*ku2;
+            t.ku4 = -ku4;
+            t.ku6 = (oneo16 * 2.0/3.0)*ku6;
+            t.kb4 = 2.0*ku4;
+            t.kc4 = (0.5*4.0)*kc4;
+            t.kc6 = -2.0*kc6;
+            t.k4r_xy = k4r*8.0;
+            t.k4r_z  = k4r*2.0;
+
+            // second order triaxial
+            double kt2[3]  = {0.0, 0.0, 0.0};
+            double kt2A[3] = {0.0, 0.0, 0.0};
+            double kt2B[3] = {0.0, 0.0, 0.0};
+            double kt2C[3] = {0.0, 0.0, 0.0};
+            if(enable_triaxial_anisotropy || enable_triaxial_anisotropy_rotated){
+               kt2[0]  = internal::ku_triaxial_vector_x[m]; kt2[1]  = internal::ku_triaxial_vector_y[m]; kt2[2]  = internal::ku_triaxial_vector_z[m];
+               kt2A[0] = internal::ku_triaxial_basis1x[m];  kt2A[1] = internal::ku_triaxial_basis1y[m];  kt2A[2] = internal::ku_triaxial_basis1z[m];
+               kt2B[0] = internal::ku_triaxial_basis2x[m];  kt2B[1] = internal::ku_triaxial_basis2y[m];  kt2B[2] = internal::ku_triaxial_basis2z[m];
+               kt2C[0] = internal::ku_triaxial_basis3x[m];  kt2C[1] = internal::ku_triaxial_basis3y[m];  kt2C[2] = internal::ku_triaxial_basis3z[m];
+            }
+
+            // fourth order triaxial
+            double kt4[3]  = {0.0, 0.0, 0.0};
+            double kt4A[3] = {0.0, 0.0, 0.0};
+            double kt4B[3] = {0.0, 0.0, 0.0};
+            double kt4C[3] = {0.0, 0.0, 0.0};
+            if(enable_triaxial_fourth_order || enable_triaxial_fourth_order_rotated || enable_triaxial_anisotropy_rotated){
+               kt4[0]  = internal::ku4_triaxial_vector_x[m]; kt4[1]  = internal::ku4_triaxial_vector_y[m]; kt4[2]  = internal::ku4_triaxial_vector_z[m];
+               kt4A[0] = internal::ku4_triaxial_basis1x[m];  kt4A[1] = internal::ku4_triaxial_basis1y[m];  kt4A[2] = internal::ku4_triaxial_basis1z[m];
+               kt4B[0] = internal::ku4_triaxial_basis2x[m];  kt4B[1] = internal::ku4_triaxial_basis2y[m];  kt4B[2] = internal::ku4_triaxial_basis2z[m];
+               kt4C[0] = internal::ku4_triaxial_basis3x[m];  kt4C[1] = internal::ku4_triaxial_basis3y[m];  kt4C[2] = internal::ku4_triaxial_basis3z[m];
+            }
+
+            for(int i = 0; i < 3; i++){
+               t.kt2[i]  = 2.0*kt2[i];
+               t.kt2A[i] = kt2[0]*kt2A[i];
+               t.kt2B[i] = kt2[1]*kt2B[i];
+               t.kt2C[i] = kt2[2]*kt2C[i];
+               t.kt4[i]  = kt4[i];
+               t.kt4A[i] = kt4[0]*kt4A[i];
+               t.kt4B[i] = kt4[1]*kt4B[i];
+               t.kt4C[i] = kt4[2]*kt4C[i];
+               t.e4A[i]  = kt4A[i];
+               t.e4B[i]  = kt4B[i];
+               t.e4C[i]  = kt4C[i];
+            }
+
+            const bool triaxial_second = nonzero(kt2[0], kt2[1], kt2[2]);
+            const bool triaxial_fourth = nonzero(kt4[0], kt4[1], kt4[2]);
+
+            //------------------------------------------------------------------
+            // list of active terms in order of field calculation
+            //------------------------------------------------------------------
+            if(enable_uniaxial_second_order          && ku2 != 0.0)      t.field_terms.push_back(uniaxial_second_term);
+            if(enable_uniaxial_fourth_order          && ku4 != 0.0)      t.field_terms.push_back(uniaxial_fourth_term);
+            if(enable_biaxial_fourth_order_simple    && ku4 != 0.0)      t.field_terms.push_back(biaxial_fourth_simple_term);
+            if(enable_triaxial_anisotropy_rotated    && triaxial_second) t.field_terms.push_back(triaxial_second_rotated_term);
+            if(enable_triaxial_anisotropy            && triaxial_second) t.field_terms.push_back(triaxial_second_fixed_term);
+            if(enable_triaxial_fourth_order_rotated  && triaxial_fourth) t.field_terms.push_back(triaxial_fourth_rotated_term);
+            if(enable_triaxial_fourth_order          && triaxial_fourth) t.field_terms.push_back(triaxial_fourth_fixed_term);
+            if(enable_uniaxial_sixth_order           && ku6 != 0.0)      t.field_terms.push_back(uniaxial_sixth_term);
+            if(enable_fourth_order_rotational        && k4r != 0.0)      t.field_terms.push_back(rotational_fourth_term);
+            if(enable_cubic_fourth_order             && kc4 != 0.0)      t.field_terms.push_back(cubic_fourth_term);
+            if(enable_cubic_fourth_order_rotation    && kc4 != 0.0)      t.field_terms.push_back(cubic_fourth_rotated_term);
+            if(enable_cubic_sixth_order              && kc6 != 0.0)      t.field_terms.push_back(cubic_sixth_term);
+
+            //------------------------------------------------------------------
+            // list of active terms in order of energy calculation (the rotated
+            // second order triaxial energy uses the fourth order constants)
+            //------------------------------------------------------------------
+            if(enable_uniaxial_second_order          && ku2 != 0.0)      t.energy_terms.push_back(uniaxial_second_term);
+            if(enable_uniaxial_fourth_order          && ku4 != 0.0)      t.energy_terms.push_back(uniaxial_fourth_term);
+            if(enable_biaxial_fourth_order_simple    && ku4 != 0.0)      t.energy_terms.push_back(biaxial_fourth_simple_term);
+            if(enable_uniaxial_sixth_order           && ku6 != 0.0)      t.energy_terms.push_back(uniaxial_sixth_term);
+            if(enable_cubic_fourth_order             && kc4 != 0.0)      t.energy_terms.push_back(cubic_fourth_term);
+            if(enable_cubic_fourth_order_rotation    && kc4 != 0.0)      t.energy_terms.push_back(cubic_fourth_rotated_term);
+            if(enable_cubic_sixth_order              && kc6 != 0.0)      t.energy_terms.push_back(cubic_sixth_term);
+            if(enable_fourth_order_rotational        && k4r != 0.0)      t.energy_terms.push_back(rotational_fourth_term);
+            if(enable_neel_anisotropy)                                   t.energy_terms.push_back(neel_term);
+            if(enable_lattice_anisotropy)                                t.energy_terms.push_back(lattice_term);
+            if(enable_triaxial_anisotropy            && triaxial_second) t.energy_terms.push_back(triaxial_second_fixed_term);
+            if(enable_triaxial_anisotropy_rotated    && triaxial_fourth) t.energy_terms.push_back(triaxial_second_rotated_term);
+            if(enable_triaxial_fourth_order          && triaxial_fourth) t.energy_terms.push_back(triaxial_fourth_fixed_term);
+            if(enable_triaxial_fourth_order_rotated  && triaxial_fourth) t.energy_terms.push_back(triaxial_fourth_rotated_term);
+
+            if(m < mp::num_materials) total_terms += t.field_terms.size();
+
+         }
+
+         zlog << zTs() << "Anisotropy field calculation uses " << total_terms << " active local terms for " << mp::num_materials << " materials" << std::endl;
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to calculate all local anisotropy fields in a single pass
+      //
+      // Each spin is loaded once and the active terms for its material are
+      // accumulated in registers before the field is written back, replacing
+      // a separate loop over all atoms for each anisotropy term. Neel and
+      // lattice anisotropies are calculated separately.
+      //------------------------------------------------------------------------
+      void material_term_fields(std::vector<double>& spin_array_x,
+                                std::vector<double>& spin_array_y,
+                                std::vector<double>& spin_array_z,
+                                std::vector<int>&    atom_material_array,
+                                std::vector<double>& field_array_x,
+                                std::vector<double>& field_array_y,
+                                std::vector<double>& field_array_z,
+                                const int start_index,
+                                const int end_index){
+
+         const double sixtyothirtyfive = 60.0/35.0;
+
+         // loop over all atoms
+         for(int atom = start_index; atom < end_index; atom++){
+
+            const int mat = atom_material_array[atom];
+
+            const material_terms_t& t = material_terms[mat];
+
+            // check for materials without any local anisotropy
+            const int num_terms = t.field_terms.size();
+            if(num_terms == 0) continue;
+
+            const double sx = spin_array_x[atom]; // store spin direction in temporary variables
+            const double sy = spin_array_y[atom];
+            const double sz = spin_array_z[atom];
+
+            double hx = field_array_x[atom];
+            double hy = field_array_y[atom];
+            double hz = field_array_z[atom];
+
+            for(int i = 0; i < num_terms; i++){
+
+               switch(t.field_terms[i]){
+
+                  case uniaxial_second_term:{
+                     const double sdote = (sx*t.e[0] + sy*t.e[1] + sz*t.e[2]);
+                     const double k2 = t.ku2*sdote;
+                     hx += t.e[0]*k2;
+                     hy += t.e[1]*k2;
+                     hz += t.e[2]*k2;
+                     break;
+                  }
+
+                  case uniaxial_fourth_term:{
+                     const double sdote  = (sx*t.e[0] + sy*t.e[1] + sz*t.e[2]);
+                     const double sdote3 = sdote*sdote*sdote;
+                     const double k4 = t.ku4*(4.0*sdote3 - sixtyothirtyfive*sdote);
+                     hx += t.e[0]*k4;
+                     hy += t.e[1]*k4;
+                     hz += t.e[2]*k4;
+                     break;
+                  }
+
+                  case biaxial_fourth_simple_term:{
+                     const double sdotu1 = (sx*t.u1[0] + sy*t.u1[1] + sz*t.u1[2]);
+                     const double sdotu13 = sdotu1*sdotu1*sdotu1;
+                     const double sdotu2 = (sx*t.u2[0] + sy*t.u2[1] + sz*t.u2[2]);
+                     const double sdotu23 = sdotu2*sdotu2*sdotu2;
+                     hx += t.kb4*(t.u1[0]*sdotu13+t.u2[0]*sdotu23);
+                     hy += t.kb4*(t.u1[1]*sdotu13+t.u2[1]*sdotu23);
+                     hz += t.kb4*(t.u1[2]*sdotu13+t.u2[2]*sdotu23);
+                     break;
+                  }
+
+                  case triaxial_second_rotated_term:{
+                     hx += 2.0*(t.kt2A[0]*sx + t.kt2B[0]*sx + t.kt2C[0]*sx);
+                     hy += 2.0*(t.kt2A[1]*sy + t.kt2B[1]*sy + t.kt2C[1]*sy);
+                     hz += 2.0*(t.kt2A[2]*sz + t.kt2B[2]*sz + t.kt2C[2]*sz);
+                     break;
+                  }
+
+                  case triaxial_second_fixed_term:{
+                     hx += t.kt2[0]*sx;
+                     hy += t.kt2[1]*sy;
+                     hz += t.kt2[2]*sz;
+                     break;
+                  }
+
+                  case triaxial_fourth_rotated_term:{
+                     const double sdoteA = t.e4A[0]*sx + t.e4A[1]*sy + t.e4A[2]*sz;
+                     const double sdoteB = t.e4B[0]*sx + t.e4B[1]*sy + t.e4B[2]*sz;
+                     const double sdoteC = t.e4C[0]*sx + t.e4C[1]*sy + t.e4C[2]*sz;
+                     const double sdoteA3 = sdoteA*sdoteA*sdoteA;
+                     const double sdoteB3 = sdoteB*sdoteB*sdoteB;
+                     const double sdoteC3 = sdoteC*sdoteC*sdoteC;
+                     const double k4A = 4.0*sdoteA3 - sixtyothirtyfive*sdoteA;
+                     const double k4B = 4.0*sdoteB3 - sixtyothirtyfive*sdoteB;
+                     const double k4C = 4.0*sdoteC3 - sixtyothirtyfive*sdoteC;
+                     hx += t.kt4A[0]*k4A + t.kt4B[0]*k4B + t.kt4C[0]*k4C;
+                     hy += t.kt4A[1]*k4A + t.kt4B[1]*k4B + t.kt4C[1]*k4C;
+                     hz += t.kt4A[2]*k4A + t.kt4B[2]*k4B + t.kt4C[2]*k4C;
+                     break;
+                  }
+
+                  case triaxial_fourth_fixed_term:{
+                     const double sx3 = sx*sx*sx;
+                     const double sy3 = sy*sy*sy;
+                     const double sz3 = sz*sz*sz;
+                     hx += t.kt4[0]*(4.0*sx3 - sixtyothirtyfive*sx);
+                     hy += t.kt4[1]*(4.0*sy3 - sixtyothirtyfive*sy);
+                     hz += t.kt4[2]*(4.0*sz3 - sixtyothirtyfive*sz);
+                     break;
+                  }
+
+                  case uniaxial_sixth_term:{
+                     const double sdote  = (sx*t.e[0] + sy*t.e[1] + sz*t.e[2]);
+                     const double sdote3 = sdote*sdote*sdote;
+                     const double sdote5 = sdote3*sdote*sdote;
+                     const double k6 = t.ku6*(1386.0*sdote5 - 1260.0*sdote3 + 210.0*sdote);
+                     hx += t.e[0]*k6;
+                     hy += t.e[1]*k6;
+                     hz += t.e[2]*k6;
+                     break;
+                  }
+
+                  case rotational_fourth_term:{
+                     const double sx2 = sx*sx;
+                     const double sy2 = sy*sy;
+                     const double sz2 = sz*sz;
+                     hx += t.k4r_xy * sx * (1.0 - sz2 - 2.0 * sx2);
+                     hy += t.k4r_xy * sy * (1.0 - sz2 - 2.0 * sy2);
+                     hz += t.k4r_z  * sz * (1.0 - 2.0 * sz2 - 4.0 * sx2 - 4.0 * sy2);
+                     break;
+                  }
+
+                  case cubic_fourth_term:{
+                     hx += sx*sx*sx*t.kc4;
+                     hy += sy*sy*sy*t.kc4;
+                     hz += sz*sz*sz*t.kc4;
+                     break;
+                  }
+
+                  case cubic_fourth_rotated_term:{
+                     const double sdote1 = sx * t.ec1[0] + sy * t.ec1[1] + sz * t.ec1[2];
+                     const double sdote2 = sx * t.ec2[0] + sy * t.ec2[1] + sz * t.ec2[2];
+                     const double sdote3 = sx * t.ec3[0] + sy * t.ec3[1] + sz * t.ec3[2];
+                     const double sdote1_3 = sdote1 * sdote1 * sdote1;
+                     const double sdote2_3 = sdote2 * sdote2 * sdote2;
+                     const double sdote3_3 = sdote3 * sdote3 * sdote3;
+                     hx += t.kc4*(sdote1_3*t.ec1[0] + sdote2_3*t.ec2[0] + sdote3_3*t.ec3[0]);
+                     hy += t.kc4*(sdote1_3*t.ec1[1] + sdote2_3*t.ec2[1] + sdote3_3*t.ec3[1]);
+                     hz += t.kc4*(sdote1_3*t.ec1[2] + sdote2_3*t.ec2[2] + sdote3_3*t.ec3[2]);
+                     break;
+                  }
+
+                  case cubic_sixth_term:{
+                     const double sx2 = sx*sx;
+                     const double sy2 = sy*sy;
+                     const double sz2 = sz*sz;
+                     hx += sx*sy2*sz2*t.kc6;
+                     hy += sy*sz2*sx2*t.kc6;
+                     hz += sz*sx2*sy2*t.kc6;
+                     break;
+                  }
+
+                  // non-local terms calculated separately
+                  default:
+                     break;
+
+               }
+
+            }
+
+            // save total field to field array
+            field_array_x[atom] = hx;
+            field_array_y[atom] = hy;
+            field_array_z[atom] = hz;
+
+         }
+
+         return;
+
+      }
+
+   } // end of internal namespace
+
+} // end of anisotropy namespace
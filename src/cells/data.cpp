@@ -59,6 +59,9 @@ namespace cells{
    std::vector<double> pos_and_mom_array; /// arrays to store cells positions
    std::vector<double> pos_array; /// arrays to store cells positions
 
+   bool magnetisation_in_statistics = false; /// calculate cell magnetisation in statistics sweep
+   bool magnetisation_dirty = true; /// spins changed since statistics sweep calculated cell magnetisation
+
    std::vector < double > num_macro_cells_fft(3,10.0); /// macro-cells size (A)
    std::vector<double> fft_cell_id_array; /// arrays to store cells positions
 
@@ -83,6 +86,10 @@ namespace cells{
       std::vector<double> spin_array_z;
       std::vector<int> atom_type_array;
       int num_atoms;
+
+      std::vector<double> atom_moment_array; /// moment of local atoms (J/T), zero for non-magnetic atoms
+      std::vector<double> mag_array; /// interleaved cell magnetisation [cell][x y z]
+      std::vector<double> thread_mag_array; /// partial cell magnetisation for each thread [thread][cell][x y z]
    } // end of internal namespace
 
 } // end of cells namespace
@@ -351,6 +351,14 @@ namespace cells{
       // Set initialised flag
       cells::internal::initialised=true;
 
+      // Precalculate moments of local atoms for cell magnetisation
+      cells::internal::atom_moment_array.resize(num_local_atoms);
+      for(int atom=0;atom<num_local_atoms;atom++){
+         const int type = cells::internal::atom_type_array[atom];
+         cells::internal::atom_moment_array[atom] = mp::material[type].non_magnetic == 0 ? mp::material[type].mu_s_SI : 0.0;
+      }
+      cells::internal::mag_array.resize(3*cells::num_cells);
+
       // Precalculate cell magnetisation
       cells::mag();
 
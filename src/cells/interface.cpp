@@ -76,6 +76,12 @@ namespace cells{
          return true;
       }
 
+      test="magnetisation-in-statistics";
+      if(word==test){
+         cells::magnetisation_in_statistics = true;
+         return true;
+      }
+
 
       //--------------------------------------------------------------------
       // Keyword not found
@@ -56,6 +56,10 @@ namespace cells{
       extern int num_atoms;
       //extern int num_local_atoms;
 
+      extern std::vector<double> atom_moment_array; /// moment of local atoms (J/T), zero for non-magnetic atoms
+      extern std::vector<double> mag_array; /// interleaved cell magnetisation [cell][x y z]
+      extern std::vector<double> thread_mag_array; /// partial cell magnetisation for each thread [thread][cell][x y z]
+
       //-------------------------------------------------------------------------
       // Internal function declarations
       //-------------------------------------------------------------------------
@@ -21,6 +21,8 @@
 #include "vmpi.hpp"
 #include "create.hpp"
 #include "micromagnetic.hpp"
+#include "sim.hpp"
+#include "vutil.hpp"
 
 #include "atoms.hpp"
 
@@ -31,6 +33,12 @@ namespace cells{
 
    //-----------------------------------------------------------------------------
    // Function for calculate magnetisation in cells
+   //
+   // Moments of local atoms (zero for non-magnetic atoms) are precalculated so
+   // that the sweep over atoms only reads spins and cell ids. With several
+   // threads each accumulates a partial sum for its range of atoms, which are
+   // then added in thread order. The cell magnetisation is stored interleaved
+   // so that it is reduced on all processors with a single collective.
    //-----------------------------------------------------------------------------
    //int mag(const double time_from_start){
    int mag(){
@@ -39,11 +47,8 @@ namespace cells{
      // check calling of routine if error checking is activated
       if(err::check==true) std::cout << "cells::mag has been called" << std::endl;
 
-      for(int i=0; i<cells::num_cells; ++i) {
-         cells::mag_array_x[i] = 0.0;
-         cells::mag_array_y[i] = 0.0;
-         cells::mag_array_z[i] = 0.0;
-      }
+      // magnetisation already calculated in statistics sweep for current spins
+      if(cells::magnetisation_in_statistics && !cells::magnetisation_dirty) return EXIT_SUCCESS;
 
       #ifdef MPICF
          int num_local_atoms = vmpi::num_core_atoms+vmpi::num_bdry_atoms;
@@ -51,31 +56,101 @@ namespace cells{
          int num_local_atoms = cells::internal::num_atoms;
       #endif
 
+      const int num_elements = 3*cells::num_cells;
+
+      std::vector<double>& mag_array = cells::internal::mag_array;
+      const std::vector<double>& moment = cells::internal::atom_moment_array;
+
       // calulate total moment in each cell
-      for(int i=0;i<num_local_atoms;++i) {
-         int cell = cells::atom_cell_id_array[i];
-         int type = cells::internal::atom_type_array[i];
-         //// Consider only cells with n_atoms != 0
-         //if(cells::num_atoms_in_cell[cell]>0){
-            const double mus = mp::material[type].mu_s_SI;
-            // Consider only magnetic elements
-            if(mp::material[type].non_magnetic==0){
-               cells::mag_array_x[cell] += atoms::x_spin_array[i]*mus;
-               cells::mag_array_y[cell] += atoms::y_spin_array[i]*mus;
-               cells::mag_array_z[cell] += atoms::z_spin_array[i]*mus;
+      if(sim::num_threads == 1){
+
+         std::fill(mag_array.begin(), mag_array.end(), 0.0);
+
+         for(int i=0;i<num_local_atoms;++i) {
+            const int cell = cells::atom_cell_id_array[i];
+            const double mus = moment[i];
+            mag_array[3*cell+0] += atoms::x_spin_array[i]*mus;
+            mag_array[3*cell+1] += atoms::y_spin_array[i]*mus;
+            mag_array[3*cell+2] += atoms::z_spin_array[i]*mus;
+         }
+
+      }
+      else{
+
+         std::vector<double>& partial = cells::internal::thread_mag_array;
+         partial.resize(size_t(sim::num_threads)*num_elements);
+
+         #pragma omp parallel num_threads(sim::num_threads)
+         {
+
+            double* thread_mag = &partial[size_t(vutil::thread_id())*num_elements];
+            for(int e = 0; e < num_elements; e++) thread_mag[e] = 0.0;
+
+            int start = 0;
+            int end = 0;
+            vutil::thread_range(num_local_atoms, start, end);
+
+            for(int i = start; i < end; ++i){
+               const int cell = cells::atom_cell_id_array[i];
+               const double mus = moment[i];
+               thread_mag[3*cell+0] += atoms::x_spin_array[i]*mus;
+               thread_mag[3*cell+1] += atoms::y_spin_array[i]*mus;
+               thread_mag[3*cell+2] += atoms::z_spin_array[i]*mus;
             }
-         //}
+
+            #pragma omp barrier
+
+            // add partial sums for each thread
+            vutil::thread_range(num_elements, start, end);
+            for(int e = start; e < end; e++){
+               double sum = 0.0;
+               for(int t = 0; t < sim::num_threads; t++) sum += partial[size_t(t)*num_elements + e];
+               mag_array[e] = sum;
+            }
+
+         }
+
       }
 
       #ifdef MPICF
       // Reduce magnetisation on all nodes
-      MPI_Allreduce(MPI_IN_PLACE, &cells::mag_array_x[0],   cells::mag_array_x.size(),   MPI_DOUBLE,MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, &cells::mag_array_y[0],   cells::mag_array_y.size(),   MPI_DOUBLE,MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, &cells::mag_array_z[0],   cells::mag_array_z.size(),   MPI_DOUBLE,MPI_SUM, MPI_COMM_WORLD);
+      MPI_Allreduce(MPI_IN_PLACE, &mag_array[0], num_elements, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
       #endif
+
+      for(int cell=0; cell<cells::num_cells; ++cell){
+         cells::mag_array_x[cell] = mag_array[3*cell+0];
+         cells::mag_array_y[cell] = mag_array[3*cell+1];
+         cells::mag_array_z[cell] = mag_array[3*cell+2];
+      }
+
       }
 
       return EXIT_SUCCESS;
 
    }
+
+   //-----------------------------------------------------------------------------
+   // Function to set cell magnetisation calculated in statistics sweep
+   //
+   // The statistics sweep over atoms accumulates the cell moments (in Bohr
+   // magnetons) alongside the other statistics and reduces them in the same
+   // collective. Later calls to mag() reuse them until the spins are changed
+   // and the magnetisation is marked dirty.
+   //-----------------------------------------------------------------------------
+   void set_magnetisation_from_statistics(const double* moments){
+
+      const double muB = 9.27400915e-24;
+
+      for(int cell=0; cell<cells::num_cells; ++cell){
+         cells::mag_array_x[cell] = moments[3*cell+0]*muB;
+         cells::mag_array_y[cell] = moments[3*cell+1]*muB;
+         cells::mag_array_z[cell] = moments[3*cell+2]*muB;
+      }
+
+      cells::magnetisation_dirty = false;
+
+      return;
+
+   }
+
 } // end of cells namespace
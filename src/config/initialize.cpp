@@ -11,10 +11,13 @@
 //
 
 // C++ standard library headers
+#include <algorithm>
+#include <utility>
 
 // Vampire headers
 #include "atoms.hpp"
 #include "config.hpp"
+#include "create.hpp"
 #include "vio.hpp"
 
 // config module headers
@@ -67,6 +70,18 @@ namespace config{
 
          }
 
+         // if atoms have been reordered in memory, output atoms in creation order
+         if(create::original_atom_number.size() > 0){
+            const uint64_t num_output_atoms = local_output_atom_list.size();
+            std::vector< std::pair<uint64_t, uint64_t> > order(num_output_atoms);
+            for(uint64_t i = 0; i < num_output_atoms; i++){
+               const uint64_t atom = local_output_atom_list[i];
+               order[i] = std::make_pair(create::original_atom_number[atom], atom);
+            }
+            std::sort(order.begin(), order.end());
+            for(uint64_t i = 0; i < num_output_atoms; i++) local_output_atom_list[i] = order[i].second;
+         }
+
          //------------------------------------------------------
          // calculate total atoms to output from all processors
          //------------------------------------------------------
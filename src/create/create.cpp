@@ -133,6 +133,9 @@ int create(){
 	// Cut system to the correct type, species etc
 	create::create_system_type(catom_array);
 
+   // Optionally reorder atoms along space filling curve for improved data locality
+   create::internal::reorder_atoms(catom_array);
+
 	// Copy atoms for interprocessor communications
 	#ifdef MPICF
 	if(vmpi::mpi_mode==0){
@@ -149,14 +152,30 @@ int create(){
    // generate bilinear exchange list
    bilinear.generate(catom_array, cs::unit_cell.bilinear, na, ucx, ucy, ucz);
 
-   // optionally create a biquadratic neighbour list
+   // check if biquadratic interactions have the same neighbour pairs as the
+   // bilinear exchange (usually the case), in which case the lists are merged
+   bool shared_biquadratic_list = false;
    if(exchange::biquadratic){
+      const std::vector<unitcell::interaction_t>& bl = cs::unit_cell.bilinear.interaction;
+      const std::vector<unitcell::interaction_t>& bq = cs::unit_cell.biquadratic.interaction;
+      shared_biquadratic_list = ( bl.size() == bq.size() );
+      for(size_t i = 0; shared_biquadratic_list && i < bl.size(); i++){
+         shared_biquadratic_list = ( bl[i].i  == bq[i].i  && bl[i].j  == bq[i].j  &&
+                                     bl[i].dx == bq[i].dx && bl[i].dy == bq[i].dy && bl[i].dz == bq[i].dz );
+      }
+   }
+
+   // optionally create a biquadratic neighbour list
+   if(exchange::biquadratic && !shared_biquadratic_list){
       biquadratic.generate(catom_array, cs::unit_cell.biquadratic, na, ucx, ucy, ucz);
    }
+   else if(shared_biquadratic_list){
+      zlog << zTs() << "Biquadratic exchange interactions share bilinear neighbour list" << std::endl;
+   }
 
 	#ifdef MPICF
 		create::internal::identify_mpi_boundary_atoms(catom_array,bilinear);
-      if(exchange::biquadratic) create::internal::identify_mpi_boundary_atoms(catom_array,biquadratic);
+      if(exchange::biquadratic && !shared_biquadratic_list) create::internal::identify_mpi_boundary_atoms(catom_array,biquadratic);
       create::internal::mark_non_interacting_halo(catom_array);
       // Sort Arrays by MPI Type
       create::internal::sort_atoms_by_mpi_type(catom_array, bilinear, biquadratic);
@@ -172,7 +191,7 @@ int create(){
 	std::cout << "Copying system data to optimised data structures." << std::endl;
 	zlog << zTs() << "Copying system data to optimised data structures." << std::endl;
 
-	create::internal::set_atom_vars(catom_array, bilinear, biquadratic);
+	create::internal::set_atom_vars(catom_array, bilinear, shared_biquadratic_list ? bilinear : biquadratic);
 
    // Determine number of local atoms
    #ifdef MPICF
@@ -125,10 +125,25 @@ void set_atom_vars(std::vector<cs::catom_t> & catom_array,
 
 	}
 
+   // save creation order of atoms for configuration output
+   if(create::internal::atom_ordering != create::internal::creation){
+      create::original_atom_number.resize(atoms::num_atoms);
+      for(int atom=0;atom<atoms::num_atoms;atom++) create::original_atom_number[atom] = catom_array[atom].original_atom_number;
+   }
+
+   // save global atom id from unit cell coordinates (same for any decomposition)
+   create::global_atom_id.resize(atoms::num_atoms);
+   for(int atom=0;atom<atoms::num_atoms;atom++){
+      const uint64_t cell = ( uint64_t(catom_array[atom].scz) * uint64_t(cs::total_num_unit_cells[1]) +
+                              uint64_t(catom_array[atom].scy) ) * uint64_t(cs::total_num_unit_cells[0]) +
+                              uint64_t(catom_array[atom].scx);
+      create::global_atom_id[atom] = cell * uint64_t(cs::unit_cell.atom.size()) + catom_array[atom].uc_id;
+   }
+
    //---------------------------------------------------------------------------
    // Identify surface atoms and initialise anisotropy data
    //---------------------------------------------------------------------------
-   anisotropy::identify_surface_atoms(catom_array, bilinear.list);
+   anisotropy::identify_surface_atoms(catom_array, bilinear);
 
 	//===========================================================
 	// Create 1-D neighbourlist
@@ -140,16 +155,20 @@ void set_atom_vars(std::vector<cs::catom_t> & catom_array,
    //-------------------------------------------------
 	//	Initialise exchange calculation
 	//-------------------------------------------------
-   exchange::initialize(bilinear.list, biquadratic.list);
+   exchange::initialize(bilinear, biquadratic);
+
+   // Optionally replace inline exchange constants of perfect lattice atoms with unit cell stencil
+   // (atoms::neighbour_list_array is retained for energy, micromagnetic and GPU calculations)
+   exchange::initialize_lattice_stencil(catom_array);
 
    // Save number of atoms in unit cell first
    cells::num_atoms_in_unit_cell = cs::unit_cell.atom.size();
 
    // Now nuke generation vectors to free memory NOW
    std::vector<cs::catom_t> zerov;
-   std::vector<std::vector <neighbours::neighbour_t> > zerovv;
    catom_array.swap(zerov);
-   bilinear.list.swap(zerovv);
+   bilinear.clear();
+   biquadratic.clear();
 
    return;
 
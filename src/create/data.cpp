@@ -21,6 +21,8 @@ namespace create{
    // Shared variables used with main vampire code
    //---------------------------------------------------------------------------
    int num_total_atoms_non_filler = 0;
+   std::vector<uint64_t> original_atom_number(0); // atom numbers in creation order (only set for reordered atoms)
+   std::vector<uint64_t> global_atom_id(0); // decomposition independent atom id for counter based random numbers
 
       namespace internal{
 
@@ -36,6 +38,8 @@ namespace create{
          int mixing_seed = 100181363;  // random seed to control intermixing of atoms
          int spin_init_seed = 123456;  // random seed to control ranomised spin directions
 
+         atom_ordering_t atom_ordering = creation; // space filling curve used to order atoms in memory
+
          double faceted_particle_100_radius = 1.0; // 100 facet particle radius
          double faceted_particle_110_radius = 1.0; // 110 facet particle radius
          double faceted_particle_111_radius = 1.0; // 111 facet particle radius
@@ -411,6 +411,38 @@ namespace create{
          }
       }
       //--------------------------------------------------------------------
+      test="atom-ordering";
+      if(word==test){
+         test="default";
+         if(value==test){
+            create::internal::atom_ordering = create::internal::creation;
+            return true;
+         }
+         test="morton";
+         if(value==test){
+            create::internal::atom_ordering = create::internal::morton;
+            return true;
+         }
+         test="hilbert";
+         if(value==test){
+            create::internal::atom_ordering = create::internal::hilbert;
+            return true;
+         }
+         else{
+            terminaltextcolor(RED);
+            std::cerr << "Error - value for \'create:" << word << "\' must be one of:" << std::endl;
+            std::cerr << "\t\"default\"" << std::endl;
+            std::cerr << "\t\"morton\"" << std::endl;
+            std::cerr << "\t\"hilbert\"" << std::endl;
+            zlog << zTs() << "Error - value for \'create:" << word << "\' must be one of:" << std::endl;
+            zlog << zTs() << "\t\"default\"" << std::endl;
+            zlog << zTs() << "\t\"morton\"" << std::endl;
+            zlog << zTs() << "\t\"hilbert\"" << std::endl;
+            terminaltextcolor(WHITE);
+            err::vexit();
+         }
+      }
+      //--------------------------------------------------------------------
       test="voronoi-grain-substructure-crystallization-radius";
       if(word==test){
          double rsize=atof(value.c_str());
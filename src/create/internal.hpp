@@ -34,6 +34,9 @@ namespace create{
       enum host_alloy_d_t { homogeneous, random, granular };
       enum slave_alloy_d_t { native, reciprocal, uniform };
 
+      // ordering of atoms in memory
+      enum atom_ordering_t { creation, morton, hilbert };
+
       struct core_radius_t{
          int mat;
          double radius;
@@ -124,6 +127,8 @@ namespace create{
       extern int mixing_seed; // random seed to control intermixing of atoms
       extern int spin_init_seed; // random seed to control ranomised spin directions
 
+      extern atom_ordering_t atom_ordering; // space filling curve used to order atoms in memory
+
       extern double faceted_particle_100_radius; // 100 facet radius
       extern double faceted_particle_110_radius; // 110 facet radius
       extern double faceted_particle_111_radius; // 111 facet radius
@@ -173,6 +178,7 @@ namespace create{
       extern void hex_particle_array(std::vector<cs::catom_t> &);
       extern void centre_particle_on_atom(std::vector<double>& particle_origin, std::vector<cs::catom_t>& catom_array);
       extern void sort_atoms_by_grain(std::vector<cs::catom_t> & catom_array);
+      extern void reorder_atoms(std::vector<cs::catom_t> & catom_array);
       extern void clear_atoms(std::vector<cs::catom_t> &);
 
       extern void voronoi_substructure(std::vector<cs::catom_t> & catom_array);
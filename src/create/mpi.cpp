@@ -544,10 +544,10 @@ namespace create{
             const int my_mpi_type = catom_array[atom].mpi_type;
 
             // loop over all neighbours for atom
-            for( unsigned int nn = 0; nn < cneighbourlist.list[atom].size(); nn++ ){
+            for( unsigned int nn = 0; nn < cneighbourlist[atom].size(); nn++ ){
 
                // identify neighbour atom
-               const uint64_t natom = cneighbourlist.list[atom][nn].nn;
+               const uint64_t natom = cneighbourlist[atom][nn].nn;
 
                // define nearest neighbour MPI type
                int nn_mpi_type = catom_array[natom].mpi_type;
@@ -604,6 +604,45 @@ namespace create{
          else return false;
       }
 
+      //------------------------------------------------------------------------
+      // Function to reorder neighbour list for new atom numbers, ignoring all
+      // halo-x interactions but not x-halo
+      //------------------------------------------------------------------------
+      void renumber_neighbour_list(neighbours::list_t& nlist,
+                                   const std::vector<data_t>& mpi_type_vec,
+                                   const std::vector<int>& inv_mpi_type_vec,
+                                   const unsigned int new_num_atoms){
+
+         neighbours::list_t tmp_list;
+
+         // determine number of neighbours of each new atom
+         tmp_list.start_index.resize(new_num_atoms+1);
+         tmp_list.start_index[0] = 0;
+         for(unsigned int atom = 0; atom < new_num_atoms; atom++){
+            const uint64_t num_nn = mpi_type_vec[atom].mpi_type == 2 ? 0 : nlist[mpi_type_vec[atom].atom_number].size();
+            tmp_list.start_index[atom+1] = tmp_list.start_index[atom] + num_nn;
+         }
+
+         tmp_list.list.resize(tmp_list.start_index[new_num_atoms]);
+         for(unsigned int atom = 0; atom < new_num_atoms; atom++){
+            if(mpi_type_vec[atom].mpi_type == 2) continue;
+            neighbours::list_t::row_t old_nn = nlist[mpi_type_vec[atom].atom_number];
+            for(uint64_t nn = 0; nn < old_nn.size(); nn++){
+               // Actual neighbours stay the same so simply copy separation vectors
+               neighbours::neighbour_t temp_nt = old_nn[nn];
+               temp_nt.nn = inv_mpi_type_vec[temp_nt.nn];
+               tmp_list.list[tmp_list.start_index[atom] + nn] = temp_nt;
+            }
+         }
+
+         // swap tmp data over old data
+         nlist.start_index.swap(tmp_list.start_index);
+         nlist.list.swap(tmp_list.list);
+
+         return;
+
+      }
+
       //------------------------------------------------------------------------
       // Sort atoms accoriding to order core | boundary | halo
       //------------------------------------------------------------------------
@@ -684,98 +723,21 @@ namespace create{
 
          // create temporary catom and cneighbourlist arrays for copying data
          std::vector <cs::catom_t> tmp_catom_array(new_num_atoms);
-         std::vector <std::vector <neighbours::neighbour_t> > tmp_bilinear(new_num_atoms);
-         std::vector <std::vector <neighbours::neighbour_t> > tmp_biquadratic(new_num_atoms);
-
          // Populate tmp arrays (assuming all mpi_type=3 atoms are at the end of the array?)
          for (unsigned int atom=0;atom<new_num_atoms;atom++){ // new atom number
             unsigned int old_atom_num = mpi_type_vec[atom].atom_number;
             tmp_catom_array[atom]=catom_array[old_atom_num];
             tmp_catom_array[atom].mpi_old_atom_number=old_atom_num; // Store old atom numbers for translation after sorting
-            //---//tmp_cneighbourlist[atom].reserve(cneighbourlist[old_atom_num].size());
-
-            //Copy neighbourlist using new atom numbers
-            //if(vmpi::my_rank==0) std::cout << vmpi::my_rank << " old " << old_atom_num << " nn: ";
-            /*for(unsigned int nn=0;nn<cneighbourlist[old_atom_num].size();nn++){
-               unsigned int old_nn_number = cneighbourlist[old_atom_num][nn].nn;
-               unsigned int interaction_id= cneighbourlist[old_atom_num][nn].i;
-               unsigned int new_nn_number = inv_mpi_type_vec[old_nn_number];
-               cs::neighbour_t temp_nt;
-               temp_nt.nn=new_nn_number;
-               temp_nt.i=interaction_id;
-               // Actual neighbours stay the same so simply copy separation vectors
-               temp_nt.vx=cneighbourlist[old_atom_num][nn].vx;
-               temp_nt.vy=cneighbourlist[old_atom_num][nn].vy;
-               temp_nt.vz=cneighbourlist[old_atom_num][nn].vz;
-               // ignore all halo-x interactions but not x-halo
-               //if(!((mpi_type_vec[atom].mpi_type==2) && (mpi_type_vec[new_nn_number].mpi_type==2)))
-               if(!(mpi_type_vec[atom].mpi_type==2))
-               tmp_cneighbourlist[atom].push_back(temp_nt);
-               //else std::cerr << "ignoring interaction " << atom << "\t" << new_nn_number << " on " << vmpi::my_rank << std::endl;
-               //if(vmpi::my_rank==0) std::cout << cneighbourlist[old_atom_num][nn].nn << "\t";
-            }*/
-
-            tmp_bilinear[atom].reserve(bilinear.list[old_atom_num].size());
-
-            // Copy bilinear neighbourlist using new atom numbers
-            for(unsigned int nn = 0; nn < bilinear.list[old_atom_num].size(); nn++){
-
-               unsigned int old_nn_number = bilinear.list[old_atom_num][nn].nn;
-               unsigned int interaction_id= bilinear.list[old_atom_num][nn].i;
-               unsigned int new_nn_number = inv_mpi_type_vec[old_nn_number];
-
-               neighbours::neighbour_t temp_nt;
-
-               temp_nt.nn=new_nn_number;
-               temp_nt.i=interaction_id;
-
-               // Actual neighbours stay the same so simply copy separation vectors
-               temp_nt.vx=bilinear.list[old_atom_num][nn].vx;
-               temp_nt.vy=bilinear.list[old_atom_num][nn].vy;
-               temp_nt.vz=bilinear.list[old_atom_num][nn].vz;
-
-               // ignore all halo-x interactions but not x-halo
-               if(!(mpi_type_vec[atom].mpi_type==2)) tmp_bilinear[atom].push_back(temp_nt);
-
-            }
-
-            // optionally replace biquadratic list
-            if(exchange::biquadratic){
-               tmp_biquadratic[atom].reserve(biquadratic.list[old_atom_num].size());
-
-               // Copy bilinear neighbourlist using new atom numbers
-               for(unsigned int nn = 0; nn < biquadratic.list[old_atom_num].size();nn++){
-
-                  unsigned int old_nn_number = biquadratic.list[old_atom_num][nn].nn;
-                  unsigned int interaction_id= biquadratic.list[old_atom_num][nn].i;
-                  unsigned int new_nn_number = inv_mpi_type_vec[old_nn_number];
-
-                  neighbours::neighbour_t temp_nt;
-
-                  temp_nt.nn = new_nn_number;
-                  temp_nt.i = interaction_id;
-
-                  // Actual neighbours stay the same so simply copy separation vectors
-                  temp_nt.vx = biquadratic.list[old_atom_num][nn].vx;
-                  temp_nt.vy = biquadratic.list[old_atom_num][nn].vy;
-                  temp_nt.vz = biquadratic.list[old_atom_num][nn].vz;
-
-                  // ignore all halo-x interactions but not x-halo
-                  if(!(mpi_type_vec[atom].mpi_type==2)) tmp_biquadratic[atom].push_back(temp_nt);
-
-               }
-            } // end of biquadratic
-
          }
 
+         // Copy neighbour lists using new atom numbers
+         renumber_neighbour_list(bilinear, mpi_type_vec, inv_mpi_type_vec, new_num_atoms);
 
+         // optionally replace biquadratic list (unless shared with bilinear list)
+         if(exchange::biquadratic && biquadratic.num_atoms() > 0) renumber_neighbour_list(biquadratic, mpi_type_vec, inv_mpi_type_vec, new_num_atoms);
 
          // Swap tmp data over old data more efficient and saves memory
          catom_array.swap(tmp_catom_array);
-         //----// cneighbourlist.swap(tmp_cneighbourlist); // This actually works(!) - COPIES both pointers and elements of pointers
-
-         bilinear.list.swap(tmp_bilinear); // This actually works(!) - COPIES both pointers and elements of pointers
-         biquadratic.list.swap(tmp_biquadratic);
 
          // Print out final neighbourlist
          //for (unsigned int atom=0;atom<new_num_atoms;atom++){
@@ -0,0 +1,139 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2024. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+// Vampire headers
+#include "create.hpp"
+#include "vio.hpp"
+
+// Internal create header
+#include "internal.hpp"
+
+namespace create{
+namespace internal{
+
+//------------------------------------------------------------------------------
+// Function to calculate position of a point along a Morton (Z-order) curve
+// by interleaving the bits of the x,y,z coordinates
+//------------------------------------------------------------------------------
+uint64_t morton_key(const uint32_t x, const uint32_t y, const uint32_t z, const int bits){
+
+   uint64_t key = 0;
+   for(int b = bits-1; b >= 0; b--){
+      key = (key << 1) | ((x >> b) & 1);
+      key = (key << 1) | ((y >> b) & 1);
+      key = (key << 1) | ((z >> b) & 1);
+   }
+
+   return key;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to calculate position of a point along a 3D Hilbert curve
+// (J. Skilling, AIP Conf. Proc. 707, 381 (2004))
+//------------------------------------------------------------------------------
+uint64_t hilbert_key(const uint32_t x, const uint32_t y, const uint32_t z, const int bits){
+
+   uint32_t X[3] = {x, y, z};
+   const uint32_t M = 1u << (bits-1);
+
+   // inverse undo excess work
+   for(uint32_t Q = M; Q > 1; Q >>= 1){
+      const uint32_t P = Q - 1;
+      for(int i = 0; i < 3; i++){
+         if(X[i] & Q) X[0] ^= P; // invert
+         else{                   // exchange
+            const uint32_t t = (X[0] ^ X[i]) & P;
+            X[0] ^= t;
+            X[i] ^= t;
+         }
+      }
+   }
+
+   // Gray encode
+   X[1] ^= X[0];
+   X[2] ^= X[1];
+   uint32_t t = 0;
+   for(uint32_t Q = M; Q > 1; Q >>= 1) if(X[2] & Q) t ^= Q - 1;
+   for(int i = 0; i < 3; i++) X[i] ^= t;
+
+   // transposed coordinates now give curve position when interleaved
+   return morton_key(X[0], X[1], X[2], bits);
+
+}
+
+//------------------------------------------------------------------------------
+// Function to reorder atoms along a space filling curve
+//
+// Atoms are sorted by the position of their host unit cell along a Morton or
+// Hilbert curve, keeping the creation order of atoms within each unit cell.
+// Atoms which are close in space are then close in memory, improving cache
+// reuse in the exchange and energy calculations. This must be done before
+// neighbour list generation and MPI halo copying so that all derived lists and
+// the core | boundary | halo partitioning follow the new order. The original
+// atom number is saved so that configuration output can be written in the
+// creation order.
+//------------------------------------------------------------------------------
+void reorder_atoms(std::vector<cs::catom_t> & catom_array){
+
+   // store creation order of atoms
+   const uint64_t num_atoms = catom_array.size();
+   for(uint64_t atom = 0; atom < num_atoms; atom++) catom_array[atom].original_atom_number = atom;
+
+   if(create::internal::atom_ordering == create::internal::creation || num_atoms == 0) return;
+
+   // determine range of unit cell coordinates
+   int64_t min[3] = {catom_array[0].scx, catom_array[0].scy, catom_array[0].scz};
+   int64_t max[3] = {catom_array[0].scx, catom_array[0].scy, catom_array[0].scz};
+   for(uint64_t atom = 0; atom < num_atoms; atom++){
+      min[0] = std::min(min[0], catom_array[atom].scx); max[0] = std::max(max[0], catom_array[atom].scx);
+      min[1] = std::min(min[1], catom_array[atom].scy); max[1] = std::max(max[1], catom_array[atom].scy);
+      min[2] = std::min(min[2], catom_array[atom].scz); max[2] = std::max(max[2], catom_array[atom].scz);
+   }
+
+   // determine number of bits needed for curve (21 bits per dimension maximum)
+   const int64_t max_extent = std::max(max[0]-min[0], std::max(max[1]-min[1], max[2]-min[2]));
+   int bits = 1;
+   while( (int64_t(1) << bits) <= max_extent && bits < 21) bits++;
+
+   // calculate curve position for each atom
+   std::vector< std::pair<uint64_t, uint64_t> > keys(num_atoms);
+   for(uint64_t atom = 0; atom < num_atoms; atom++){
+      const uint32_t x = catom_array[atom].scx - min[0];
+      const uint32_t y = catom_array[atom].scy - min[1];
+      const uint32_t z = catom_array[atom].scz - min[2];
+      if(create::internal::atom_ordering == create::internal::hilbert) keys[atom].first = hilbert_key(x, y, z, bits);
+      else keys[atom].first = morton_key(x, y, z, bits);
+      keys[atom].second = atom;
+   }
+
+   // sort atoms by curve position (second key preserves order within unit cell)
+   std::sort(keys.begin(), keys.end());
+
+   // copy atoms in new order
+   std::vector<cs::catom_t> tmp_catom_array(num_atoms);
+   for(uint64_t atom = 0; atom < num_atoms; atom++) tmp_catom_array[atom] = catom_array[keys[atom].second];
+   catom_array.swap(tmp_catom_array);
+
+   zlog << zTs() << "Reordered " << num_atoms << " atoms along " << (create::internal::atom_ordering == create::internal::hilbert ? "Hilbert" : "Morton") << " curve" << std::endl;
+
+   return;
+
+}
+
+} // end of namespace internal
+} // end of namespace create
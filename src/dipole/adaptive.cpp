@@ -0,0 +1,100 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2024. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <iostream>
+#include <vector>
+
+// Vampire headers
+#include "cells.hpp"
+#include "dipole.hpp"
+#include "vio.hpp"
+
+// dipole module headers
+#include "internal.hpp"
+
+namespace dipole{
+
+   namespace internal{
+
+      //------------------------------------------------------------------------
+      // Function to decide if dipole field update is required in adaptive mode
+      //
+      // The cell magnetisations are recalculated every minimum interval and
+      // compared with those at the last update. The field is updated when the
+      // change in any cell, relative to its saturation moment, exceeds the
+      // tolerance, or when the maximum interval since the last update has
+      // elapsed. Near equilibrium the field is then rarely recalculated, while
+      // during fast dynamics it is updated as often as the minimum interval.
+      //------------------------------------------------------------------------
+      bool adaptive_update_required(const uint64_t sim_time){
+
+         const bool first = (num_field_updates == 0) || (sim_time < last_update_step);
+         const uint64_t interval = first ? 0 : sim_time - last_update_step;
+
+         // only check magnetisation every minimum interval
+         if(!first && interval < max_update_interval && interval % min_update_interval != 0) return false;
+
+         // update cell magnetisations
+         cells::mag();
+         num_update_checks++;
+
+         bool update = first || interval >= max_update_interval;
+
+         // determine maximum relative change in cell magnetisation since last update
+         if(!update){
+            const double tolerance_sq = update_tolerance * update_tolerance;
+            for(int cell = 0; cell < cells::num_cells; cell++){
+               const double ms = cells::pos_and_mom_array[4*cell+3];
+               if(ms <= 0.0) continue;
+               const double dx = cells::mag_array_x[cell] - last_mag_array_x[cell];
+               const double dy = cells::mag_array_y[cell] - last_mag_array_y[cell];
+               const double dz = cells::mag_array_z[cell] - last_mag_array_z[cell];
+               if(dx*dx + dy*dy + dz*dz > tolerance_sq * ms * ms){
+                  update = true;
+                  break;
+               }
+            }
+         }
+
+         // save magnetisation at update
+         if(update){
+            last_mag_array_x = cells::mag_array_x;
+            last_mag_array_y = cells::mag_array_y;
+            last_mag_array_z = cells::mag_array_z;
+            last_update_step = sim_time;
+            num_field_updates++;
+         }
+
+         return update;
+
+      }
+
+   } // end of internal namespace
+
+   //---------------------------------------------------------------------------
+   // Function to output number of dipole field updates in adaptive mode
+   //---------------------------------------------------------------------------
+   void output_update_statistics(){
+
+      if(!dipole::activated || !dipole::internal::adaptive_update) return;
+
+      std::cout     << "Dipole field statistics:" << std::endl;
+      std::cout     << "\tAdaptive field updates: " << dipole::internal::num_field_updates << " from " << dipole::internal::num_update_checks << " checks" << std::endl;
+      zlog << zTs() << "Dipole field statistics:" << std::endl;
+      zlog << zTs() << "\tAdaptive field updates: " << dipole::internal::num_field_updates << " from " << dipole::internal::num_update_checks << " checks" << std::endl;
+
+      return;
+
+   }
+
+} // end of dipole namespace
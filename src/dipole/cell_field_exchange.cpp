@@ -0,0 +1,161 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2024. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <vector>
+
+// Vampire headers
+#include "dipole.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// dipole module headers
+#include "internal.hpp"
+
+namespace dipole{
+
+   namespace internal{
+
+      //------------------------------------------------------------------------
+      // Function to set up exchange of macrocell dipole fields between
+      // processors
+      //
+      // Each processor calculates the field for a list of cells, for the
+      // macrocell solvers all the cells containing its atoms and for the
+      // distributed FFT solver the cells in its slab of the FFT grid. Cells
+      // required by a processor but not calculated locally (for example
+      // micromagnetic cells distributed independently of atoms) are requested
+      // once from the owning processor, here the lowest rank which calculates
+      // the cell. Only these cells are then exchanged at each update.
+      //------------------------------------------------------------------------
+      void initialize_cell_field_exchange(const std::vector<int>& computed_cells, // cells calculated on this processor
+                                          const std::vector<int>& required_cells){ // cells needed on this processor
+
+         // unused in serial
+         (void) computed_cells;
+         (void) required_cells;
+
+         #ifdef MPICF
+
+            const int num_cells = dipole::internal::cells_num_cells;
+            const int num_procs = vmpi::num_processors;
+
+            // flag cells calculated on this processor
+            std::vector<int> local(num_cells, 0);
+            for(size_t c = 0; c < computed_cells.size(); c++) local[computed_cells[c]] = 1;
+
+            // determine owner of each cell as the lowest rank calculating it
+            std::vector<int> owner(num_cells, num_procs);
+            for(int cell = 0; cell < num_cells; cell++) if(local[cell]) owner[cell] = vmpi::my_rank;
+            MPI_Allreduce(MPI_IN_PLACE, owner.data(), num_cells, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+
+            // determine cells needed from other processors
+            std::vector< std::vector<int> > requests(num_procs);
+            for(size_t c = 0; c < required_cells.size(); c++){
+               const int cell = required_cells[c];
+               if(local[cell] == 1 || owner[cell] == num_procs) continue; // calculated here or empty
+               local[cell] = 2; // avoid duplicate requests
+               requests[owner[cell]].push_back(cell);
+            }
+
+            // save list of cells received from each processor
+            cell_recv_counts.assign(num_procs, 0);
+            cell_recv_displacements.assign(num_procs, 0);
+            cell_recv_list.clear();
+            for(int p = 0; p < num_procs; p++){
+               cell_recv_displacements[p] = cell_recv_list.size();
+               cell_recv_counts[p] = requests[p].size();
+               cell_recv_list.insert(cell_recv_list.end(), requests[p].begin(), requests[p].end());
+            }
+
+            // tell owners which cells to send
+            cell_send_counts.assign(num_procs, 0);
+            cell_send_displacements.assign(num_procs, 0);
+            MPI_Alltoall(cell_recv_counts.data(), 1, MPI_INT, cell_send_counts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+
+            int num_send = 0;
+            for(int p = 0; p < num_procs; p++){
+               cell_send_displacements[p] = num_send;
+               num_send += cell_send_counts[p];
+            }
+            cell_send_list.resize(num_send);
+
+            MPI_Alltoallv(cell_recv_list.data(), cell_recv_counts.data(), cell_recv_displacements.data(), MPI_INT,
+                          cell_send_list.data(), cell_send_counts.data(), cell_send_displacements.data(), MPI_INT, MPI_COMM_WORLD);
+
+            // convert counts to packed buffer units (dipole and demag field xyz)
+            for(int p = 0; p < num_procs; p++){
+               cell_send_counts[p] *= 6;
+               cell_send_displacements[p] *= 6;
+               cell_recv_counts[p] *= 6;
+               cell_recv_displacements[p] *= 6;
+            }
+            cell_send_buffer.resize(6*cell_send_list.size());
+            cell_recv_buffer.resize(6*cell_recv_list.size());
+
+            // determine if any processor needs to exchange cells
+            int num_exchanged = cell_recv_list.size();
+            MPI_Allreduce(MPI_IN_PLACE, &num_exchanged, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+            cell_field_exchange_needed = num_exchanged > 0;
+
+            zlog << zTs() << "Dipole cell field exchange: sending " << cell_send_list.size() << " and receiving " << cell_recv_list.size() << " cells on rank " << vmpi::my_rank << std::endl;
+
+         #endif
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to exchange dipole and demag fields of requested cells between
+      // processors in a single packed buffer
+      //------------------------------------------------------------------------
+      void exchange_cell_fields(){
+
+         #ifdef MPICF
+
+            if(!cell_field_exchange_needed) return;
+
+            // pack fields of cells requested by other processors
+            for(size_t c = 0; c < cell_send_list.size(); c++){
+               const int cell = cell_send_list[c];
+               cell_send_buffer[6*c+0] = dipole::cells_field_array_x[cell];
+               cell_send_buffer[6*c+1] = dipole::cells_field_array_y[cell];
+               cell_send_buffer[6*c+2] = dipole::cells_field_array_z[cell];
+               cell_send_buffer[6*c+3] = dipole::cells_mu0Hd_field_array_x[cell];
+               cell_send_buffer[6*c+4] = dipole::cells_mu0Hd_field_array_y[cell];
+               cell_send_buffer[6*c+5] = dipole::cells_mu0Hd_field_array_z[cell];
+            }
+
+            MPI_Alltoallv(cell_send_buffer.data(), cell_send_counts.data(), cell_send_displacements.data(), MPI_DOUBLE,
+                          cell_recv_buffer.data(), cell_recv_counts.data(), cell_recv_displacements.data(), MPI_DOUBLE, MPI_COMM_WORLD);
+
+            // unpack fields of remote cells
+            for(size_t c = 0; c < cell_recv_list.size(); c++){
+               const int cell = cell_recv_list[c];
+               dipole::cells_field_array_x[cell] = cell_recv_buffer[6*c+0];
+               dipole::cells_field_array_y[cell] = cell_recv_buffer[6*c+1];
+               dipole::cells_field_array_z[cell] = cell_recv_buffer[6*c+2];
+               dipole::cells_mu0Hd_field_array_x[cell] = cell_recv_buffer[6*c+3];
+               dipole::cells_mu0Hd_field_array_y[cell] = cell_recv_buffer[6*c+4];
+               dipole::cells_mu0Hd_field_array_z[cell] = cell_recv_buffer[6*c+5];
+            }
+
+         #endif
+
+         return;
+
+      }
+
+   } // end of internal namespace
+
+} // end of dipole namespace
@@ -70,6 +70,21 @@ namespace dipole{
       //------------------------------------------------------------------------
       bool initialised=false;
       bool output_atomistic_dipole_field = false; // flag to toggle output of atomic resolution dipole field
+      double fmm_opening_angle = 0.5; // multipole acceptance parameter for atomistic-fmm solver
+      bool tensor_cache_enabled = false; // flag to save and load dipole tensors from cache files
+      bool single_precision = false; // flag to store dipole tensors and cell magnetisation in single precision
+
+      // adaptive field update scheduling
+      bool adaptive_update = false;          // flag to update field on change in cell magnetisation
+      double update_tolerance = 0.01;        // maximum relative change in cell magnetisation between updates
+      uint64_t min_update_interval = 1;      // minimum time steps between updates (and checks)
+      uint64_t max_update_interval = 1000;   // maximum time steps between updates
+      uint64_t last_update_step = 0;         // time step of last adaptive update
+      uint64_t num_field_updates = 0;        // number of adaptive field updates
+      uint64_t num_update_checks = 0;        // number of checks of cell magnetisation
+      std::vector<double> last_mag_array_x;  // cell magnetisation at last update
+      std::vector<double> last_mag_array_y;
+      std::vector<double> last_mag_array_z;
 
       int update_time=-1; /// last update time
 
@@ -86,6 +101,23 @@ namespace dipole{
       std::vector <std::vector < double > > rij_tensor_yz;
       std::vector <std::vector < double > > rij_tensor_zz;
 
+      std::vector <int> packed_cell_array; // list of non-empty cells
+      std::vector <int> packed_local_cell_array; // list of non-empty local cells (rows)
+      std::vector <double> packed_tensor_array; // tensor rows in symmetric xx xy xz yy yz zz blocks
+      std::vector <double> packed_mag_array; // normalised magnetisation of non-empty cells
+      std::vector <float> packed_tensor_array_sp; // single precision tensor rows
+      std::vector <float> packed_mag_array_sp; // single precision normalised magnetisation
+
+      bool cell_field_exchange_needed = false; // flag to enable exchange of cell fields
+      std::vector <int> cell_send_list; // cells sent to other processors
+      std::vector <int> cell_send_counts; // number of field components sent to each processor
+      std::vector <int> cell_send_displacements;
+      std::vector <int> cell_recv_list; // cells received from other processors
+      std::vector <int> cell_recv_counts; // number of field components received from each processor
+      std::vector <int> cell_recv_displacements;
+      std::vector <double> cell_send_buffer; // packed xyz dipole and demag fields
+      std::vector <double> cell_recv_buffer;
+
       int num_atoms;
       std::vector < int > atom_type_array;
       std::vector < int > atom_cell_id_array;
@@ -177,7 +209,7 @@ namespace dipole{
          unsigned int num_macro_cells_z;
          unsigned int eight_num_cells;
       #endif
-      void update_field_fft();
+      void update_field_fft(const bool update_magnetisation);
    } // end of internal namespace
 
 } // end of dipole namespace
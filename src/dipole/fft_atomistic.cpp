@@ -105,7 +105,6 @@ namespace dipole{
                 a[1] += (b[0] * c[1] + b[1] * c[0]);
             }
 
-            double delta_fn ( const int i, const int j) { return (i==j) ? 1 : 0;}
 
             #endif
             //-----------------------------------------------------------------------------
@@ -220,31 +219,13 @@ namespace dipole{
                 // loop over the system mesh to
                 // construct the interaction matrix
                 // w(r) = (\mu_0 / 4 pi r^5) (3 r \outer r - I r*r)
-                int ind = 0;
-                for( int i = 0 ; i < Nx; i++) {
-                    for( int j = 0; j < Ny; j++) {
-                        for( int k = 0; k < Nz; k++) {
-                            double rx = ( i > Nx/2) ? i - Nx : i;
-                            double ry = ( j > Ny/2) ? j - Ny : j;
-                            double rz = ( k > Nz/2) ? k - Nz : k;
-                            double rij[3] = {rx*dx, ry*dy, rz*dz};
-                            double r = sqrt( rij[0]*rij[0] + rij[1]*rij[1] + rij[2]*rij[2]);
-                            double w0 = prefactor / (r*r*r*r*r);
-                            // FFTW does not normalise the transform so we do here.
-                            w0 /= double(N);
-                            for( int a = 0; a < 3; a++) {
-                                for( int b = 0; b < 3; b++) {
-                                    int id = b + 3*a;
-                                    int idx = id + 9 * (k + Nz * (j + Ny * i));
-                                    int_mat_r[idx] = w0 * ( 3* rij[a] * rij[b] - delta_fn(a,b) * r * r);
-                                }
-                            }
-                        }
-                    }
+                // FFTW does not normalise the transform so we do here.
+                std::vector<double> w(6*N);
+                dipole::calculate_fft_kernel(Nx, Ny, Nz, 0, Nx, Nz, dx, dy, dz, prefactor/double(N), w.data());
+                const int component[9] = {0, 1, 2, 1, 3, 4, 2, 4, 5}; // [xx xy xz yy yz zz] -> 3x3
+                for( int i = 0; i < N; i++) {
+                    for( int a = 0; a < 9; a++) int_mat_r[a + 9*i] = w[component[a] + 6*i];
                 }
-                // Zero out the self-interaction
-                for( int a = 0; a < 9; a++)
-                    int_mat_r[a] = 0.0;
 
                 /*
                    for( int i = 0 ; i < Nx; i++) {
@@ -0,0 +1,350 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2024. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// Vampire headers
+#include "atoms.hpp"
+#include "cells.hpp"
+#include "create.hpp"
+#include "dipole.hpp"
+#include "errors.hpp"
+#include "micromagnetic.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+#if defined(FFT) && defined(MPICF)
+#include <fftw3-mpi.h>
+#endif
+
+#ifdef FFTW_OMP
+#include <omp.h>
+#endif
+
+// dipole module headers
+#include "internal.hpp"
+
+namespace dipole{
+
+   namespace internal{
+
+      //------------------------------------------------------------------------
+      // Distributed memory FFT macrocell dipole solver
+      //
+      // The macrocell dipole field H = N . M is calculated as a convolution on
+      // the regular grid of macrocells, zero padded in non-periodic directions
+      //
+      //                     H = iFFT[ FFT(N) . FFT(M) ]
+      //
+      // The grid is divided into slabs along x over all processors using the
+      // FFTW MPI interface. The forward transform leaves the data transposed
+      // (slabs along y) and the inverse transform starts from the transposed
+      // data, so that only the two transposes are communicated. The product
+      // with the symmetric interaction tensor is done in the transposed layout,
+      // and the tensor is only ever stored for the local slab, so that memory
+      // and work are O(N log N / P).
+      //
+      // Each processor calculates fields for the cells in its slab, and fields
+      // for cells containing its atoms are then received from the owners of
+      // the slabs. The atomic decomposition is therefore independent of the
+      // FFT decomposition.
+      //
+      // The kernel has no self interaction, so the intra cell tensor of the
+      // tensor solver (the average over pairs of atoms in the cell) is added
+      // explicitly along with the self demagnetisation. Unlike the tensor
+      // solver, the convolution places every cell at its grid centre rather
+      // than at its moment weighted centre, and does not use atomistic sums
+      // between neighbouring cells. The two agree for completely filled cells,
+      // and differ for partially filled cells at surfaces and interfaces.
+      //------------------------------------------------------------------------
+      namespace distributed_fft{
+
+         #if defined(FFT) && defined(MPICF)
+
+            ptrdiff_t n[3];              // size of padded FFT grid
+            int num_cells_x, num_cells_y, num_cells_z; // number of macrocells in x,y,z
+            ptrdiff_t nzc;                // number of complex points in z
+            ptrdiff_t local_n0;           // number of local x planes (real space)
+            ptrdiff_t local_0_start;      // first local x plane (real space)
+            ptrdiff_t local_n1;           // number of local y planes (k-space, transposed)
+            ptrdiff_t local_1_start;      // first local y plane (k-space, transposed)
+
+            double*       M_r;  // real space magnetisation [x][y][z][3] (z padded)
+            double*       H_r;  // real space field [x][y][z][3] (z padded)
+            fftw_complex* M_k;  // k-space magnetisation [y][x][z][3]
+            fftw_complex* H_k;  // k-space field [y][x][z][3]
+            fftw_complex* N_k;  // k-space interaction tensor [y][x][z][xx xy xz yy yz zz]
+            std::vector<float> N_k_sp; // single precision k-space interaction tensor [re im]
+
+            fftw_plan plan_M; // forward transform of magnetisation
+            fftw_plan plan_H; // inverse transform of field
+
+            std::vector<int> slab_cells; // cells calculated on this processor
+            std::vector<int> slab_index; // index of cell in local real space arrays
+            std::vector<double> slab_intra; // intra cell tensor for cells in slab [xx xy xz yy yz zz] (Tesla)
+
+         #endif
+
+      } // end of distributed_fft namespace
+
+      namespace dfft = distributed_fft;
+
+      //------------------------------------------------------------------------
+      // Function to initialise distributed FFT solver
+      //------------------------------------------------------------------------
+      void initialize_distributed_fft_solver(){
+
+         #if defined(FFT) && defined(MPICF)
+
+            #ifdef FFTW_OMP
+               fftw_init_threads();
+            #endif
+            fftw_mpi_init();
+            #ifdef FFTW_OMP
+               fftw_plan_with_nthreads(omp_get_max_threads());
+            #endif
+
+            const double prefactor = 0.9274009994; // mu_0 * muB / (4*pi*Angstrom^3)
+
+            // determine number of cells in x,y,z (global, same as cells module)
+            dfft::num_cells_x = static_cast<unsigned int>(ceil((cs::system_dimensions[0]+0.01)/cells::macro_cell_size_x));
+            dfft::num_cells_y = static_cast<unsigned int>(ceil((cs::system_dimensions[1]+0.01)/cells::macro_cell_size_y));
+            dfft::num_cells_z = static_cast<unsigned int>(ceil((cs::system_dimensions[2]+0.01)/cells::macro_cell_size_z));
+
+            // zero pad in non-periodic directions
+            dfft::n[0] = cs::pbc[0] ? dfft::num_cells_x : 2*dfft::num_cells_x;
+            dfft::n[1] = cs::pbc[1] ? dfft::num_cells_y : 2*dfft::num_cells_y;
+            dfft::n[2] = cs::pbc[2] ? dfft::num_cells_z : 2*dfft::num_cells_z;
+            dfft::nzc  = dfft::n[2]/2 + 1;
+
+            const ptrdiff_t nk[3] = { dfft::n[0], dfft::n[1], dfft::nzc };
+            const double inv_num_points = 1.0/(double(dfft::n[0])*double(dfft::n[1])*double(dfft::n[2]));
+
+            // determine local slabs and memory required for vector and tensor quantities
+            const ptrdiff_t alloc_3 = fftw_mpi_local_size_many_transposed(3, nk, 3, FFTW_MPI_DEFAULT_BLOCK, FFTW_MPI_DEFAULT_BLOCK, MPI_COMM_WORLD,
+                                                                          &dfft::local_n0, &dfft::local_0_start, &dfft::local_n1, &dfft::local_1_start);
+            const ptrdiff_t alloc_6 = fftw_mpi_local_size_many_transposed(3, nk, 6, FFTW_MPI_DEFAULT_BLOCK, FFTW_MPI_DEFAULT_BLOCK, MPI_COMM_WORLD,
+                                                                          &dfft::local_n0, &dfft::local_0_start, &dfft::local_n1, &dfft::local_1_start);
+
+            dfft::M_r = fftw_alloc_real(2*alloc_3);
+            dfft::H_r = fftw_alloc_real(2*alloc_3);
+            dfft::M_k = fftw_alloc_complex(alloc_3);
+            dfft::H_k = fftw_alloc_complex(alloc_3);
+            dfft::N_k = fftw_alloc_complex(alloc_6);
+
+            const double mem = double(4*alloc_3 + 2*alloc_3*2 + 2*alloc_6) * sizeof(double) / 1.0e6;
+            zlog << zTs() << "Distributed FFT dipole grid " << dfft::n[0] << " x " << dfft::n[1] << " x " << dfft::n[2] << " with " << dfft::local_n0 << " x planes on rank "
+                 << vmpi::my_rank << " requiring " << mem << " MB of RAM" << std::endl;
+
+            // plan transforms of interleaved xyz components, leaving k-space data transposed
+            dfft::plan_M = fftw_mpi_plan_many_dft_r2c(3, dfft::n, 3, FFTW_MPI_DEFAULT_BLOCK, FFTW_MPI_DEFAULT_BLOCK,
+                                                      dfft::M_r, dfft::M_k, MPI_COMM_WORLD, FFTW_MEASURE | FFTW_MPI_TRANSPOSED_OUT);
+            dfft::plan_H = fftw_mpi_plan_many_dft_c2r(3, dfft::n, 3, FFTW_MPI_DEFAULT_BLOCK, FFTW_MPI_DEFAULT_BLOCK,
+                                                      dfft::H_k, dfft::H_r, MPI_COMM_WORLD, FFTW_MEASURE | FFTW_MPI_TRANSPOSED_IN);
+
+            //---------------------------------------------------------------------
+            // Calculate interaction tensor for local slab in real space
+            // w(r) = (3 r r - I r^2) / r^5 with six unique components
+            //---------------------------------------------------------------------
+            double* N_r = fftw_alloc_real(2*alloc_6);
+            for(ptrdiff_t i = 0; i < 2*alloc_6; i++) N_r[i] = 0.0;
+
+            const ptrdiff_t nzr = 2*dfft::nzc; // padded real z dimension
+
+            // FFTW does not normalise the transform so do it here
+            dipole::calculate_fft_kernel(dfft::n[0], dfft::n[1], dfft::n[2], dfft::local_0_start, dfft::local_0_start + dfft::local_n0, nzr,
+                                         cells::macro_cell_size_x, cells::macro_cell_size_y, cells::macro_cell_size_z, inv_num_points, N_r);
+
+            fftw_plan plan_N = fftw_mpi_plan_many_dft_r2c(3, dfft::n, 6, FFTW_MPI_DEFAULT_BLOCK, FFTW_MPI_DEFAULT_BLOCK,
+                                                          N_r, dfft::N_k, MPI_COMM_WORLD, FFTW_ESTIMATE | FFTW_MPI_TRANSPOSED_OUT);
+            fftw_execute(plan_N);
+            fftw_destroy_plan(plan_N);
+            fftw_free(N_r);
+
+            // scale tensor to Tesla for magnetisation in Bohr magnetons
+            const ptrdiff_t num_tensor = 6*dfft::local_n1*dfft::n[0]*dfft::nzc;
+            for(ptrdiff_t i = 0; i < num_tensor; i++){
+               dfft::N_k[i][0] *= prefactor;
+               dfft::N_k[i][1] *= prefactor;
+            }
+
+            // optionally store tensor in single precision
+            if(dipole::internal::single_precision){
+               dfft::N_k_sp.resize(2*num_tensor);
+               for(ptrdiff_t i = 0; i < num_tensor; i++){
+                  dfft::N_k_sp[2*i]   = dfft::N_k[i][0];
+                  dfft::N_k_sp[2*i+1] = dfft::N_k[i][1];
+               }
+               fftw_free(dfft::N_k);
+               dfft::N_k = NULL;
+            }
+
+            //---------------------------------------------------------------------
+            // Determine magnetic cells in local slab
+            //---------------------------------------------------------------------
+            dfft::slab_cells.clear();
+            dfft::slab_index.clear();
+            for(ptrdiff_t xl = 0; xl < dfft::local_n0; xl++){
+               const ptrdiff_t i = dfft::local_0_start + xl;
+               if(i >= dfft::num_cells_x) continue; // padding
+               for(int j = 0; j < dfft::num_cells_y; j++){
+                  for(int k = 0; k < dfft::num_cells_z; k++){
+                     const int cell = (i*dfft::num_cells_y + j)*dfft::num_cells_z + k;
+                     if(cells::num_atoms_in_cell_global[cell] == 0) continue;
+                     dfft::slab_cells.push_back(cell);
+                     dfft::slab_index.push_back((xl*dfft::n[1] + j)*nzr + k);
+                  }
+               }
+            }
+
+            //---------------------------------------------------------------------
+            // Calculate intra cell tensors for cells in local slab
+            //
+            // Atoms are collected for the cells on each processor as for the
+            // tensor solver, and the tensors are then reduced over all
+            // processors since the slab owner generally holds none of the atoms
+            //---------------------------------------------------------------------
+            std::vector< std::vector<double> > atoms_in_cells_array; // positions and moments of atoms in local cells
+            std::vector<int> list_of_cells_with_atoms;                // cell IDs of atoms_in_cells_array
+
+            // zero cutoff to collect only atoms in local cells
+            dipole::internal::initialise_atomistic_cell_data(cells_num_cells, cells_num_local_cells, 0.0, cells_num_atoms_in_cell, cells_local_cell_array,
+                                                             cells::num_atoms_in_cell_global, cells_pos_and_mom_array, cells::index_atoms_array,
+                                                             atoms::x_coord_array, atoms::y_coord_array, atoms::z_coord_array, atoms::m_spin_array,
+                                                             list_of_cells_with_atoms, atoms_in_cells_array);
+
+            // cells split between processors are calculated more than once, so average
+            std::vector<double> intra_tensor(6*cells_num_cells, 0.0);
+            std::vector<double> intra_count(cells_num_cells, 0.0);
+            for(size_t idx = 0; idx < list_of_cells_with_atoms.size(); idx++){
+               const int cell = list_of_cells_with_atoms[idx];
+               dipole::internal::compute_intra_tensor(cells::num_atoms_in_cell_global[cell], atoms_in_cells_array[idx], &intra_tensor[6*cell]);
+               intra_count[cell] = 1.0;
+            }
+            vmpi::all_reduce_sum(intra_tensor);
+            vmpi::all_reduce_sum(intra_count);
+
+            dfft::slab_intra.resize(6*dfft::slab_cells.size());
+            for(size_t c = 0; c < dfft::slab_cells.size(); c++){
+               const int cell = dfft::slab_cells[c];
+               for(int t = 0; t < 6; t++) dfft::slab_intra[6*c+t] = prefactor*intra_tensor[6*cell+t]/intra_count[cell];
+            }
+
+            // allocate storage for cell fields
+            dipole::cells_field_array_x.resize(cells_num_cells,0.0);
+            dipole::cells_field_array_y.resize(cells_num_cells,0.0);
+            dipole::cells_field_array_z.resize(cells_num_cells,0.0);
+            dipole::cells_mu0Hd_field_array_x.resize(cells_num_cells,0.0);
+            dipole::cells_mu0Hd_field_array_y.resize(cells_num_cells,0.0);
+            dipole::cells_mu0Hd_field_array_z.resize(cells_num_cells,0.0);
+
+            // set up exchange of fields for local cells from slab owners
+            std::vector<int> required_cells(cells::cell_id_array.begin(), cells::cell_id_array.begin()+cells_num_local_cells);
+            if(micromagnetic::discretisation_type != 0){
+               required_cells.insert(required_cells.end(), micromagnetic::list_of_micromagnetic_cells.begin(), micromagnetic::list_of_micromagnetic_cells.end());
+            }
+            dipole::internal::initialize_cell_field_exchange(dfft::slab_cells, required_cells);
+
+         #else
+
+            terminaltextcolor(RED);
+            std::cerr << "Error - distributed-fft dipole solver requires compilation with MPI and FFTW (-DMPICF -DFFT). Exiting." << std::endl;
+            terminaltextcolor(WHITE);
+            zlog << zTs() << "Error - distributed-fft dipole solver requires compilation with MPI and FFTW (-DMPICF -DFFT). Exiting." << std::endl;
+            err::vexit();
+
+         #endif
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to update cell dipole fields with distributed FFT solver
+      //------------------------------------------------------------------------
+      void update_field_distributed_fft(){
+
+         #if defined(FFT) && defined(MPICF)
+
+            // Define constant imuB = 1/muB to normalise to unitarian values the cell magnetisation
+            const double imuB = 1.0/9.27400915e-24;
+
+            const ptrdiff_t num_slab_cells = dfft::slab_cells.size();
+
+            // load normalised cell magnetisation into local slab
+            for(ptrdiff_t i = 0; i < 6*dfft::local_n0*dfft::n[1]*dfft::nzc; i++) dfft::M_r[i] = 0.0;
+            for(ptrdiff_t c = 0; c < num_slab_cells; c++){
+               const int cell = dfft::slab_cells[c];
+               double* m = &dfft::M_r[3*dfft::slab_index[c]];
+               m[0] = cells::mag_array_x[cell]*imuB;
+               m[1] = cells::mag_array_y[cell]*imuB;
+               m[2] = cells::mag_array_z[cell]*imuB;
+            }
+
+            // forward transform (result transposed)
+            fftw_execute(dfft::plan_M);
+
+            // multiply by symmetric interaction tensor in transposed layout
+            const ptrdiff_t num_k = dfft::local_n1*dfft::n[0]*dfft::nzc;
+            if(dipole::internal::single_precision){
+               for(ptrdiff_t p = 0; p < num_k; p++) dipole::fft_tensor_product(&dfft::N_k_sp[12*p], &dfft::M_k[3*p], &dfft::H_k[3*p]);
+            }
+            else{
+               for(ptrdiff_t p = 0; p < num_k; p++) dipole::fft_tensor_product(&dfft::N_k[6*p][0], &dfft::M_k[3*p], &dfft::H_k[3*p]);
+            }
+
+            // inverse transform (from transposed data)
+            fftw_execute(dfft::plan_H);
+
+            // save dipole and demag fields for cells in local slab, adding intra cell and self demagnetisation fields
+            for(ptrdiff_t c = 0; c < num_slab_cells; c++){
+
+               const int cell = dfft::slab_cells[c];
+
+               // MPI transforms may overwrite their input, so reload magnetisation
+               const double m[3] = { cells::mag_array_x[cell]*imuB, cells::mag_array_y[cell]*imuB, cells::mag_array_z[cell]*imuB };
+
+               // add intra cell field
+               const double* w = &dfft::slab_intra[6*c];
+               const double* hr = &dfft::H_r[3*dfft::slab_index[c]];
+               const double h[3] = { hr[0] + w[0]*m[0] + w[1]*m[1] + w[2]*m[2],
+                                     hr[1] + w[1]*m[0] + w[3]*m[1] + w[4]*m[2],
+                                     hr[2] + w[2]*m[0] + w[4]*m[1] + w[5]*m[2] };
+
+               // self demagnetisation mu_0/4_PI * 8PI*m_cell/3V
+               const double self_demag = 9.27400915e-01*8.0*M_PI/(3.0*dipole::internal::cells_volume_array[cell]);
+
+               dipole::cells_field_array_x[cell] = h[0] + self_demag*m[0];
+               dipole::cells_field_array_y[cell] = h[1] + self_demag*m[1];
+               dipole::cells_field_array_z[cell] = h[2] + self_demag*m[2];
+
+               dipole::cells_mu0Hd_field_array_x[cell] = h[0] - 0.5*self_demag*m[0];
+               dipole::cells_mu0Hd_field_array_y[cell] = h[1] - 0.5*self_demag*m[1];
+               dipole::cells_mu0Hd_field_array_z[cell] = h[2] - 0.5*self_demag*m[2];
+
+            }
+
+            // receive fields for local cells from slab owners
+            dipole::internal::exchange_cell_fields();
+
+         #endif
+
+         return;
+
+      }
+
+   } // end of internal namespace
+
+} // end of dipole namespace
@@ -0,0 +1,71 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2024. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cmath>
+#include <cstddef>
+
+// Vampire headers
+#include "dipole.hpp"
+
+namespace dipole{
+
+   //---------------------------------------------------------------------------
+   // Function to calculate dipole interaction tensor on a regular FFT grid
+   //
+   //                 w(r) = scale * (3 r r - I r^2) / r^5
+   //
+   // for the nx x ny x nz grid with cell sizes dx, dy, dz, using the usual
+   // wrap around ordering so that points i > n/2 correspond to negative
+   // displacements. The six unique components are stored interleaved as
+   // [x][y][z][xx xy xz yy yz zz] for x planes x_start <= i < x_end, with
+   // z_stride points per z column to allow for in-place transform padding.
+   // The self interaction is set to zero and padding points are untouched.
+   // The scale should include 1/(nx*ny*nz) as FFTW transforms are not
+   // normalised.
+   //---------------------------------------------------------------------------
+   void calculate_fft_kernel(const int nx, const int ny, const int nz,
+                             const int x_start, const int x_end, const int z_stride,
+                             const double dx, const double dy, const double dz,
+                             const double scale, double* kernel){
+
+      for(int i = x_start; i < x_end; i++){
+         const double rx = double( i > nx/2 ? i - nx : i ) * dx;
+         for(int j = 0; j < ny; j++){
+            const double ry = double( j > ny/2 ? j - ny : j ) * dy;
+            for(int k = 0; k < nz; k++){
+               const double rz = double( k > nz/2 ? k - nz : k ) * dz;
+
+               double* w = &kernel[6*((size_t(i - x_start)*ny + j)*z_stride + k)];
+
+               const double r2 = rx*rx + ry*ry + rz*rz;
+               if(r2 < 1.0e-10){
+                  for(int c = 0; c < 6; c++) w[c] = 0.0;
+                  continue;
+               }
+
+               const double ir5 = scale / (r2*r2*sqrt(r2));
+               w[0] = (3.0*rx*rx - r2) * ir5;
+               w[1] = (3.0*rx*ry     ) * ir5;
+               w[2] = (3.0*rx*rz     ) * ir5;
+               w[3] = (3.0*ry*ry - r2) * ir5;
+               w[4] = (3.0*ry*rz     ) * ir5;
+               w[5] = (3.0*rz*rz - r2) * ir5;
+            }
+         }
+      }
+
+      return;
+
+   }
+
+} // end of dipole namespace
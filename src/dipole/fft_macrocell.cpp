@@ -83,6 +83,7 @@ namespace dipole{
         fftw_complex    *int_mat_k; // K-space interaction matrix
         fftw_complex    *M_k;       // K-space Magnetisation
         fftw_complex    *H_k;       // K-space field
+        std::vector<float> int_mat_k_sp; // single precision K-space interaction matrix [re im]
 
         fftw_plan       plan_M;
         fftw_plan       plan_H;
@@ -104,8 +105,12 @@ namespace dipole{
             a[0] += (b[0] * c[0] - b[1] * c[1]);
             a[1] += (b[0] * c[1] + b[1] * c[0]);
         }
+        inline void complex_multiply_add( fftw_complex& a, const float* b, fftw_complex& c)
+        {
+            a[0] += (b[0] * c[0] - b[1] * c[1]);
+            a[1] += (b[0] * c[1] + b[1] * c[0]);
+        }
 
-        double delta_fn ( const int i, const int j) { return (i==j) ? 1 : 0;}
 
 
         //-----------------------------------------------------------------------------
@@ -174,7 +179,8 @@ namespace dipole{
             int_mat_k = (fftw_complex*) fftw_malloc( sizeof(fftw_complex) * 9 * N);
 
             // Calculate memory requirements and inform user
-            const double mem = double(N) * ( 6*sizeof(double)  + 15*sizeof(fftw_complex)) / 1.0e6;
+            const double int_mat_size = dipole::internal::single_precision ? 2*sizeof(float) : sizeof(fftw_complex);
+            const double mem = double(N) * ( 6*sizeof(double)  + 6*sizeof(fftw_complex) + 9*int_mat_size) / 1.0e6;
             zlog << zTs() << "Macrocell FFT dipole field calculation has been enabled and requires " << mem << " MB of RAM" << std::endl;
             std::cout     << "Macrocell FFT dipole field calculation has been enabled and requires " << mem << " MB of RAM" << std::endl;
 
@@ -220,31 +226,13 @@ namespace dipole{
             // loop over the system mesh to
             // construct the interaction matrix
             // w(r) = (\mu_0 / 4 pi r^5) (3 r \outer r - I r*r)
-            int ind = 0;
-            for( int i = 0 ; i < Nx; i++) {
-                for( int j = 0; j < Ny; j++) {
-                    for( int k = 0; k < Nz; k++) {
-                            double rx = ( i > Nx/2) ? i - Nx : i;
-                            double ry = ( j > Ny/2) ? j - Ny : j;
-                            double rz = ( k > Nz/2) ? k - Nz : k;
-                            double rij[3] = {rx*dx, ry*dy, rz*dz};
-                            double r = sqrt( rij[0]*rij[0] + rij[1]*rij[1] + rij[2]*rij[2]);
-                            double w0 = prefactor / (r*r*r*r*r);
-                            // FFTW does not normalise the transform so we do here.
-                            w0 /= double(N);
-                            for( int a = 0; a < 3; a++) {
-                                for( int b = 0; b < 3; b++) {
-                                    int id = b + 3*a;
-                                    int idx = id + 9 * (k + Nz * (j + Ny * i));
-                                    int_mat_r[idx] = w0 * ( 3* rij[a] * rij[b] - delta_fn(a,b) * r * r);
-                                }
-                            }
-                        }
-                }
+            // FFTW does not normalise the transform so we do here.
+            std::vector<double> w(6*N);
+            dipole::calculate_fft_kernel(Nx, Ny, Nz, 0, Nx, Nz, dx, dy, dz, prefactor/double(N), w.data());
+            const int component[9] = {0, 1, 2, 1, 3, 4, 2, 4, 5}; // [xx xy xz yy yz zz] -> 3x3
+            for( int i = 0; i < N; i++) {
+                for( int a = 0; a < 9; a++) int_mat_r[a + 9*i] = w[component[a] + 6*i];
             }
-            // Zero out the self-interaction
-            for( int a = 0; a < 9; a++)
-                int_mat_r[a] = 0.0;
 
             /*
             for( int i = 0 ; i < Nx; i++) {
@@ -271,6 +259,17 @@ namespace dipole{
 
             fftw_free(int_mat_r);
 
+            // Optionally store interaction matrix in single precision
+            if(dipole::internal::single_precision){
+                int_mat_k_sp.resize(2*9*N);
+                for( int i = 0; i < 9*N; i++){
+                    int_mat_k_sp[2*i]   = int_mat_k[i][0];
+                    int_mat_k_sp[2*i+1] = int_mat_k[i][1];
+                }
+                fftw_free(int_mat_k);
+                int_mat_k = NULL;
+            }
+
 
             // Now construct list of where each cell sits in the arrays
             cell_idx.resize(cells::num_cells);
@@ -300,8 +299,10 @@ namespace dipole{
 
         }
 
-        void update_field_fft(){
+        void update_field_fft(const bool update_magnetisation){
 
+            // unused without FFT
+            (void) update_magnetisation;
 
 #ifdef FFT
             if(!FFT_initialised) {
@@ -313,8 +314,8 @@ namespace dipole{
             vutil::vtimer_t timer;
 
 
-            // update cell magnetisations
-            cells::mag();
+            // update cell magnetisations (unless just updated by adaptive update check)
+            if(update_magnetisation) cells::mag();
 
             //   start timer
             timer.start();
@@ -346,7 +347,8 @@ namespace dipole{
                                 int int_idx = id + 9 * (k + Nz * (j + Ny * i));
                                 int M_idx = a + 3*(k + Nz * (j + Ny * i));
                                 int H_idx = b + 3*(k + Nz * (j + Ny * i));
-                                complex_multiply_add( H_k[H_idx], int_mat_k[int_idx], M_k[M_idx] );
+                                if(dipole::internal::single_precision) complex_multiply_add( H_k[H_idx], &int_mat_k_sp[2*int_idx], M_k[M_idx] );
+                                else complex_multiply_add( H_k[H_idx], int_mat_k[int_idx], M_k[M_idx] );
                             }
                         }
                     }
@@ -421,7 +423,8 @@ namespace dipole{
             fftw_free(M_k);
             fftw_free(H_r);
             fftw_free(H_k);
-            fftw_free(int_mat_k);
+            if(int_mat_k != NULL) fftw_free(int_mat_k);
+            std::vector<float>().swap(int_mat_k_sp);
 
             fftw_destroy_plan(plan_M);
             fftw_destroy_plan(plan_H);
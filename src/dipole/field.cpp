@@ -35,7 +35,7 @@
 namespace dipole{
 
    namespace internal{
-      void calculate_macrocell_dipole_field();
+      void calculate_macrocell_dipole_field(const bool update_magnetisation);
    }
 
    //-----------------------------------------------------------------------------
@@ -54,8 +54,13 @@ namespace dipole{
 		// prevent double calculation for split integration (MPI)
 		if(dipole::internal::update_time != static_cast<int>(sim_time)){
 
-			// Check if update required
-		   if(sim_time%dipole::update_rate == 0){
+			// Check if update required (at fixed rate or on change in magnetisation)
+			const bool update_required = dipole::internal::adaptive_update ? dipole::internal::adaptive_update_required(sim_time)
+			                                                               : (sim_time%dipole::update_rate == 0);
+		   if(update_required){
+
+            // cell magnetisations are already calculated when checking for adaptive update
+            const bool update_magnetisation = !dipole::internal::adaptive_update;
 
 			   //if updated record last time at update
 			   dipole::internal::update_time = sim_time;
@@ -66,14 +71,14 @@ namespace dipole{
             switch (dipole::internal::solver){
 
                case dipole::internal::macrocell:
-                  dipole::internal::calculate_macrocell_dipole_field();
+                  dipole::internal::calculate_macrocell_dipole_field(update_magnetisation);
                   break;
 
                case dipole::internal::tensor:
                   #ifdef CUDA
                	   gpu::update_dipolar_fields();
                   #else
-                     dipole::internal::calculate_macrocell_dipole_field();
+                     dipole::internal::calculate_macrocell_dipole_field(update_magnetisation);
                   #endif
                   break;
 
@@ -82,17 +87,25 @@ namespace dipole{
                   break;
 
                case dipole::internal::hierarchical:
-                  hierarchical::update(x_spin_array, y_spin_array, z_spin_array, m_spin_array, magnetic);
+                  hierarchical::update(x_spin_array, y_spin_array, z_spin_array, m_spin_array, magnetic, update_magnetisation);
                   break;
 
                case dipole::internal::fft:
-                  dipole::internal::update_field_fft();
+                  dipole::internal::update_field_fft(update_magnetisation);
                   break;
 
                case dipole::internal::atomisticfft:
                   dipole::internal::atomistic_fft::update_field_atomistic_fft();
                   break;
 
+               case dipole::internal::distributedfft:
+                  dipole::internal::calculate_macrocell_dipole_field(update_magnetisation);
+                  break;
+
+               case dipole::internal::atomisticfmm:
+                  dipole::internal::atomistic_fmm::update_field_atomistic_fmm(x_spin_array, y_spin_array, z_spin_array);
+                  break;
+
 
             }
 
@@ -110,14 +123,14 @@ namespace dipole{
 
    namespace internal{
 
-      void calculate_macrocell_dipole_field(){
+      void calculate_macrocell_dipole_field(const bool update_magnetisation){
          // instantiate timer of cells::mag() function
          //vutil::vtimer_t timer;
          // start timer
          //timer.start();
 
          // update cell magnetisations
-         cells::mag();
+         if(update_magnetisation) cells::mag();
 
          // end timer
          //timer.stop();
@@ -127,7 +140,8 @@ namespace dipole{
          //zlog << zTs() << "Calculation cells magnetisation complete. Time taken: " << update_time << "s."<< std::endl;
 
          // recalculate dipole fields
-         dipole::internal::update_field();
+         if(dipole::internal::solver == dipole::internal::distributedfft) dipole::internal::update_field_distributed_fft();
+         else dipole::internal::update_field();
 
          // For MPI version, only add local atoms
          #ifdef MPICF
@@ -0,0 +1,787 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2024. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+// Vampire headers
+#include "dipole.hpp"
+#include "errors.hpp"
+#include "material.hpp"
+#include "sim.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// dipole module headers
+#include "internal.hpp"
+
+namespace dipole{
+
+   namespace internal{
+
+      //------------------------------------------------------------------------
+      // Atomistic dipole solver with near field cutoff and octree multipoles
+      //
+      // Space is divided into a regular grid of leaf boxes with side equal to
+      // the atomistic cutoff radius, which are merged into an octree. The
+      // field from distant atoms is calculated from the dipole moment M and
+      // its first moment Q_ab = sum (r-c)_a m_b of tree nodes about their
+      // centres c, with nodes accepted when
+      //
+      //             node size < theta * (distance - leaf radius)
+      //
+      // so that the opening angle theta controls the accuracy. The field from
+      // atoms in leaves which are not accepted, always including the same and
+      // neighbouring leaves (and so all atoms within the cutoff), is summed
+      // exactly using a cell linked list. As the atoms do not move, the near
+      // and far interaction lists are calculated once per leaf box at
+      // initialisation.
+      //
+      // Each processor only stores the tree nodes in a window about the nodes
+      // containing its own atoms at each level. A node accepted for a leaf at
+      // level l lies within a fixed number of level l nodes of the leaf, set
+      // by the opening angle, so a halo of this width contains all nodes in
+      // the interaction lists. Multipoles of owned nodes are calculated from
+      // local atoms and added to the windows of processors they overlap, and
+      // only the spins of atoms in leaf boxes neighbouring the local domain
+      // are exchanged for the near field. Periodic boundaries are ignored, as
+      // for the direct atomistic solver.
+      //------------------------------------------------------------------------
+      namespace atomistic_fmm{
+
+         const int num_multipole = 12; // M (xyz) and Q (3x3, [position][moment])
+
+         int num_local_atoms; // number of local atoms (excluding halo)
+         int num_levels;      // number of levels in octree (0 = leaves)
+         int num_halo;        // width of halo of nodes about owned nodes at each level
+         double box_size;     // side of leaf box (Angstroms)
+         double origin[3];    // minimum corner of leaf grid
+
+         std::vector<int> level_nx; // global number of nodes in x,y,z at each level
+         std::vector<int> level_ny;
+         std::vector<int> level_nz;
+
+         std::vector<int> owned_min;     // range of nodes containing local atoms [level][xyz]
+         std::vector<int> owned_max;
+         std::vector<int> window_min;    // range of nodes stored on this processor [level][xyz]
+         std::vector<int> window_max;
+         std::vector<int> window_offset; // index of first window node at each level
+
+         std::vector<int> node_num_atoms;    // global number of atoms in each window node
+         std::vector<double> node_centres;   // centre of each window node [node][xyz]
+         std::vector<double> node_multipole; // multipoles for window nodes [node][12]
+
+         // source atoms (local and neighbouring remote atoms) sorted by leaf
+         std::vector<int> leaf_source_start; // [window leaf] -> first source in leaf
+         std::vector<double> src_x, src_y, src_z; // coordinates
+         std::vector<double> src_sx, src_sy, src_sz; // spin moments (spin direction * mu_s)
+         std::vector<double> src_mu; // magnetic moment (Bohr magnetons)
+         std::vector<int> src_atom;  // local atom id or -1 for remote atoms
+         std::vector<int> atom_source; // [local atom] -> source index
+         std::vector<int> atom_leaf;   // [local atom] -> local leaf index
+
+         // interaction lists for leaves with local atoms
+         std::vector<int> local_leaves; // window index of local leaves
+         std::vector<int> near_start, near_list; // leaves summed exactly
+         std::vector<int> far_start, far_list;   // accepted tree nodes
+
+         // data for exchange of neighbouring spins between processors
+         std::vector<int> send_list;    // local atoms sent to other processors
+         std::vector<int> send_counts;
+         std::vector<int> send_displacements;
+         std::vector<int> recv_counts;
+         std::vector<int> recv_displacements;
+         std::vector<int> recv_source;  // source index of each received atom
+         std::vector<double> send_buffer;
+         std::vector<double> recv_buffer;
+
+         // data for reduction of owned node data into windows of other processors
+         std::vector<int> node_send_list; // owned window nodes sent to other processors
+         std::vector<int> node_send_counts;
+         std::vector<int> node_send_displacements;
+         std::vector<int> node_recv_list; // window nodes received from other processors
+         std::vector<int> node_recv_counts;
+         std::vector<int> node_recv_displacements;
+         std::vector<double> node_send_buffer;
+         std::vector<double> node_recv_buffer;
+
+         //---------------------------------------------------------------------
+         // Function to calculate centre of tree node
+         //---------------------------------------------------------------------
+         inline void node_centre(const int level, const int ix, const int iy, const int iz, double c[3]){
+            const double size = box_size * double(1 << level);
+            c[0] = origin[0] + (double(ix) + 0.5) * size;
+            c[1] = origin[1] + (double(iy) + 0.5) * size;
+            c[2] = origin[2] + (double(iz) + 0.5) * size;
+         }
+
+         //---------------------------------------------------------------------
+         // Function to calculate leaf box containing a point
+         //---------------------------------------------------------------------
+         inline void leaf_of(const double x, const double y, const double z, int c[3]){
+            c[0] = std::min(std::max(int((x - origin[0]) / box_size), 0), level_nx[0] - 1);
+            c[1] = std::min(std::max(int((y - origin[1]) / box_size), 0), level_ny[0] - 1);
+            c[2] = std::min(std::max(int((z - origin[2]) / box_size), 0), level_nz[0] - 1);
+         }
+
+         //---------------------------------------------------------------------
+         // Function to calculate index of node in window (-1 if outside)
+         //---------------------------------------------------------------------
+         inline int window_node(const int level, const int ix, const int iy, const int iz){
+            const int* wmin = &window_min[3*level];
+            const int* wmax = &window_max[3*level];
+            if(ix < wmin[0] || ix > wmax[0] || iy < wmin[1] || iy > wmax[1] || iz < wmin[2] || iz > wmax[2]) return -1;
+            const int wy = wmax[1] - wmin[1] + 1;
+            const int wz = wmax[2] - wmin[2] + 1;
+            return window_offset[level] + ((ix - wmin[0]) * wy + (iy - wmin[1])) * wz + (iz - wmin[2]);
+         }
+
+         //---------------------------------------------------------------------
+         // Function to add node data of size n per node calculated from local
+         // atoms to windows of all processors (does nothing in serial, where
+         // the window contains all nodes)
+         //---------------------------------------------------------------------
+         void reduce_windows(std::vector<double>& data, const int n){
+
+            // unused in serial
+            (void) data;
+            (void) n;
+
+            #ifdef MPICF
+
+               const int num_procs = vmpi::num_processors;
+               std::vector<int> counts(num_procs), displs(num_procs), rcounts(num_procs), rdispls(num_procs);
+               for(int p = 0; p < num_procs; p++){
+                  counts[p]  = n * node_send_counts[p]; displs[p]  = n * node_send_displacements[p];
+                  rcounts[p] = n * node_recv_counts[p]; rdispls[p] = n * node_recv_displacements[p];
+               }
+
+               node_send_buffer.resize(n * node_send_list.size());
+               node_recv_buffer.resize(n * node_recv_list.size());
+               for(size_t i = 0; i < node_send_list.size(); i++){
+                  std::copy(&data[n * node_send_list[i]], &data[n * (node_send_list[i] + 1)], &node_send_buffer[n * i]);
+               }
+               MPI_Alltoallv(node_send_buffer.data(), counts.data(), displs.data(), MPI_DOUBLE,
+                             node_recv_buffer.data(), rcounts.data(), rdispls.data(), MPI_DOUBLE, MPI_COMM_WORLD);
+               for(size_t i = 0; i < node_recv_list.size(); i++){
+                  for(int k = 0; k < n; k++) data[n * node_recv_list[i] + k] += node_recv_buffer[n * i + k];
+               }
+
+            #endif
+
+            return;
+
+         }
+
+         //---------------------------------------------------------------------
+         // Function to initialise atomistic multipole solver
+         //---------------------------------------------------------------------
+         void initialize_atomistic_fmm_solver(int num_atoms,                      // number of atoms (only correct in serial)
+                                              std::vector<double>& x_coord_array, // atomic coordinates (angstroms)
+                                              std::vector<double>& y_coord_array,
+                                              std::vector<double>& z_coord_array,
+                                              std::vector<double>& moments_array, // atomistic magnetic moments (bohr magnetons)
+                                              std::vector<int>& mat_id_array){    // atom material ID
+
+            #ifdef MPICF
+               num_local_atoms = vmpi::num_core_atoms + vmpi::num_bdry_atoms;
+            #else
+               num_local_atoms = num_atoms;
+            #endif
+
+            // Zero all moments for non-magnetic materials
+            std::vector<double> mu(num_local_atoms);
+            for(int atom = 0; atom < num_local_atoms; atom++){
+               mu[atom] = mp::material[mat_id_array[atom]].non_magnetic ? 0.0 : moments_array[atom];
+            }
+
+            //------------------------------------------------------------------
+            // Determine leaf grid from global extent of atoms
+            //------------------------------------------------------------------
+            double min_r[3] = { 1.0e300, 1.0e300, 1.0e300 };
+            double max_r[3] = { -1.0e300, -1.0e300, -1.0e300 };
+            for(int atom = 0; atom < num_local_atoms; atom++){
+               min_r[0] = std::min(min_r[0], x_coord_array[atom]); max_r[0] = std::max(max_r[0], x_coord_array[atom]);
+               min_r[1] = std::min(min_r[1], y_coord_array[atom]); max_r[1] = std::max(max_r[1], y_coord_array[atom]);
+               min_r[2] = std::min(min_r[2], z_coord_array[atom]); max_r[2] = std::max(max_r[2], z_coord_array[atom]);
+            }
+            #ifdef MPICF
+               MPI_Allreduce(MPI_IN_PLACE, min_r, 3, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+               MPI_Allreduce(MPI_IN_PLACE, max_r, 3, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+            #endif
+
+            box_size = dipole::atomistic_cutoff;
+            for(int d = 0; d < 3; d++) origin[d] = min_r[d] - 0.01;
+
+            level_nx.assign(1, int((max_r[0] - origin[0]) / box_size) + 1);
+            level_ny.assign(1, int((max_r[1] - origin[1]) / box_size) + 1);
+            level_nz.assign(1, int((max_r[2] - origin[2]) / box_size) + 1);
+
+            // merge 2x2x2 nodes until only one node remains
+            int64_t num_global_nodes = int64_t(level_nx[0]) * level_ny[0] * level_nz[0];
+            const int64_t num_leaves = num_global_nodes;
+            while(level_nx.back() > 1 || level_ny.back() > 1 || level_nz.back() > 1){
+               level_nx.push_back((level_nx.back() + 1) / 2);
+               level_ny.push_back((level_ny.back() + 1) / 2);
+               level_nz.push_back((level_nz.back() + 1) / 2);
+               num_global_nodes += int64_t(level_nx.back()) * level_ny.back() * level_nz.back();
+            }
+            num_levels = level_nx.size();
+
+            //------------------------------------------------------------------
+            // Determine owned nodes and window of nodes stored at each level
+            //------------------------------------------------------------------
+            // Nodes visited in the tree traversal for a leaf are children of
+            // rejected nodes, which are within 1/theta + sqrt(3)/4 + 1/2 nodes
+            // of the ancestor of the leaf, and so within 2/theta + sqrt(3)/2 + 2
+            // nodes of the leaf at the same level
+            const double theta = dipole::internal::fmm_opening_angle;
+            num_halo = int(ceil(2.0/theta + 0.5*sqrt(3.0))) + 3;
+
+            const int* const level_n[3] = { level_nx.data(), level_ny.data(), level_nz.data() };
+
+            // range of leaves containing local atoms (empty if no local atoms)
+            int leaf_min[3] = { level_nx[0], level_ny[0], level_nz[0] };
+            int leaf_max[3] = { -1, -1, -1 };
+            for(int atom = 0; atom < num_local_atoms; atom++){
+               int c[3];
+               leaf_of(x_coord_array[atom], y_coord_array[atom], z_coord_array[atom], c);
+               for(int d = 0; d < 3; d++){
+                  leaf_min[d] = std::min(leaf_min[d], c[d]);
+                  leaf_max[d] = std::max(leaf_max[d], c[d]);
+               }
+            }
+
+            owned_min.resize(3 * num_levels);  owned_max.resize(3 * num_levels);
+            window_min.resize(3 * num_levels); window_max.resize(3 * num_levels);
+            window_offset.resize(num_levels + 1);
+            window_offset[0] = 0;
+            for(int l = 0; l < num_levels; l++){
+               int64_t size = 1;
+               for(int d = 0; d < 3; d++){
+                  owned_min[3*l+d] = leaf_min[d] >> l;
+                  owned_max[3*l+d] = leaf_max[d] >> l;
+                  if(owned_min[3*l+d] > owned_max[3*l+d]){
+                     window_min[3*l+d] = 0;
+                     window_max[3*l+d] = -1;
+                  }
+                  else{
+                     window_min[3*l+d] = std::max(owned_min[3*l+d] - num_halo, 0);
+                     window_max[3*l+d] = std::min(owned_max[3*l+d] + num_halo, level_n[d][l] - 1);
+                  }
+                  size *= window_max[3*l+d] - window_min[3*l+d] + 1;
+               }
+               window_offset[l+1] = window_offset[l] + size;
+            }
+            const int num_nodes = window_offset[num_levels];
+            const int num_window_leaves = window_offset[1];
+
+            node_centres.resize(3 * num_nodes);
+            for(int l = 0; l < num_levels; l++){
+               for(int ix = window_min[3*l+0]; ix <= window_max[3*l+0]; ix++){
+                  for(int iy = window_min[3*l+1]; iy <= window_max[3*l+1]; iy++){
+                     for(int iz = window_min[3*l+2]; iz <= window_max[3*l+2]; iz++){
+                        node_centre(l, ix, iy, iz, &node_centres[3 * window_node(l, ix, iy, iz)]);
+                     }
+                  }
+               }
+            }
+
+            //------------------------------------------------------------------
+            // Determine owned nodes sent to windows of other processors
+            //------------------------------------------------------------------
+            #ifdef MPICF
+
+               const int num_procs = vmpi::num_processors;
+
+               // owned and window ranges of all processors [proc][level][min xyz, max xyz]
+               std::vector<int> boxes(12 * num_levels);
+               for(int l = 0; l < num_levels; l++){
+                  for(int d = 0; d < 3; d++){
+                     boxes[12*l+0+d] = owned_min[3*l+d];
+                     boxes[12*l+3+d] = owned_max[3*l+d];
+                     boxes[12*l+6+d] = window_min[3*l+d];
+                     boxes[12*l+9+d] = window_max[3*l+d];
+                  }
+               }
+               std::vector<int> all_boxes(12 * num_levels * num_procs);
+               MPI_Allgather(boxes.data(), 12 * num_levels, MPI_INT, all_boxes.data(), 12 * num_levels, MPI_INT, MPI_COMM_WORLD);
+
+               // nodes in intersection of owned range of one processor with window of another, in the same order on both
+               node_send_list.clear(); node_send_counts.assign(num_procs, 0); node_send_displacements.assign(num_procs, 0);
+               node_recv_list.clear(); node_recv_counts.assign(num_procs, 0); node_recv_displacements.assign(num_procs, 0);
+               for(int p = 0; p < num_procs; p++){
+                  node_send_displacements[p] = node_send_list.size();
+                  node_recv_displacements[p] = node_recv_list.size();
+                  if(p == vmpi::my_rank) continue;
+                  for(int l = 0; l < num_levels; l++){
+                     const int* other = &all_boxes[12 * (num_levels * p + l)];
+                     int send_min[3], send_max[3], recv_min[3], recv_max[3];
+                     for(int d = 0; d < 3; d++){
+                        send_min[d] = std::max(owned_min[3*l+d], other[6+d]);
+                        send_max[d] = std::min(owned_max[3*l+d], other[9+d]);
+                        recv_min[d] = std::max(other[0+d], window_min[3*l+d]);
+                        recv_max[d] = std::min(other[3+d], window_max[3*l+d]);
+                     }
+                     for(int ix = send_min[0]; ix <= send_max[0]; ix++){
+                        for(int iy = send_min[1]; iy <= send_max[1]; iy++){
+                           for(int iz = send_min[2]; iz <= send_max[2]; iz++) node_send_list.push_back(window_node(l, ix, iy, iz));
+                        }
+                     }
+                     for(int ix = recv_min[0]; ix <= recv_max[0]; ix++){
+                        for(int iy = recv_min[1]; iy <= recv_max[1]; iy++){
+                           for(int iz = recv_min[2]; iz <= recv_max[2]; iz++) node_recv_list.push_back(window_node(l, ix, iy, iz));
+                        }
+                     }
+                  }
+                  node_send_counts[p] = node_send_list.size() - node_send_displacements[p];
+                  node_recv_counts[p] = node_recv_list.size() - node_recv_displacements[p];
+               }
+
+            #endif
+
+            //------------------------------------------------------------------
+            // Determine global number of atoms in each window node
+            //------------------------------------------------------------------
+            std::vector<double> count(num_nodes, 0.0);
+            for(int atom = 0; atom < num_local_atoms; atom++){
+               int c[3];
+               leaf_of(x_coord_array[atom], y_coord_array[atom], z_coord_array[atom], c);
+               count[window_node(0, c[0], c[1], c[2])] += 1.0;
+            }
+            for(int l = 1; l < num_levels; l++){
+               for(int ix = owned_min[3*l+0]; ix <= owned_max[3*l+0]; ix++){
+                  for(int iy = owned_min[3*l+1]; iy <= owned_max[3*l+1]; iy++){
+                     for(int iz = owned_min[3*l+2]; iz <= owned_max[3*l+2]; iz++){
+                        const int parent = window_node(l, ix, iy, iz);
+                        for(int cx = 2*ix; cx <= std::min(2*ix+1, level_nx[l-1]-1); cx++){
+                           for(int cy = 2*iy; cy <= std::min(2*iy+1, level_ny[l-1]-1); cy++){
+                              for(int cz = 2*iz; cz <= std::min(2*iz+1, level_nz[l-1]-1); cz++){
+                                 const int child = window_node(l-1, cx, cy, cz);
+                                 if(child >= 0) count[parent] += count[child];
+                              }
+                           }
+                        }
+                     }
+                  }
+               }
+            }
+            reduce_windows(count, 1);
+            node_num_atoms.resize(num_nodes);
+            for(int node = 0; node < num_nodes; node++) node_num_atoms[node] = int(count[node] + 0.5);
+            node_multipole.assign(num_multipole * num_nodes, 0.0);
+
+            //------------------------------------------------------------------
+            // Receive coordinates of remote atoms in neighbouring leaves
+            //------------------------------------------------------------------
+            std::vector<double> remote_coords; // x,y,z,mu for received atoms
+
+            #ifdef MPICF
+
+               // leaves not accepted for multipoles are at most num_near leaves away
+               const int num_near = std::max(1, int(ceil(1.0/theta + 0.5*sqrt(3.0))));
+
+               // determine local atoms needed by each other processor (in leaves within num_near of its owned leaves)
+               send_list.clear();
+               send_counts.assign(num_procs, 0);
+               send_displacements.assign(num_procs, 0);
+               for(int p = 0; p < num_procs; p++){
+                  send_displacements[p] = send_list.size();
+                  if(p == vmpi::my_rank) continue;
+                  const int* other = &all_boxes[12 * num_levels * p];
+                  for(int atom = 0; atom < num_local_atoms; atom++){
+                     int c[3];
+                     leaf_of(x_coord_array[atom], y_coord_array[atom], z_coord_array[atom], c);
+                     bool near = true;
+                     for(int d = 0; d < 3; d++) near = near && c[d] >= other[d] - num_near && c[d] <= other[3+d] + num_near;
+                     if(near) send_list.push_back(atom);
+                  }
+                  send_counts[p] = send_list.size() - send_displacements[p];
+               }
+
+               recv_counts.assign(num_procs, 0);
+               recv_displacements.assign(num_procs, 0);
+               MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+               int num_recv = 0;
+               for(int p = 0; p < num_procs; p++){
+                  recv_displacements[p] = num_recv;
+                  num_recv += recv_counts[p];
+               }
+
+               // exchange coordinates and moments (4 values per atom)
+               std::vector<int> counts4(num_procs), displs4(num_procs), rcounts4(num_procs), rdispls4(num_procs);
+               for(int p = 0; p < num_procs; p++){
+                  counts4[p] = 4 * send_counts[p];  displs4[p]  = 4 * send_displacements[p];
+                  rcounts4[p] = 4 * recv_counts[p]; rdispls4[p] = 4 * recv_displacements[p];
+               }
+               std::vector<double> coords(4 * send_list.size());
+               for(size_t i = 0; i < send_list.size(); i++){
+                  const int atom = send_list[i];
+                  coords[4*i+0] = x_coord_array[atom];
+                  coords[4*i+1] = y_coord_array[atom];
+                  coords[4*i+2] = z_coord_array[atom];
+                  coords[4*i+3] = mu[atom];
+               }
+               remote_coords.resize(4 * num_recv);
+               MPI_Alltoallv(coords.data(), counts4.data(), displs4.data(), MPI_DOUBLE,
+                             remote_coords.data(), rcounts4.data(), rdispls4.data(), MPI_DOUBLE, MPI_COMM_WORLD);
+
+               // convert counts to spin buffer units
+               for(int p = 0; p < num_procs; p++){
+                  send_counts[p] *= 3; send_displacements[p] *= 3;
+                  recv_counts[p] *= 3; recv_displacements[p] *= 3;
+               }
+               send_buffer.resize(3 * send_list.size());
+               recv_buffer.resize(3 * num_recv);
+
+            #endif
+
+            //------------------------------------------------------------------
+            // Sort local and remote source atoms by leaf
+            //------------------------------------------------------------------
+            const int num_remote = remote_coords.size() / 4;
+            const int num_sources = num_local_atoms + num_remote;
+
+            // remote atoms are within num_near < num_halo leaves of owned leaves and so in window
+            std::vector<int> source_leaf(num_sources);
+            for(int s = 0; s < num_sources; s++){
+               int c[3];
+               if(s < num_local_atoms) leaf_of(x_coord_array[s], y_coord_array[s], z_coord_array[s], c);
+               else leaf_of(remote_coords[4*(s-num_local_atoms)+0], remote_coords[4*(s-num_local_atoms)+1], remote_coords[4*(s-num_local_atoms)+2], c);
+               source_leaf[s] = window_node(0, c[0], c[1], c[2]);
+            }
+
+            leaf_source_start.assign(num_window_leaves + 1, 0);
+            for(int s = 0; s < num_sources; s++) leaf_source_start[source_leaf[s] + 1]++;
+            for(int leaf = 0; leaf < num_window_leaves; leaf++) leaf_source_start[leaf + 1] += leaf_source_start[leaf];
+
+            src_x.resize(num_sources); src_y.resize(num_sources); src_z.resize(num_sources); src_mu.resize(num_sources);
+            src_sx.assign(num_sources, 0.0); src_sy.assign(num_sources, 0.0); src_sz.assign(num_sources, 0.0);
+            src_atom.resize(num_sources);
+            atom_source.resize(num_local_atoms);
+            recv_source.resize(num_remote);
+
+            std::vector<int> next(leaf_source_start.begin(), leaf_source_start.end() - 1);
+            for(int s = 0; s < num_sources; s++){
+               const int index = next[source_leaf[s]]++;
+               if(s < num_local_atoms){
+                  src_x[index] = x_coord_array[s];
+                  src_y[index] = y_coord_array[s];
+                  src_z[index] = z_coord_array[s];
+                  src_mu[index] = mu[s];
+                  src_atom[index] = s;
+                  atom_source[s] = index;
+               }
+               else{
+                  const int i = s - num_local_atoms;
+                  src_x[index] = remote_coords[4*i+0];
+                  src_y[index] = remote_coords[4*i+1];
+                  src_z[index] = remote_coords[4*i+2];
+                  src_mu[index] = remote_coords[4*i+3];
+                  src_atom[index] = -1;
+                  recv_source[i] = index;
+               }
+            }
+
+            //------------------------------------------------------------------
+            // Determine near and far interaction lists for local leaves
+            //------------------------------------------------------------------
+            std::vector<int> local_leaf_id(num_window_leaves, -1);
+            std::vector<int> local_leaf_coords; // leaf coordinates of local leaves [leaf][xyz]
+            local_leaves.clear();
+            atom_leaf.resize(num_local_atoms);
+            for(int atom = 0; atom < num_local_atoms; atom++){
+               const int leaf = source_leaf[atom];
+               if(local_leaf_id[leaf] < 0){
+                  int c[3];
+                  leaf_of(x_coord_array[atom], y_coord_array[atom], z_coord_array[atom], c);
+                  local_leaf_id[leaf] = local_leaves.size();
+                  local_leaves.push_back(leaf);
+                  local_leaf_coords.insert(local_leaf_coords.end(), c, c+3);
+               }
+               atom_leaf[atom] = local_leaf_id[leaf];
+            }
+
+            const double leaf_radius = 0.5 * sqrt(3.0) * box_size;
+
+            near_start.assign(1, 0); near_list.clear();
+            far_start.assign(1, 0);  far_list.clear();
+
+            std::vector<int> stack; // nodes to visit as (level, ix, iy, iz)
+
+            for(size_t ll = 0; ll < local_leaves.size(); ll++){
+
+               const int ax = local_leaf_coords[3*ll+0];
+               const int ay = local_leaf_coords[3*ll+1];
+               const int az = local_leaf_coords[3*ll+2];
+
+               const double* ca = &node_centres[3 * local_leaves[ll]];
+
+               // traverse tree from root, sorting nodes into near field leaves and accepted far field nodes
+               stack.clear();
+               stack.push_back(num_levels - 1); stack.push_back(0); stack.push_back(0); stack.push_back(0);
+               while(!stack.empty()){
+
+                  const int iz = stack.back(); stack.pop_back();
+                  const int iy = stack.back(); stack.pop_back();
+                  const int ix = stack.back(); stack.pop_back();
+                  const int l  = stack.back(); stack.pop_back();
+
+                  const int node = window_node(l, ix, iy, iz);
+                  if(node < 0){
+                     terminaltextcolor(RED);
+                     std::cerr << "Programmer Error - tree node outside window of atomistic multipole solver. Exiting." << std::endl;
+                     terminaltextcolor(WHITE);
+                     zlog << zTs() << "Programmer Error - tree node outside window of atomistic multipole solver. Exiting." << std::endl;
+                     err::vexit();
+                  }
+                  if(node_num_atoms[node] == 0) continue;
+
+                  // check if node overlaps near field leaves
+                  const bool overlap = ( (ix << l) <= ax+1 && ((ix+1) << l) - 1 >= ax-1 &&
+                                         (iy << l) <= ay+1 && ((iy+1) << l) - 1 >= ay-1 &&
+                                         (iz << l) <= az+1 && ((iz+1) << l) - 1 >= az-1 );
+
+                  bool accept = false;
+                  if(!overlap){
+                     const double* c = &node_centres[3 * node];
+                     const double d = sqrt((c[0]-ca[0])*(c[0]-ca[0]) + (c[1]-ca[1])*(c[1]-ca[1]) + (c[2]-ca[2])*(c[2]-ca[2]));
+                     accept = (box_size * double(1 << l) < theta * (d - leaf_radius));
+                  }
+
+                  if(accept) far_list.push_back(node);
+                  else if(l == 0) near_list.push_back(node);
+                  else{
+                     for(int cx = 2*ix; cx <= std::min(2*ix+1, level_nx[l-1]-1); cx++){
+                        for(int cy = 2*iy; cy <= std::min(2*iy+1, level_ny[l-1]-1); cy++){
+                           for(int cz = 2*iz; cz <= std::min(2*iz+1, level_nz[l-1]-1); cz++){
+                              stack.push_back(l-1); stack.push_back(cx); stack.push_back(cy); stack.push_back(cz);
+                           }
+                        }
+                     }
+                  }
+
+               }
+               near_start.push_back(near_list.size());
+               far_start.push_back(far_list.size());
+
+            }
+
+            // memory for window node data (multipoles, centres and number of atoms)
+            const double window_memory = double(num_nodes) * double((num_multipole + 3) * sizeof(double) + sizeof(int)) * 1.0e-6;
+
+            zlog << zTs() << "Atomistic multipole dipole solver: " << num_leaves << " leaf boxes of size " << box_size << " A in " << num_levels << " levels, "
+                 << local_leaves.size() << " local leaves with " << double(far_list.size()) / double(std::max(int(local_leaves.size()), 1))
+                 << " far nodes and " << double(near_list.size()) / double(std::max(int(local_leaves.size()), 1)) << " near leaves per leaf on average, " << num_remote << " remote near field atoms" << std::endl;
+            zlog << zTs() << "\tTree nodes stored on rank " << vmpi::my_rank << ": " << num_nodes << " of " << num_global_nodes << " (" << window_memory << " MB) with halo of " << num_halo << " nodes" << std::endl;
+
+            return;
+
+         }
+
+         //---------------------------------------------------------------------
+         // Function to calculate atomistic dipole field with multipole solver
+         //---------------------------------------------------------------------
+         void update_field_atomistic_fmm(std::vector<double>& x_spin_array, // atomic spin directions
+                                         std::vector<double>& y_spin_array,
+                                         std::vector<double>& z_spin_array){
+
+            const double prefactor = 0.9274009994; // mu_o_4pi * muB / Angstrom^3
+
+            // update local spin moments in source arrays
+            for(int atom = 0; atom < num_local_atoms; atom++){
+               const int s = atom_source[atom];
+               src_sx[s] = x_spin_array[atom] * src_mu[s];
+               src_sy[s] = y_spin_array[atom] * src_mu[s];
+               src_sz[s] = z_spin_array[atom] * src_mu[s];
+            }
+
+            #ifdef MPICF
+               // exchange spins of atoms in neighbouring leaves
+               for(size_t i = 0; i < send_list.size(); i++){
+                  const int s = atom_source[send_list[i]];
+                  send_buffer[3*i+0] = src_sx[s];
+                  send_buffer[3*i+1] = src_sy[s];
+                  send_buffer[3*i+2] = src_sz[s];
+               }
+               MPI_Alltoallv(send_buffer.data(), send_counts.data(), send_displacements.data(), MPI_DOUBLE,
+                             recv_buffer.data(), recv_counts.data(), recv_displacements.data(), MPI_DOUBLE, MPI_COMM_WORLD);
+               for(size_t i = 0; i < recv_source.size(); i++){
+                  const int s = recv_source[i];
+                  src_sx[s] = recv_buffer[3*i+0];
+                  src_sy[s] = recv_buffer[3*i+1];
+                  src_sz[s] = recv_buffer[3*i+2];
+               }
+            #endif
+
+            //------------------------------------------------------------------
+            // Calculate partial multipoles of leaves from local atoms
+            //------------------------------------------------------------------
+            std::fill(node_multipole.begin(), node_multipole.end(), 0.0);
+
+            const int num_local_leaves = local_leaves.size();
+
+            #pragma omp parallel for schedule(static) num_threads(sim::num_threads)
+            for(int ll = 0; ll < num_local_leaves; ll++){
+               const int leaf = local_leaves[ll];
+               const double* c = &node_centres[3 * leaf];
+               double* mpole = &node_multipole[num_multipole * leaf];
+               for(int s = leaf_source_start[leaf]; s < leaf_source_start[leaf+1]; s++){
+                  if(src_atom[s] < 0) continue; // remote atoms are added by their own processor
+                  const double m[3] = { src_sx[s], src_sy[s], src_sz[s] };
+                  const double r[3] = { src_x[s] - c[0], src_y[s] - c[1], src_z[s] - c[2] };
+                  mpole[0] += m[0]; mpole[1] += m[1]; mpole[2] += m[2];
+                  for(int a = 0; a < 3; a++){
+                     for(int b = 0; b < 3; b++) mpole[3 + 3*a + b] += r[a] * m[b];
+                  }
+               }
+            }
+
+            //------------------------------------------------------------------
+            // Translate partial multipoles up the tree to owned node centres
+            //------------------------------------------------------------------
+            for(int l = 1; l < num_levels; l++){
+               const int* omin = &owned_min[3*l];
+               const int* omax = &owned_max[3*l];
+               const int ny = omax[1] - omin[1] + 1;
+               const int nz = omax[2] - omin[2] + 1;
+               const int num_parents = std::max(omax[0] - omin[0] + 1, 0) * ny * nz;
+               #pragma omp parallel for schedule(static) num_threads(sim::num_threads)
+               for(int p = 0; p < num_parents; p++){
+                  const int px = omin[0] + p / (ny * nz);
+                  const int py = omin[1] + (p / nz) % ny;
+                  const int pz = omin[2] + p % nz;
+                  const int parent = window_node(l, px, py, pz);
+                  double* mpole = &node_multipole[num_multipole * parent];
+                  const double* cp = &node_centres[3 * parent];
+                  for(int cx = 2*px; cx <= std::min(2*px+1, level_nx[l-1]-1); cx++){
+                     for(int cy = 2*py; cy <= std::min(2*py+1, level_ny[l-1]-1); cy++){
+                        for(int cz = 2*pz; cz <= std::min(2*pz+1, level_nz[l-1]-1); cz++){
+                           const int child = window_node(l-1, cx, cy, cz);
+                           if(child < 0 || node_num_atoms[child] == 0) continue;
+                           const double* mc = &node_multipole[num_multipole * child];
+                           const double* cc = &node_centres[3 * child];
+                           const double d[3] = { cc[0] - cp[0], cc[1] - cp[1], cc[2] - cp[2] };
+                           mpole[0] += mc[0]; mpole[1] += mc[1]; mpole[2] += mc[2];
+                           for(int a = 0; a < 3; a++){
+                              for(int b = 0; b < 3; b++) mpole[3 + 3*a + b] += mc[3 + 3*a + b] + d[a] * mc[b];
+                           }
+                        }
+                     }
+                  }
+               }
+            }
+
+            // add partial multipoles from all processors to window nodes
+            reduce_windows(node_multipole, num_multipole);
+
+            //------------------------------------------------------------------
+            // Calculate near and far field for all local atoms
+            //------------------------------------------------------------------
+            #pragma omp parallel for schedule(static) num_threads(sim::num_threads)
+            for(int atom = 0; atom < num_local_atoms; atom++){
+
+               const int si = atom_source[atom];
+               const int ll = atom_leaf[atom];
+
+               const double xi = src_x[si];
+               const double yi = src_y[si];
+               const double zi = src_z[si];
+
+               double bx = 0.0;
+               double by = 0.0;
+               double bz = 0.0;
+
+               // exact near field from atoms in neighbouring leaves
+               for(int n = near_start[ll]; n < near_start[ll+1]; n++){
+                  const int leaf = near_list[n];
+                  for(int s = leaf_source_start[leaf]; s < leaf_source_start[leaf+1]; s++){
+
+                     if(s == si) continue;
+
+                     const double rx = src_x[s] - xi;
+                     const double ry = src_y[s] - yi;
+                     const double rz = src_z[s] - zi;
+
+                     const double irij = 1.0/sqrt(rx*rx + ry*ry + rz*rz);
+                     const double ex = rx*irij;
+                     const double ey = ry*irij;
+                     const double ez = rz*irij;
+                     const double irij3 = irij*irij*irij;
+
+                     const double rdotm = ex*src_sx[s] + ey*src_sy[s] + ez*src_sz[s];
+
+                     bx += (3.0*ex*rdotm - src_sx[s]) * irij3;
+                     by += (3.0*ey*rdotm - src_sy[s]) * irij3;
+                     bz += (3.0*ez*rdotm - src_sz[s]) * irij3;
+
+                  }
+               }
+
+               // far field from multipole expansions of accepted nodes
+               for(int f = far_start[ll]; f < far_start[ll+1]; f++){
+
+                  const int node = far_list[f];
+                  const double* c  = &node_centres[3 * node];
+                  const double* mpole = &node_multipole[num_multipole * node];
+                  const double R[3] = { xi - c[0], yi - c[1], zi - c[2] };
+                  const double r2 = R[0]*R[0] + R[1]*R[1] + R[2]*R[2];
+                  const double ir2 = 1.0/r2;
+                  const double ir3 = ir2*sqrt(ir2);
+                  const double ir5 = ir3*ir2;
+
+                  // dipole term T(R).M
+                  const double RdotM = R[0]*mpole[0] + R[1]*mpole[1] + R[2]*mpole[2];
+                  bx += (3.0*R[0]*RdotM*ir2 - mpole[0]) * ir3;
+                  by += (3.0*R[1]*RdotM*ir2 - mpole[1]) * ir3;
+                  bz += (3.0*R[2]*RdotM*ir2 - mpole[2]) * ir3;
+
+                  // first moment term -Q_cb d_c T_ab(R)
+                  const double* Q = &mpole[3];
+                  const double trQ = Q[0] + Q[4] + Q[8];
+                  double QR[3], QtR[3];
+                  for(int a = 0; a < 3; a++){
+                     QR[a]  = Q[3*a+0]*R[0] + Q[3*a+1]*R[1] + Q[3*a+2]*R[2];
+                     QtR[a] = Q[0+a]*R[0] + Q[3+a]*R[1] + Q[6+a]*R[2];
+                  }
+                  const double RQR = R[0]*QR[0] + R[1]*QR[1] + R[2]*QR[2];
+                  bx -= 3.0*ir5*(QR[0] + QtR[0] + R[0]*trQ) - 15.0*ir5*ir2*R[0]*RQR;
+                  by -= 3.0*ir5*(QR[1] + QtR[1] + R[1]*trQ) - 15.0*ir5*ir2*R[1]*RQR;
+                  bz -= 3.0*ir5*(QR[2] + QtR[2] + R[2]*trQ) - 15.0*ir5*ir2*R[2]*RQR;
+
+               }
+
+               // save total dipole field to atomic field array
+               dipole::atom_dipolar_field_array_x[atom] = prefactor * bx;
+               dipole::atom_dipolar_field_array_y[atom] = prefactor * by;
+               dipole::atom_dipolar_field_array_z[atom] = prefactor * bz;
+
+               // without self term the field of point dipoles is also mu_0 Hd (for magnetostatic energy)
+               dipole::atom_mu0demag_field_array_x[atom] = prefactor * bx;
+               dipole::atom_mu0demag_field_array_y[atom] = prefactor * by;
+               dipole::atom_mu0demag_field_array_z[atom] = prefactor * bz;
+
+            }
+
+            return;
+
+         }
+
+      } // end of atomistic_fmm namespace
+
+   } // end of internal namespace
+
+} // end of dipole namespace
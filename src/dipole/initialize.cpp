@@ -20,6 +20,7 @@
 #include "vio.hpp"
 #include "vutil.hpp"
 #include "hierarchical.hpp"
+#include "micromagnetic.hpp"
 
 // dipole module headers
 #include "internal.hpp"
@@ -98,6 +99,7 @@ namespace dipole{
                                                        dipole::internal::cells_num_atoms_in_cell, cells_num_atoms_in_cell_global, cells_index_atoms_array, dipole::internal::cells_volume_array, dipole::internal::cells_pos_and_mom_array,
                                                        cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z,
                                                        dipole::internal::atom_type_array, dipole::internal::atom_cell_id_array, atom_coords_x, atom_coords_y, atom_coords_z, dipole::internal::num_atoms);
+            dipole::internal::initialize_packed_tensor();
             break;
 
          case dipole::internal::tensor:
@@ -109,6 +111,7 @@ namespace dipole{
                                                        dipole::internal::cells_num_atoms_in_cell, cells_num_atoms_in_cell_global, cells_index_atoms_array, dipole::internal::cells_volume_array, dipole::internal::cells_pos_and_mom_array,
                                                        cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z,
                                                        dipole::internal::atom_type_array, dipole::internal::atom_cell_id_array, atom_coords_x, atom_coords_y, atom_coords_z, dipole::internal::num_atoms);
+            dipole::internal::initialize_packed_tensor();
             break;
 
          case dipole::internal::atomistic:
@@ -135,8 +138,31 @@ namespace dipole{
             dipole::internal::atomistic_fft::initialize_atomistic_fft_solver();
             break;
 
+         case dipole::internal::distributedfft:
+            std::cout     << "Initialising dipole field calculation using distributed FFT solver" << std::endl;
+            zlog << zTs() << "Initialising dipole field calculation using distributed FFT solver" << std::endl;
+            dipole::internal::initialize_distributed_fft_solver();
+            break;
+
+         case dipole::internal::atomisticfmm:
+            std::cout     << "Initialising dipole field calculation using atomistic multipole solver" << std::endl;
+            zlog << zTs() << "Initialising dipole field calculation using atomistic multipole solver" << std::endl;
+            dipole::internal::atomistic_fmm::initialize_atomistic_fmm_solver(num_atoms, atom_coords_x, atom_coords_y, atom_coords_z, atom_moments, atom_type_array);
+            break;
+
+
+      }
 
+      // Set up exchange of cell fields between processors for macrocell solvers
+      if(dipole::internal::solver == dipole::internal::macrocell ||
+         dipole::internal::solver == dipole::internal::tensor    ||
+         dipole::internal::solver == dipole::internal::hierarchical){
+         std::vector<int> local_cells(cells::cell_id_array.begin(), cells::cell_id_array.begin()+cells_num_local_cells);
+         std::vector<int> required_cells;
+         if(micromagnetic::discretisation_type != 0) required_cells = micromagnetic::list_of_micromagnetic_cells;
+         dipole::internal::initialize_cell_field_exchange(local_cells, required_cells);
       }
+
       // Set initialised flag
       dipole::internal::initialised=true;
 
@@ -374,6 +400,18 @@ namespace dipole{
 
       }
 
+      // Free unpacked tensors once no longer needed (kept for GPU initialisation)
+      #ifndef CUDA
+         if(dipole::internal::solver == dipole::internal::macrocell || dipole::internal::solver == dipole::internal::tensor){
+            std::vector <std::vector < double > >().swap(dipole::internal::rij_tensor_xx);
+            std::vector <std::vector < double > >().swap(dipole::internal::rij_tensor_xy);
+            std::vector <std::vector < double > >().swap(dipole::internal::rij_tensor_xz);
+            std::vector <std::vector < double > >().swap(dipole::internal::rij_tensor_yy);
+            std::vector <std::vector < double > >().swap(dipole::internal::rij_tensor_yz);
+            std::vector <std::vector < double > >().swap(dipole::internal::rij_tensor_zz);
+         }
+      #endif
+
     	return;
    }
 } // end of dipole namespace
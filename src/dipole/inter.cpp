@@ -37,7 +37,7 @@ namespace dipole{
                                 const double cutoff,                                            // cutoff range for dipole tensor construction (Angstroms)
                                 const std::vector<int>& global_atoms_in_cell_count,             // number of atoms in each cell (all CPUs)
                                 const std::vector<double>& cells_pos_and_mom_array,             // array of positions and cell moments
-                                const std::vector<int>& list_of_cells_with_atoms,               // list of cells to access atoms
+                                const std::vector<int>& cell_with_atoms_index,                  // index of each cell in atoms_in_cells_array (-1 if not local)
                                 const std::vector< std::vector<double> >& atoms_in_cells_array  // output array of positions and moments of atoms in cells
                                 ){
 
@@ -90,14 +90,9 @@ namespace dipole{
             const int num_i_atoms = global_atoms_in_cell_count[celli];
             const int num_j_atoms = global_atoms_in_cell_count[cellj];
 
-            // search for cells i and j in local atom-cells list
-            int cell_with_atoms_index_i = -1;
-            int cell_with_atoms_index_j = -1;
-            for(size_t idx = 0; idx < atoms_in_cells_array.size(); idx++){
-               const int cell = list_of_cells_with_atoms[idx];
-               if( cell == celli ) cell_with_atoms_index_i = idx;
-               if( cell == cellj ) cell_with_atoms_index_j = idx;
-            }
+            // look up cells i and j in local atom-cells list
+            const int cell_with_atoms_index_i = cell_with_atoms_index[celli];
+            const int cell_with_atoms_index_j = cell_with_atoms_index[cellj];
 
             // check that proper cell is found
             if( cell_with_atoms_index_i == -1 ){
@@ -76,6 +76,22 @@ namespace dipole{
             dipole::activated=true;
             return true;
          }
+
+         test="distributed-fft";
+         if(value == test){
+            dipole::internal::solver = dipole::internal::distributedfft;
+            // enable dipole calculation
+            dipole::activated=true;
+            return true;
+         }
+
+         test="atomistic-fmm";
+         if(value == test){
+            dipole::internal::solver = dipole::internal::atomisticfmm;
+            // enable dipole calculation
+            dipole::activated=true;
+            return true;
+         }
          else{
             terminaltextcolor(RED);
             std::cerr << "Error: Value for \'" << prefix << ":" << word << "\' must be one of:" << std::endl;
@@ -94,6 +110,57 @@ namespace dipole{
          return true;
       }
       //-------------------------------------------------------------------
+      test="precision";
+      if(word==test){
+         test="single";
+         if(value == test){
+            dipole::internal::single_precision = true;
+            return true;
+         }
+         test="double";
+         if(value == test){
+            dipole::internal::single_precision = false;
+            return true;
+         }
+         else{
+            terminaltextcolor(RED);
+            std::cerr << "Error: Value for \'" << prefix << ":" << word << "\' must be one of:" << std::endl;
+            std::cerr << "\t\"single\"" << std::endl;
+            std::cerr << "\t\"double\"" << std::endl;
+            terminaltextcolor(WHITE);
+            err::vexit();
+         }
+      }
+      //-------------------------------------------------------------------
+      test="field-update-tolerance";
+      if(word==test){
+         // keep default tolerance if no value given
+         if(value.size() > 0){
+            double tol=atof(value.c_str());
+            vin::check_for_valid_value(tol, word, line, prefix, unit, "", 1.0e-6, 1.0,"input","1.0e-6 - 1.0");
+            dipole::internal::update_tolerance=tol;
+         }
+         // enable adaptive field updates
+         dipole::internal::adaptive_update=true;
+         return true;
+      }
+      //-------------------------------------------------------------------
+      test="minimum-field-update-interval";
+      if(word==test){
+         int interval=atoi(value.c_str());
+         vin::check_for_valid_int(interval, word, line, prefix, 1, 1000000,"input","1 - 1,000,000");
+         dipole::internal::min_update_interval=interval;
+         return true;
+      }
+      //-------------------------------------------------------------------
+      test="maximum-field-update-interval";
+      if(word==test){
+         int interval=atoi(value.c_str());
+         vin::check_for_valid_int(interval, word, line, prefix, 1, 1000000000,"input","1 - 1,000,000,000");
+         dipole::internal::max_update_interval=interval;
+         return true;
+      }
+      //-------------------------------------------------------------------
       test="cutoff-radius";
       if(word==test){
          double dpur=atof(value.c_str());
@@ -101,6 +168,29 @@ namespace dipole{
          dipole::cutoff=dpur;
          return true;
       }
+      test="atomistic-cutoff-radius";
+      if(word==test){
+         double dpur=atof(value.c_str());
+         vin::check_for_valid_value(dpur, word, line, prefix, unit, "length", 1.0, 1.0e4,"input","1 Angstrom - 1 micrometre");
+         dipole::atomistic_cutoff=dpur;
+         return true;
+      }
+      //-------------------------------------------------------------------
+      test="fmm-opening-angle";
+      if(word==test){
+         double theta=atof(value.c_str());
+         vin::check_for_valid_value(theta, word, line, prefix, unit, "", 0.01, 1.0,"input","0.01 - 1.0");
+         dipole::internal::fmm_opening_angle=theta;
+         return true;
+      }
+      //-------------------------------------------------------------------
+      test="tensor-cache";
+      if(word==test){
+         // save calculated dipole tensors and reuse them for identical structures
+         dipole::internal::tensor_cache_enabled = true;
+         return true;
+      }
+      //-------------------------------------------------------------------
       test="atomistic-tensor-enabled";
       if(word==test){
          dipole::atomsitic_tensor_enabled=true;
@@ -18,6 +18,7 @@
 //---------------------------------------------------------------------
 
 // C++ standard library headers
+#include <cstdint>
 #include <vector>
 
 // Vampire headers
@@ -41,6 +42,21 @@ namespace dipole{
       //-------------------------------------------------------------------------
       extern bool initialised;
       extern bool output_atomistic_dipole_field; // flag to toggle output of atomic resolution dipole field
+      extern double fmm_opening_angle; // multipole acceptance parameter for atomistic-fmm solver
+      extern bool tensor_cache_enabled; // flag to save and load dipole tensors from cache files
+      extern bool single_precision; // flag to store dipole tensors and cell magnetisation in single precision
+
+      // adaptive field update scheduling
+      extern bool adaptive_update;          // flag to update field on change in cell magnetisation
+      extern double update_tolerance;       // maximum relative change in cell magnetisation between updates
+      extern uint64_t min_update_interval;  // minimum time steps between updates (and checks)
+      extern uint64_t max_update_interval;  // maximum time steps between updates
+      extern uint64_t last_update_step;     // time step of last adaptive update
+      extern uint64_t num_field_updates;    // number of adaptive field updates
+      extern uint64_t num_update_checks;    // number of checks of cell magnetisation
+      extern std::vector<double> last_mag_array_x; // cell magnetisation at last update
+      extern std::vector<double> last_mag_array_y;
+      extern std::vector<double> last_mag_array_z;
 
       // enumerated list of different dipole solvers
       enum solver_t{
@@ -50,7 +66,9 @@ namespace dipole{
          hierarchical   = 3, // new macrocell with tensor including local corrections and nearfield multipole
          atomistic      = 4, // atomistic dipole dipole (too slow for anything over 1000 atoms)
          fft            = 5, // fft method wit tranlational invariance
-         atomisticfft   = 6   // atomistic dipole dipole with fft
+         atomisticfft   = 6,  // atomistic dipole dipole with fft
+         distributedfft = 7,  // macrocell fft method distributed over processors
+         atomisticfmm   = 8   // atomistic near field with octree multipole far field
       };
       extern std::vector < int > cell_dx;
       extern std::vector < int > cell_dy;
@@ -72,6 +90,25 @@ namespace dipole{
       extern std::vector <std::vector < double > > rij_tensor_yz;
       extern std::vector <std::vector < double > > rij_tensor_zz;
 
+      // packed tensors for non-empty cells [local row][cell][6]
+      extern std::vector <int> packed_cell_array; // list of non-empty cells
+      extern std::vector <int> packed_local_cell_array; // list of non-empty local cells (rows)
+      extern std::vector <double> packed_tensor_array; // tensor rows in symmetric xx xy xz yy yz zz blocks
+      extern std::vector <double> packed_mag_array; // normalised magnetisation of non-empty cells
+      extern std::vector <float> packed_tensor_array_sp; // single precision tensor rows
+      extern std::vector <float> packed_mag_array_sp; // single precision normalised magnetisation
+
+      // lists of cells for exchange of cell fields between processors
+      extern bool cell_field_exchange_needed; // flag to enable exchange of cell fields
+      extern std::vector <int> cell_send_list; // cells sent to other processors
+      extern std::vector <int> cell_send_counts; // number of field components sent to each processor
+      extern std::vector <int> cell_send_displacements;
+      extern std::vector <int> cell_recv_list; // cells received from other processors
+      extern std::vector <int> cell_recv_counts; // number of field components received from each processor
+      extern std::vector <int> cell_recv_displacements;
+      extern std::vector <double> cell_send_buffer; // packed xyz dipole and demag fields
+      extern std::vector <double> cell_recv_buffer;
+
       extern int num_atoms;
       extern std::vector < int > atom_type_array;
       extern std::vector < int > atom_cell_id_array;
@@ -159,15 +196,30 @@ namespace dipole{
          extern unsigned int eight_num_cells;
       #endif
 
-      extern void update_field_fft();
+      extern void update_field_fft(const bool update_magnetisation);
       void initialize_fft_solver();
 
+      void initialize_distributed_fft_solver();
+      void update_field_distributed_fft();
+
       namespace atomistic_fft{
           void initialize_atomistic_fft_solver();
           void update_field_atomistic_fft();
           void finalize_atomistic_fft_solver();
       }
 
+      namespace atomistic_fmm{
+         void initialize_atomistic_fmm_solver(int num_atoms,
+                                              std::vector<double>& x_coord_array,
+                                              std::vector<double>& y_coord_array,
+                                              std::vector<double>& z_coord_array,
+                                              std::vector<double>& moments_array,
+                                              std::vector<int>& mat_id_array);
+         void update_field_atomistic_fmm(std::vector<double>& x_spin_array,
+                                         std::vector<double>& y_spin_array,
+                                         std::vector<double>& z_spin_array);
+      }
+
 
       //-------------------------------------------------------------------------
       // Internal function declarations
@@ -177,6 +229,21 @@ namespace dipole{
       extern void update_field();
 
       void allocate_memory(const int cells_num_local_cells, const int cells_num_cells);
+      void initialize_packed_tensor();
+      bool adaptive_update_required(const uint64_t sim_time);
+
+      uint64_t tensor_cache_hash(const double cutoff,
+                                 const int num_cells,
+                                 const std::vector<int>& local_cell_array,
+                                 const std::vector<int>& num_atoms_in_cell,
+                                 const std::vector<int>& num_atoms_in_cell_global,
+                                 const std::vector<double>& cells_pos_and_mom_array,
+                                 const std::vector<int>& list_of_cells_with_atoms,
+                                 const std::vector< std::vector<double> >& atoms_in_cells_array);
+      bool read_tensor_cache(const uint64_t hash, const int num_local_cells, const int num_cells);
+      void write_tensor_cache(const uint64_t hash, const int num_local_cells, const int num_cells);
+      void initialize_cell_field_exchange(const std::vector<int>& computed_cells, const std::vector<int>& required_cells);
+      void exchange_cell_fields();
 
       void initialize_tensor_solver(const int cells_num_atoms_in_unit_cell,
                                     int cells_num_cells, /// number of macrocells
@@ -205,7 +272,7 @@ namespace dipole{
                                 const double cutoff,                                            // cutoff range for dipole tensor construction (Angstroms)
                                 const std::vector<int>& global_atoms_in_cell_count,             // number of atoms in each cell (all CPUs)
                                 const std::vector<double>& cells_pos_and_mom_array,             // array of positions and cell moments
-                                const std::vector<int>& list_of_cells_with_atoms,               // list of cells to access atoms
+                                const std::vector<int>& cell_with_atoms_index,                  // index of each cell in atoms_in_cells_array (-1 if not local)
                                 const std::vector< std::vector<double> >& atoms_in_cells_array  // output array of positions and moments of atoms in cells
                                );
 
@@ -213,10 +280,14 @@ namespace dipole{
                                 const int cellj,                                                // global ID of cell i
                                 const int lc,                                                   // local cell ID
                                 const std::vector<int>& global_atoms_in_cell_count,             // number of atoms in each cell (all CPUs)
-                                const std::vector<int>& list_of_cells_with_atoms,               // list of cells to access atoms
+                                const std::vector<int>& cell_with_atoms_index,                  // index of each cell in atoms_in_cells_array (-1 if not local)
                                 const std::vector< std::vector<double> >& atoms_in_cells_array  // output array of positions and moments of atoms in cells
                                );
 
+      void compute_intra_tensor(const int num_atoms,                                            // number of atoms in cell
+                                const std::vector<double>& atoms_in_cell,                       // positions and moments of atoms in cell
+                                double* tensor);                                                // output tensor [xx xy xz yy yz zz]
+
       void initialize_macrocell_solver(const int cells_num_atoms_in_unit_cell,
                                        int cells_num_cells, /// number of macrocells
                                        int cells_num_local_cells, /// number of local macrocells
@@ -35,12 +35,48 @@ namespace dipole{
                                 const int cellj,
                                 const int lc,
                                 const std::vector<int>& global_atoms_in_cell_count,             // number of atoms in each cell (all CPUs)
-                                const std::vector<int>& list_of_cells_with_atoms,               // list of cells to access atoms
+                                const std::vector<int>& cell_with_atoms_index,                  // index of each cell in atoms_in_cells_array (-1 if not local)
                                 const std::vector< std::vector<double> >& atoms_in_cells_array  // output array of positions and moments of atoms in cells
                                ){
 
 
-         // Here we start
+         // look up cell i in local atom-cells list
+         const int cell_with_atoms_index_i = cell_with_atoms_index[celli];
+
+         // check that proper cell is found
+         if( cell_with_atoms_index_i == -1 ){
+            std::cerr << "Programmer error! cell " << celli << " is not found in list of local cells with atomic positions!" << std::endl;
+         }
+
+         double tensor[6];
+         compute_intra_tensor(global_atoms_in_cell_count[celli], atoms_in_cells_array[cell_with_atoms_index_i], tensor);
+
+         dipole::internal::rij_tensor_xx[lc][celli] = tensor[0];
+         dipole::internal::rij_tensor_xy[lc][celli] = tensor[1];
+         dipole::internal::rij_tensor_xz[lc][celli] = tensor[2];
+
+         dipole::internal::rij_tensor_yy[lc][celli] = tensor[3];
+         dipole::internal::rij_tensor_yz[lc][celli] = tensor[4];
+         dipole::internal::rij_tensor_zz[lc][celli] = tensor[5];
+
+         // Uncomment in case you want to check the tensor components
+         // std::cout << "\n############# INTRA ###################\n";
+         // std::cout << "lc = " << lc << "\ti = " << celli << std::endl;
+         // std::cout << tensor[0] << "\t" << tensor[1] << "\t" << tensor[2] << "\n";
+         // std::cout << tensor[1] << "\t" << tensor[3] << "\t" << tensor[4] << "\n";
+         // std::cout << tensor[2] << "\t" << tensor[4] << "\t" << tensor[5] << "\n";
+         // std::cout << "\n################################\n";
+         // std::cout << std::endl;
+
+      }  // End of function calculating Intra component of dipole tensor
+
+      //------------------------------------------------------------------------
+      // Function to calculate the intra cell dipole tensor [xx xy xz yy yz zz]
+      // averaged over all pairs of atoms in a cell, given as a list of atomic
+      // positions and moments [x y z mu]
+      //------------------------------------------------------------------------
+      void compute_intra_tensor(const int num_atoms, const std::vector<double>& atoms_in_cell, double* tensor){
+
          // initialise temp vectors
          double tmp_rij_intra_xx = 0.0;
          double tmp_rij_intra_xy = 0.0;
@@ -50,34 +86,19 @@ namespace dipole{
          double tmp_rij_intra_yz = 0.0;
          double tmp_rij_intra_zz = 0.0;
 
-         const int num_atoms = global_atoms_in_cell_count[celli];
-
-         // search for cells i and j in local atom-cells list
-         int cell_with_atoms_index_i = -1;
-         for(size_t idx = 0; idx < atoms_in_cells_array.size(); idx++){
-            const int cell = list_of_cells_with_atoms[idx];
-            if( cell == celli ) cell_with_atoms_index_i = idx;
-         }
-
-         // check that proper cell is found
-         if( cell_with_atoms_index_i == -1 ){
-            std::cerr << "Programmer error! cell " << celli << " is not found in list of local cells with atomic positions!" << std::endl;
-         }
-         const int ci = cell_with_atoms_index_i;
-
          // loop over all atoms in cell i
          for(int pi = 0; pi < num_atoms; pi++){
 
-            const double cix = atoms_in_cells_array[ci][4*pi+0];
-            const double ciy = atoms_in_cells_array[ci][4*pi+1];
-            const double ciz = atoms_in_cells_array[ci][4*pi+2];
+            const double cix = atoms_in_cell[4*pi+0];
+            const double ciy = atoms_in_cell[4*pi+1];
+            const double ciz = atoms_in_cell[4*pi+2];
 
             // loop over all atoms in cell for j < i (do half a full i-j loop)
             for( int qj = 0; qj < pi; qj++){
 
-               const double rx = atoms_in_cells_array[ci][4*qj+0] - cix;
-               const double ry = atoms_in_cells_array[ci][4*qj+1] - ciy;
-               const double rz = atoms_in_cells_array[ci][4*qj+2] - ciz;
+               const double rx = atoms_in_cell[4*qj+0] - cix;
+               const double ry = atoms_in_cell[4*qj+1] - ciy;
+               const double rz = atoms_in_cell[4*qj+2] - ciz;
 
                const double rij = 1.0/sqrt(rx*rx+ry*ry+rz*rz); //Reciprocal of the distance
                const double rij3 = (rij*rij*rij); // Angstroms
@@ -102,24 +123,17 @@ namespace dipole{
          // normalisation factor accounting for i/j interactions (only symmetry of tensor is important)
          const double inorm = 1.0 / ( double(num_atoms) * double(num_atoms) );
 
-         dipole::internal::rij_tensor_xx[lc][celli] =  (tmp_rij_intra_xx) * inorm;
-         dipole::internal::rij_tensor_xy[lc][celli] =  (tmp_rij_intra_xy) * inorm;
-         dipole::internal::rij_tensor_xz[lc][celli] =  (tmp_rij_intra_xz) * inorm;
+         tensor[0] = tmp_rij_intra_xx * inorm;
+         tensor[1] = tmp_rij_intra_xy * inorm;
+         tensor[2] = tmp_rij_intra_xz * inorm;
 
-         dipole::internal::rij_tensor_yy[lc][celli] =  (tmp_rij_intra_yy) * inorm;
-         dipole::internal::rij_tensor_yz[lc][celli] =  (tmp_rij_intra_yz) * inorm;
-         dipole::internal::rij_tensor_zz[lc][celli] =  (tmp_rij_intra_zz) * inorm;
+         tensor[3] = tmp_rij_intra_yy * inorm;
+         tensor[4] = tmp_rij_intra_yz * inorm;
+         tensor[5] = tmp_rij_intra_zz * inorm;
 
-         // Uncomment in case you want to check the tensor components
-         // std::cout << "\n############# INTRA ###################\n";
-         // std::cout << "lc = " << lc << "\ti = " << celli << std::endl;
-         // std::cout << tmp_rij_intra_xx << "\t" << tmp_rij_intra_xy << "\t" << tmp_rij_intra_xz << "\n";
-         // std::cout << tmp_rij_intra_xy << "\t" << tmp_rij_intra_yy << "\t" << tmp_rij_intra_yz << "\n";
-         // std::cout << tmp_rij_intra_xz << "\t" << tmp_rij_intra_yz << "\t" << tmp_rij_intra_zz << "\n";
-         // std::cout << "\n################################\n";
-         // std::cout << std::endl;
+         return;
 
-      }  // End of function calculating Intra component of dipole tensor
+      }
 
    } // End of namespace internal
 } // End of namespace dipole
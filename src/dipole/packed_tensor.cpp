@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2024. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <vector>
+
+// Vampire headers
+#include "cells.hpp"
+#include "dipole.hpp"
+#include "vio.hpp"
+
+// dipole module headers
+#include "internal.hpp"
+
+namespace dipole{
+
+   namespace internal{
+
+      //------------------------------------------------------------------------
+      // Function to copy tensor components for each row in double or single
+      // precision
+      //------------------------------------------------------------------------
+      template <typename T>
+      void pack_tensor_rows(std::vector<T>& packed_tensor, const int64_t num_rows, const int64_t num_cells){
+
+         for(int64_t r = 0; r < num_rows; r++){
+            const int lc = packed_local_cell_array[r];
+            T* row = &packed_tensor[6*r*num_cells];
+            for(int64_t k = 0; k < num_cells; k++){
+               const int j = packed_cell_array[k];
+               row[6*k+0] = rij_tensor_xx[lc][j];
+               row[6*k+1] = rij_tensor_xy[lc][j];
+               row[6*k+2] = rij_tensor_xz[lc][j];
+               row[6*k+3] = rij_tensor_yy[lc][j];
+               row[6*k+4] = rij_tensor_yz[lc][j];
+               row[6*k+5] = rij_tensor_zz[lc][j];
+            }
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to pack dipole tensors into contiguous rows for field update
+      //
+      // Only cells containing atoms contribute to the field, and so the list
+      // of non-empty cells is computed once here. For each non-empty local
+      // cell the six unique components of the symmetric tensor for all
+      // non-empty cells are stored together in a single row
+      //
+      //    [ xx xy xz yy yz zz | xx xy xz yy yz zz | ... ]
+      //
+      // so that the field update streams through one array in order. With
+      // dipole:precision = single the rows are stored as floats, halving the
+      // memory and bandwidth of the update.
+      //------------------------------------------------------------------------
+      void initialize_packed_tensor(){
+
+         // determine list of non-empty cells
+         packed_cell_array.clear();
+         for(int j = 0; j < cells_num_cells; j++){
+            if(cells_num_atoms_in_cell[j] > 0) packed_cell_array.push_back(j);
+         }
+
+         // determine list of non-empty local cells
+         packed_local_cell_array.clear();
+         for(int lc = 0; lc < cells_num_local_cells; lc++){
+            if(cells_num_atoms_in_cell[cells::cell_id_array[lc]] > 0) packed_local_cell_array.push_back(lc);
+         }
+
+         const int64_t num_cells = packed_cell_array.size();
+         const int64_t num_rows  = packed_local_cell_array.size();
+
+         if(single_precision){
+            packed_tensor_array_sp.assign(6*num_rows*num_cells, 0.0f);
+            packed_mag_array_sp.assign(3*num_cells, 0.0f);
+            pack_tensor_rows(packed_tensor_array_sp, num_rows, num_cells);
+         }
+         else{
+            packed_tensor_array.assign(6*num_rows*num_cells, 0.0);
+            packed_mag_array.assign(3*num_cells, 0.0);
+            pack_tensor_rows(packed_tensor_array, num_rows, num_cells);
+         }
+
+         const double bytes = single_precision ? double(packed_tensor_array_sp.size())*sizeof(float) : double(packed_tensor_array.size())*sizeof(double);
+         zlog << zTs() << "Packed dipole tensor for " << num_rows << " local cells and " << num_cells << " non-empty cells (" << bytes/1.0e6 << " MB)" << std::endl;
+
+         return;
+
+      }
+
+   } // end of internal namespace
+
+} // end of dipole namespace
@@ -16,6 +16,7 @@
 #include "cells.hpp" // needed for cells::macrocell_size but to be removed
 #include "dipole.hpp"
 #include "vio.hpp"
+#include "sim.hpp"
 #include "vutil.hpp"
 #include "atoms.hpp" // needed fro m spin array but to be removed
 
@@ -93,9 +94,25 @@ namespace dipole{
             //}
          }
 
+         // determine index of each cell in list of cells with atomic positions
+         std::vector<int> cell_with_atoms_index(cells_num_cells, -1);
+         for(size_t idx = 0; idx < atoms_in_cells_array.size(); idx++) cell_with_atoms_index[list_of_atoms_with_cells[idx]] = idx;
+
+         // check for previously calculated tensors for the same structure
+         uint64_t hash = 0;
+         if(dipole::internal::tensor_cache_enabled){
+            hash = tensor_cache_hash(real_cutoff, cells_num_cells, cells_local_cell_array, cells_num_atoms_in_cell, cells_num_atoms_in_cell_global,
+                                     cells_pos_and_mom_array, list_of_atoms_with_cells, atoms_in_cells_array);
+            if(read_tensor_cache(hash, cells_num_local_cells, cells_num_cells)){
+               std::cout << "Loaded rij matrix for dipole calculation from cache" << std::endl;
+               vmpi::barrier();
+               return;
+            }
+         }
+
          // print informative message to user
          zlog << zTs() << "Precalculating rij matrix for dipole calculation using tensor solver... " << std::endl;
-         std::cout     << "Precalculating rij matrix for dipole calculation using tensor solver"     << std::flush;
+         std::cout     << "Precalculating rij matrix for dipole calculation using tensor solver... "     << std::flush;
 
          // instantiate timer
          vutil::vtimer_t timer;
@@ -107,69 +124,64 @@ namespace dipole{
          // Compute the dipole tensor
          //--------------------------------------------------------------------------------------------
 
-         // loop over local cells
+         // list local cells which contain atoms (if not we don't need the tensor)
+         std::vector<int> rows;
          for( int lc = 0; lc < cells_num_local_cells; lc++){
+            if( cells_num_atoms_in_cell[cells_local_cell_array[lc]] > 0 ) rows.push_back(lc);
+         }
+
+         const int64_t num_pairs = int64_t(rows.size()) * int64_t(cells_num_cells);
 
-            // print out progress to screen
-            if(fmod(ceil(lc),ceil(cells_num_local_cells)/10) == 0) std::cout << "." << std::flush;
+         // loop over all pairs of local and remote cells in parallel (each pair writes a unique tensor element)
+         #pragma omp parallel for schedule(dynamic, 256) num_threads(sim::num_threads)
+         for( int64_t pair = 0; pair < num_pairs; pair++){
+
+            const int lc    = rows[pair / cells_num_cells];
+            const int cellj = pair % cells_num_cells;
 
             // get global cell ID of source cell
-            int celli = cells_local_cell_array[lc];
-
-            // check that local cell contains some local atoms (if not we don't need the tensor)
-            if( cells_num_atoms_in_cell[celli] > 0 ){
-            //std::cout << i << '\t' << "interaction" << "\t"  << cells_num_cells << "\t" << cells_num_atoms_in_cell[i] <<  std::endl;
-
-            	// Loop over all other cells to calculate contribution to local cell
-               for( int cellj = 0; cellj < cells_num_cells; cellj++ ){
-
-                  //--------------------------------------------------------------
-                  // Calculation of inter part of dipolar tensor
-                  //--------------------------------------------------------------
-                  if ( cells_num_atoms_in_cell_global[cellj] > 0 ){ // only calculate interaction if there are atoms in remote cell
-
-                     // check if cell is not the same
-                	   if( celli != cellj ){
-                        // calculate inter term of dipolar tensor
-                        compute_inter_tensor(celli,
-                                             cellj,
-                                             lc,
-                                             real_cutoff,
-                                             cells_num_atoms_in_cell_global,
-                                             cells_pos_and_mom_array,
-                                             list_of_atoms_with_cells,
-                                             atoms_in_cells_array);
-
-                     } // End of Inter part
-
-                     //--------------------------------------------------------------
-                     // Calculation of intra part of dipolar tensor
-                     //--------------------------------------------------------------
-                     else if( celli == cellj ){
-
-                        //Compute inter component of dipolar tensor
-                        compute_intra_tensor(celli,
-                                             cellj,
-                                             lc,
-                                             cells_num_atoms_in_cell_global,
-                                             list_of_atoms_with_cells,
-                                             atoms_in_cells_array);
-
-                     }
-                     // End of Intra part
-
-                     // check for close to zero value tensors and round down to zero
-                     if (dipole::internal::rij_tensor_xx[lc][cellj]*dipole::internal::rij_tensor_xx[lc][cellj] < 1e-15) dipole::internal::rij_tensor_xx[lc][cellj] = 0.0;
-                     if (dipole::internal::rij_tensor_xy[lc][cellj]*dipole::internal::rij_tensor_xy[lc][cellj] < 1e-15) dipole::internal::rij_tensor_xy[lc][cellj] = 0.0;
-                     if (dipole::internal::rij_tensor_xz[lc][cellj]*dipole::internal::rij_tensor_xz[lc][cellj] < 1e-15) dipole::internal::rij_tensor_xz[lc][cellj] = 0.0;
-                     if (dipole::internal::rij_tensor_yy[lc][cellj]*dipole::internal::rij_tensor_yy[lc][cellj] < 1e-15) dipole::internal::rij_tensor_yy[lc][cellj] = 0.0;
-                     if (dipole::internal::rij_tensor_yz[lc][cellj]*dipole::internal::rij_tensor_yz[lc][cellj] < 1e-15) dipole::internal::rij_tensor_yz[lc][cellj] = 0.0;
-                     if (dipole::internal::rij_tensor_zz[lc][cellj]*dipole::internal::rij_tensor_zz[lc][cellj] < 1e-15) dipole::internal::rij_tensor_zz[lc][cellj] = 0.0;
-               //   std::cout << i<< '\t' <<j << '\t' <<   dipole::internal::rij_tensor_xx[lc][j]<< '\t' <<  dipole::internal::rij_tensor_xy[lc][j]<< '\t' <<  dipole::internal::rij_tensor_xz[lc][j]<< '\t' <<  dipole::internal::rij_tensor_yy[lc][j] << '\t' <<  dipole::internal::rij_tensor_yz[lc][j] << '\t' <<  dipole::internal::rij_tensor_zz[lc][j] << std::endl;
-               }
-               }
-   			}
-   		}
+            const int celli = cells_local_cell_array[lc];
+
+            // only calculate interaction if there are atoms in remote cell
+            if ( cells_num_atoms_in_cell_global[cellj] == 0 ) continue;
+
+            //--------------------------------------------------------------
+            // Calculation of inter part of dipolar tensor
+            //--------------------------------------------------------------
+            if( celli != cellj ){
+               compute_inter_tensor(celli,
+                                    cellj,
+                                    lc,
+                                    real_cutoff,
+                                    cells_num_atoms_in_cell_global,
+                                    cells_pos_and_mom_array,
+                                    cell_with_atoms_index,
+                                    atoms_in_cells_array);
+            }
+            //--------------------------------------------------------------
+            // Calculation of intra part of dipolar tensor
+            //--------------------------------------------------------------
+            else{
+               compute_intra_tensor(celli,
+                                    cellj,
+                                    lc,
+                                    cells_num_atoms_in_cell_global,
+                                    cell_with_atoms_index,
+                                    atoms_in_cells_array);
+            }
+
+            // check for close to zero value tensors and round down to zero
+            if (dipole::internal::rij_tensor_xx[lc][cellj]*dipole::internal::rij_tensor_xx[lc][cellj] < 1e-15) dipole::internal::rij_tensor_xx[lc][cellj] = 0.0;
+            if (dipole::internal::rij_tensor_xy[lc][cellj]*dipole::internal::rij_tensor_xy[lc][cellj] < 1e-15) dipole::internal::rij_tensor_xy[lc][cellj] = 0.0;
+            if (dipole::internal::rij_tensor_xz[lc][cellj]*dipole::internal::rij_tensor_xz[lc][cellj] < 1e-15) dipole::internal::rij_tensor_xz[lc][cellj] = 0.0;
+            if (dipole::internal::rij_tensor_yy[lc][cellj]*dipole::internal::rij_tensor_yy[lc][cellj] < 1e-15) dipole::internal::rij_tensor_yy[lc][cellj] = 0.0;
+            if (dipole::internal::rij_tensor_yz[lc][cellj]*dipole::internal::rij_tensor_yz[lc][cellj] < 1e-15) dipole::internal::rij_tensor_yz[lc][cellj] = 0.0;
+            if (dipole::internal::rij_tensor_zz[lc][cellj]*dipole::internal::rij_tensor_zz[lc][cellj] < 1e-15) dipole::internal::rij_tensor_zz[lc][cellj] = 0.0;
+
+         }
+
+         // save tensors for future simulations of the same structure
+         if(dipole::internal::tensor_cache_enabled) write_tensor_cache(hash, cells_num_local_cells, cells_num_cells);
 
          // hold parallel calculation until all processors have completed the dipole calculation
          vmpi::barrier();
@@ -0,0 +1,185 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2024. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+// Vampire headers
+#include "dipole.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// dipole module headers
+#include "internal.hpp"
+
+namespace dipole{
+
+   namespace internal{
+
+      //------------------------------------------------------------------------
+      // Binary cache of dipole tensors
+      //
+      // The tensors for the local cells depend only on the atomic positions
+      // and moments in cells, the cell positions and moments and the cutoff,
+      // and so a hash of these inputs identifies a unique set of tensors. If
+      // enabled, the tensors are saved to a file named by the hash and rank
+      // after they are calculated, and subsequent simulations of the same
+      // structure load them instead of recalculating.
+      //------------------------------------------------------------------------
+      namespace tensor_cache{
+
+         const uint64_t fnv_offset = 14695981039346656037ULL; // 64 bit FNV-1a hash constants
+         const uint64_t fnv_prime  = 1099511628211ULL;
+         const uint64_t version    = 1; // file format version
+
+         //---------------------------------------------------------------------
+         // Functions to add data to FNV-1a hash
+         //---------------------------------------------------------------------
+         inline void add(uint64_t& hash, const void* data, const size_t bytes){
+            const unsigned char* c = static_cast<const unsigned char*>(data);
+            for(size_t i = 0; i < bytes; i++){
+               hash ^= c[i];
+               hash *= fnv_prime;
+            }
+         }
+
+         template <typename T>
+         inline void add(uint64_t& hash, const std::vector<T>& data){
+            const uint64_t size = data.size();
+            add(hash, &size, sizeof(uint64_t));
+            if(size > 0) add(hash, data.data(), size * sizeof(T));
+         }
+
+         //---------------------------------------------------------------------
+         // Function to determine name of cache file
+         //---------------------------------------------------------------------
+         std::string file_name(const uint64_t hash){
+            std::stringstream name;
+            name << "dipole-tensor-" << std::hex << hash << std::dec << "-" << vmpi::my_rank << ".bin";
+            return name.str();
+         }
+
+      } // end of tensor_cache namespace
+
+      namespace tc = tensor_cache;
+
+      //------------------------------------------------------------------------
+      // Function to calculate hash of inputs to dipole tensor calculation
+      //------------------------------------------------------------------------
+      uint64_t tensor_cache_hash(const double cutoff,
+                                 const int num_cells,
+                                 const std::vector<int>& local_cell_array,
+                                 const std::vector<int>& num_atoms_in_cell,
+                                 const std::vector<int>& num_atoms_in_cell_global,
+                                 const std::vector<double>& cells_pos_and_mom_array,
+                                 const std::vector<int>& list_of_cells_with_atoms,
+                                 const std::vector< std::vector<double> >& atoms_in_cells_array){
+
+         uint64_t hash = tc::fnv_offset;
+
+         tc::add(hash, &tc::version, sizeof(uint64_t));
+         tc::add(hash, &cutoff, sizeof(double));
+         tc::add(hash, &num_cells, sizeof(int));
+         tc::add(hash, local_cell_array);
+         tc::add(hash, num_atoms_in_cell);
+         tc::add(hash, num_atoms_in_cell_global);
+         tc::add(hash, cells_pos_and_mom_array);
+         tc::add(hash, list_of_cells_with_atoms);
+         for(size_t i = 0; i < atoms_in_cells_array.size(); i++) tc::add(hash, atoms_in_cells_array[i]);
+
+         return hash;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to load dipole tensors from cache, returning true if found
+      //------------------------------------------------------------------------
+      bool read_tensor_cache(const uint64_t hash, const int num_local_cells, const int num_cells){
+
+         std::ifstream ifile(tc::file_name(hash).c_str(), std::ios::binary);
+         if(!ifile.is_open()) return false;
+
+         // check header matches
+         uint64_t header[4] = {0, 0, 0, 0};
+         ifile.read(reinterpret_cast<char*>(header), sizeof(header));
+         if(!ifile || header[0] != tc::version || header[1] != hash ||
+            header[2] != uint64_t(num_local_cells) || header[3] != uint64_t(num_cells)) return false;
+
+         std::vector < std::vector <double> >* tensors[6] = { &rij_tensor_xx, &rij_tensor_xy, &rij_tensor_xz,
+                                                               &rij_tensor_yy, &rij_tensor_yz, &rij_tensor_zz };
+
+         for(int t = 0; t < 6; t++){
+            for(int lc = 0; lc < num_local_cells; lc++){
+               std::vector<double>& row = (*tensors[t])[lc];
+               if(int(row.size()) != num_cells) return false;
+               ifile.read(reinterpret_cast<char*>(row.data()), num_cells * sizeof(double));
+            }
+         }
+
+         if(!ifile){
+            zlog << zTs() << "Warning - dipole tensor cache file " << tc::file_name(hash) << " is incomplete and will be recalculated" << std::endl;
+            return false;
+         }
+
+         zlog << zTs() << "Loaded dipole tensors from cache file " << tc::file_name(hash) << std::endl;
+
+         return true;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to save dipole tensors to cache
+      //------------------------------------------------------------------------
+      void write_tensor_cache(const uint64_t hash, const int num_local_cells, const int num_cells){
+
+         // write to temporary file and rename so partial files are never read
+         const std::string name = tc::file_name(hash);
+         const std::string tmp_name = name + ".tmp";
+
+         std::ofstream ofile(tmp_name.c_str(), std::ios::binary);
+         if(!ofile.is_open()){
+            zlog << zTs() << "Warning - unable to open dipole tensor cache file " << tmp_name << " for writing" << std::endl;
+            return;
+         }
+
+         const uint64_t header[4] = { tc::version, hash, uint64_t(num_local_cells), uint64_t(num_cells) };
+         ofile.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+         const std::vector < std::vector <double> >* tensors[6] = { &rij_tensor_xx, &rij_tensor_xy, &rij_tensor_xz,
+                                                                     &rij_tensor_yy, &rij_tensor_yz, &rij_tensor_zz };
+
+         for(int t = 0; t < 6; t++){
+            for(int lc = 0; lc < num_local_cells; lc++){
+               ofile.write(reinterpret_cast<const char*>((*tensors[t])[lc].data()), num_cells * sizeof(double));
+            }
+         }
+
+         ofile.close();
+         if(!ofile || std::rename(tmp_name.c_str(), name.c_str()) != 0){
+            zlog << zTs() << "Warning - unable to write dipole tensor cache file " << name << std::endl;
+            std::remove(tmp_name.c_str());
+            return;
+         }
+
+         zlog << zTs() << "Saved dipole tensors to cache file " << name << std::endl;
+
+         return;
+
+      }
+
+   } // end of internal namespace
+
+} // end of dipole namespace
@@ -174,6 +174,18 @@ namespace environment{
                   //calculte chi as a function of temperature
                   env::one_o_chi_para[cell] =  env::calculate_chi_para(temperature,cell);
                   env::one_o_chi_perp[cell] =  env::calculate_chi_perp(temperature,cell);
+                  if(mtrandom::counter_based_noise){
+                     double g[3];
+                     mtrandom::counter_gaussian(mtrandom::environment_stream, cell, g);
+                     GW1x[cell] = g[0];
+                     GW1y[cell] = g[1];
+                     GW1z[cell] = g[2];
+                     mtrandom::counter_gaussian(mtrandom::environment_parallel_stream, cell, g);
+                     GW2x[cell] = g[0];
+                     GW2y[cell] = g[1];
+                     GW2z[cell] = g[2];
+                     continue;
+                  }
                   GW1x[cell] = mtrandom::gaussian();
                   GW1y[cell] = mtrandom::gaussian();
                   GW1z[cell] = mtrandom::gaussian();
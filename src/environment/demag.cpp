@@ -9,8 +9,14 @@
 //
 //------------------------------------------------------------------------------
 //
+// C++ standard library headers
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 // Vampire headers
 #include "environment.hpp"
+#include "dipole.hpp"
 
 // micromagnetic module headers
 #include "internal.hpp"
@@ -26,11 +32,244 @@ namespace environment{
 
    namespace internal{
 
+      //------------------------------------------------------------------------
+      // FFT calculation of environment demagnetisation fields
+      //
+      // When the magnetic environment cells lie on a regular lattice of equal
+      // cells the field at every lattice point is calculated as a zero padded
+      // convolution
+      //
+      //                     H = iFFT[ FFT(N) . FFT(M) ]
+      //
+      // in O(N log N) time and memory, instead of the dense N^2 tensor. Cells
+      // which are not on the lattice (atomistic region cells) are summed
+      // directly over the magnetic cells. Irregular meshes (split or mixed
+      // size cells) and tiny meshes use the dense calculation.
+      //------------------------------------------------------------------------
+      namespace demag_fft{
+
+         #ifdef FFT
+
+            const int minimum_cells = 64; // smaller meshes are faster with dense calculation
+
+            bool enabled = false;
+
+            int n[3];  // size of zero padded FFT grid
+            int nzc;   // number of complex points in z
+
+            double*       M_r; // real space magnetisation [x][y][z][3]
+            double*       H_r; // real space field [x][y][z][3]
+            fftw_complex* M_k; // k-space magnetisation [x][y][z][3]
+            fftw_complex* H_k; // k-space field [x][y][z][3]
+            fftw_complex* N_k; // k-space interaction tensor [x][y][z][xx xy xz yy yz zz]
+
+            fftw_plan plan_M; // forward transform of magnetisation
+            fftw_plan plan_H; // inverse transform of field
+
+            std::vector<int> source_cells; // magnetic environment cells
+            std::vector<int> source_index; // grid point of magnetic cells
+            std::vector<int> target_index; // grid point of each cell or -1 if not on grid
+
+            //---------------------------------------------------------------------
+            // Function to find lattice point of position along one direction,
+            // returning -1 if not on the lattice
+            //---------------------------------------------------------------------
+            inline int lattice_point(const double r, const double r0, const double size, const int num_points){
+               const double f = (r - r0)/size;
+               const int i = static_cast<int>(floor(f + 0.5));
+               if(fabs(f - double(i)) > 1.0e-3 || i < 0 || i >= num_points) return -1;
+               return i;
+            }
+
+            //---------------------------------------------------------------------
+            // Function to initialise FFT calculation, returning false if the
+            // mesh is unsuitable and the dense calculation should be used
+            //---------------------------------------------------------------------
+            bool initialise(){
+
+               // determine magnetic environment cells
+               source_cells.clear();
+               for(int cell = 0; cell < num_cells; cell++){
+                  if(shield_number[cell] != num_shields) source_cells.push_back(cell);
+               }
+
+               const int num_sources = source_cells.size();
+               if(num_sources < minimum_cells) return false;
+
+               // check cells are all the same size
+               const double dx = cell_size_x[source_cells[0]];
+               const double dy = cell_size_y[source_cells[0]];
+               const double dz = cell_size_z[source_cells[0]];
+
+               double min[3] = { cell_coords_array_x[source_cells[0]], cell_coords_array_y[source_cells[0]], cell_coords_array_z[source_cells[0]] };
+               double max[3] = { min[0], min[1], min[2] };
+
+               for(int s = 0; s < num_sources; s++){
+                  const int cell = source_cells[s];
+                  if(fabs(cell_size_x[cell] - dx) > 1.0e-6*dx ||
+                     fabs(cell_size_y[cell] - dy) > 1.0e-6*dy ||
+                     fabs(cell_size_z[cell] - dz) > 1.0e-6*dz) return false;
+                  min[0] = std::min(min[0], cell_coords_array_x[cell]); max[0] = std::max(max[0], cell_coords_array_x[cell]);
+                  min[1] = std::min(min[1], cell_coords_array_y[cell]); max[1] = std::max(max[1], cell_coords_array_y[cell]);
+                  min[2] = std::min(min[2], cell_coords_array_z[cell]); max[2] = std::max(max[2], cell_coords_array_z[cell]);
+               }
+
+               const int num_cells_x = static_cast<int>(floor((max[0] - min[0])/dx + 0.5)) + 1;
+               const int num_cells_y = static_cast<int>(floor((max[1] - min[1])/dy + 0.5)) + 1;
+               const int num_cells_z = static_cast<int>(floor((max[2] - min[2])/dz + 0.5)) + 1;
+
+               // zero pad in all directions
+               n[0] = 2*num_cells_x;
+               n[1] = 2*num_cells_y;
+               n[2] = 2*num_cells_z;
+               nzc  = n[2]/2 + 1;
+
+               const double num_points = double(n[0])*double(n[1])*double(n[2]);
+               const size_t num_k = size_t(n[0])*size_t(n[1])*size_t(nzc);
+
+               // use dense calculation if lattice is sparse
+               if(num_points > double(num_cells)*double(num_cells)) return false;
+
+               // check magnetic cells lie on distinct lattice points
+               std::vector<bool> occupied(size_t(num_points), false);
+               source_index.resize(num_sources);
+               for(int s = 0; s < num_sources; s++){
+                  const int cell = source_cells[s];
+                  const int i = lattice_point(cell_coords_array_x[cell], min[0], dx, num_cells_x);
+                  const int j = lattice_point(cell_coords_array_y[cell], min[1], dy, num_cells_y);
+                  const int k = lattice_point(cell_coords_array_z[cell], min[2], dz, num_cells_z);
+                  if(i < 0 || j < 0 || k < 0) return false;
+                  const int index = (i*n[1] + j)*n[2] + k;
+                  if(occupied[index]) return false;
+                  occupied[index] = true;
+                  source_index[s] = index;
+               }
+
+               // determine grid points of all cells to calculate fields
+               int num_off_grid = 0;
+               target_index.assign(num_cells, -1);
+               for(int cell = 0; cell < num_cells; cell++){
+                  const int i = lattice_point(cell_coords_array_x[cell], min[0], dx, num_cells_x);
+                  const int j = lattice_point(cell_coords_array_y[cell], min[1], dy, num_cells_y);
+                  const int k = lattice_point(cell_coords_array_z[cell], min[2], dz, num_cells_z);
+                  if(i < 0 || j < 0 || k < 0) num_off_grid++;
+                  else target_index[cell] = (i*n[1] + j)*n[2] + k;
+               }
+
+               // allocate arrays
+               M_r = fftw_alloc_real(3*size_t(num_points));
+               H_r = fftw_alloc_real(3*size_t(num_points));
+               M_k = fftw_alloc_complex(3*num_k);
+               H_k = fftw_alloc_complex(3*num_k);
+               N_k = fftw_alloc_complex(6*num_k);
+
+               const double mem = (6.0*num_points*sizeof(double) + 12.0*double(num_k)*sizeof(fftw_complex)) / 1.0e6;
+               std::cout     << "Environment demagnetisation field calculated using FFT on " << n[0] << " x " << n[1] << " x " << n[2] << " grid requiring " << mem << " MB of RAM" << std::endl;
+               zlog << zTs() << "Environment demagnetisation field calculated using FFT on " << n[0] << " x " << n[1] << " x " << n[2] << " grid requiring " << mem << " MB of RAM" << std::endl;
+               zlog << zTs() << "\t" << num_off_grid << " environment cells are not on the FFT grid and are calculated directly" << std::endl;
+
+               // plan transforms of interleaved xyz components
+               plan_M = fftw_plan_many_dft_r2c(3, n, 3, M_r, NULL, 3, 1, M_k, NULL, 3, 1, FFTW_MEASURE);
+               plan_H = fftw_plan_many_dft_c2r(3, n, 3, H_k, NULL, 3, 1, H_r, NULL, 3, 1, FFTW_MEASURE);
+
+               // calculate interaction tensor in units of Tesla for moments in Bohr magnetons,
+               // normalising transform here as FFTW does not
+               double* N_r = fftw_alloc_real(6*size_t(num_points));
+               dipole::calculate_fft_kernel(n[0], n[1], n[2], 0, n[0], n[2], dx, dy, dz, 9.27400915e-01/num_points, N_r);
+
+               fftw_plan plan_N = fftw_plan_many_dft_r2c(3, n, 6, N_r, NULL, 6, 1, N_k, NULL, 6, 1, FFTW_ESTIMATE);
+               fftw_execute(plan_N);
+               fftw_destroy_plan(plan_N);
+               fftw_free(N_r);
+
+               return true;
+
+            }
+
+            //---------------------------------------------------------------------
+            // Function to calculate demagnetisation fields using FFT
+            //---------------------------------------------------------------------
+            void calculate(){
+
+               const double imuB = 1.0/9.27400915e-24;
+               const size_t num_points = size_t(n[0])*size_t(n[1])*size_t(n[2]);
+               const size_t num_k = size_t(n[0])*size_t(n[1])*size_t(nzc);
+               const int num_sources = source_cells.size();
+
+               // set magnetisation on grid (normalised by the Bohr magneton)
+               for(size_t i = 0; i < 3*num_points; i++) M_r[i] = 0.0;
+               for(int s = 0; s < num_sources; s++){
+                  const int cell = source_cells[s];
+                  double* m = &M_r[3*source_index[s]];
+                  m[0] = x_mag_array[cell]*imuB;
+                  m[1] = y_mag_array[cell]*imuB;
+                  m[2] = z_mag_array[cell]*imuB;
+               }
+
+               fftw_execute(plan_M);
+               for(size_t p = 0; p < num_k; p++) dipole::fft_tensor_product(&N_k[6*p][0], &M_k[3*p], &H_k[3*p]);
+               fftw_execute(plan_H);
+
+               for(int cell = 0; cell < num_cells; cell++){
+
+                  // cell on grid
+                  if(target_index[cell] >= 0){
+                     const double* h = &H_r[3*target_index[cell]];
+                     dipole_field_x[cell] = h[0];
+                     dipole_field_y[cell] = h[1];
+                     dipole_field_z[cell] = h[2];
+                     continue;
+                  }
+
+                  // cell not on grid, sum over magnetic cells
+                  double hx = 0.0;
+                  double hy = 0.0;
+                  double hz = 0.0;
+                  for(int s = 0; s < num_sources; s++){
+                     const int cellj = source_cells[s];
+                     const double rx = cell_coords_array_x[cellj] - cell_coords_array_x[cell];
+                     const double ry = cell_coords_array_y[cellj] - cell_coords_array_y[cell];
+                     const double rz = cell_coords_array_z[cellj] - cell_coords_array_z[cell];
+                     const double r2 = rx*rx + ry*ry + rz*rz;
+                     if(r2 < 1.0e-10) continue;
+
+                     const double ir5 = 1.0/(r2*r2*sqrt(r2));
+                     const double mx = x_mag_array[cellj]*imuB;
+                     const double my = y_mag_array[cellj]*imuB;
+                     const double mz = z_mag_array[cellj]*imuB;
+                     const double rm = 3.0*(rx*mx + ry*my + rz*mz);
+
+                     hx += (rm*rx - r2*mx)*ir5;
+                     hy += (rm*ry - r2*my)*ir5;
+                     hz += (rm*rz - r2*mz)*ir5;
+                  }
+
+                  dipole_field_x[cell] = hx*9.27400915e-01;
+                  dipole_field_y[cell] = hy*9.27400915e-01;
+                  dipole_field_z[cell] = hz*9.27400915e-01;
+
+               }
+
+               return;
+
+            }
+
+         #endif
+
+      } // end of demag_fft namespace
+
       int initialise_demag_fields(){
 
 
         std::cout << "initialise demag env " <<std::endl;
 
+        #ifdef FFT
+           demag_fft::enabled = demag_fft::initialise();
+           if(demag_fft::enabled) return 0;
+        #endif
+
+        zlog << zTs() << "Environment demagnetisation field calculated using dense interaction tensor for " << num_cells << " cells" << std::endl;
+
         int num_interactions = num_cells*num_cells;
         rij_tensor_xx.resize(num_interactions,0.0);
         rij_tensor_xy.resize(num_interactions,0.0);
@@ -51,23 +290,20 @@ namespace environment{
                 double rij = sqrt(rx2*rx2+ry2*ry2+rz2*rz2);
                 double rij_1 = 1.0/rij;//Reciprocal of the distance
 
-                  // define unitarian distance vectors
-
                   const double ex = rx2*rij_1;
                   const double ey = ry2*rij_1;
                   const double ez = rz2*rij_1;
 
                   const double rij3 = (rij_1*rij_1*rij_1); // Angstroms
 
-                  // calculate dipolar matrix for 6 entries because of symmetry
                   rij_tensor_xx[interaction_no] = ((3.0*ex*ex - 1.0)*rij3);
                   rij_tensor_xy[interaction_no] = ((3.0*ex*ey      )*rij3);
                   rij_tensor_xz[interaction_no] = ((3.0*ex*ez      )*rij3);
-                  //
+
                   rij_tensor_yy[interaction_no] = ((3.0*ey*ey - 1.0)*rij3);
                   rij_tensor_yz[interaction_no] = ((3.0*ey*ez      )*rij3);
                   rij_tensor_zz[interaction_no] = ((3.0*ez*ez - 1.0)*rij3);
-               //   std::cout << interaction_no << '\t' << cell_i << '\t' << cell_j << rij_tensor_xx[interaction_no] <<  std::endl;
+
                   interaction_no++;
               }
               else if (celli == cellj){
@@ -75,7 +311,7 @@ namespace environment{
                 rij_tensor_xx[interaction_no] = 0.0;
                 rij_tensor_xy[interaction_no] = 0.0;
                 rij_tensor_xz[interaction_no] = 0.0;
-                //
+
                 rij_tensor_yy[interaction_no] = 0.0;
                 rij_tensor_yz[interaction_no] = 0.0;
                 rij_tensor_zz[interaction_no] = 0.0;
@@ -86,189 +322,6 @@ namespace environment{
           }
         }
 
-
-
-         // std::cout << "Initialising dipole fields in environment module..." << std::endl;
-         //
-         // //only complie this section of FFT is enabled else don't
-         // #ifdef FFT
-         // //save eight times number cells and 8 pi/3V to use later.
-         // eight_num_cells = 8*num_cells_x*num_cells_y*num_cells_z;
-         // eightPI_three_cell_volume = 8.0*M_PI/(3.0*cell_volume);
-         //
-         // std::cout << num_cells_x << '\t' << num_cells_y << '\t' << num_cells_z <<std::endl;
-         //
-         // //Resize arrays for fft
-         // N2xx =  (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         // N2xy =  (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         // N2xz =  (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         // N2yx =  (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         // N2yy =  (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         // N2yz =  (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         // N2zx =  (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         // N2zy =  (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         // N2zz =  (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         //
-         // N2xx0 = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         // N2xy0 = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         // N2xz0 = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         // N2yx0 = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         // N2yy0 = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         // N2yz0 = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         // N2zx0 = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         // N2zy0 = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         // N2zz0 = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         //
-         // Mx_in = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         // My_in = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         // Mz_in = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         //
-         // Mx_out = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         // My_out = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         // Mz_out = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         //
-         // Hx_out = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         // Hy_out = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         // Hz_out = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         //
-         // Hx_in = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         // Hy_in = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         // Hz_in = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * eight_num_cells);
-         //
-         //
-         //
-         // //initialises all the demag tensor components to 0
-         // for (int id = 0; id < eight_num_cells; id++){
-         //
-         //
-         //          N2xx0[id][0]=0;
-         //          N2xx0[id][1]=0;
-         //          N2xx[id][0] =0;
-         //          N2xx[id][1] =0;
-         //          N2xy0[id][0]=0;
-         //          N2xy0[id][1]=0;
-         //          N2xy[id][0] =0;
-         //          N2xy[id][1] =0;
-         //          N2xz0[id][0]=0;
-         //          N2xz0[id][1]=0;
-         //
-         //          N2yx0[id][0]=0;
-         //          N2yx0[id][1]=0;
-         //          N2yx[id][0] =0;
-         //          N2yx[id][1] =0;
-         //          N2yy0[id][0]=0;
-         //          N2yy0[id][1]=0;
-         //          N2yy[id][0] =0;
-         //          N2yy[id][1] =0;
-         //          N2yz0[id][0]=0;
-         //          N2yz0[id][1]=0;
-         //
-         //          N2zx0[id][0]=0;
-         //          N2zx0[id][1]=0;
-         //          N2zx[id][0] =0;
-         //          N2zx[id][1] =0;
-         //          N2zy0[id][0]=0;
-         //          N2zy0[id][1]=0;
-         //          N2zy[id][0] =0;
-         //          N2zy[id][1] =0;
-         //          N2zz0[id][0]=0;
-         //          N2zz0[id][1]=0;
-         //       }
-         //
-         //
-         // //initalises all the non-zero demag tensor components as with the normal demag field calcualtion
-         // for(unsigned int k = 0 ; k < 2*num_cells_z ; k++){
-         //    for(unsigned int j = 0 ; j < 2*num_cells_y; j++){
-         //       for(unsigned int i = 0 ; i < 2*num_cells_x ; i++){
-         //          int id = k * 2*num_cells_x*2*num_cells_y + j * 2*num_cells_x + i;
-         //
-         //          int ii,jj,kk;
-         //          if (i >= num_cells_x) ii = i - 2*num_cells_x;
-         //          else ii = i;
-         //          if (j >= num_cells_y) jj = j - 2*num_cells_y;
-         //          else jj = j;
-         //          if (k >= num_cells_z) kk = k - 2*num_cells_z;
-         //          else kk = k;
-         //
-         //           const double rx = ii*cell_size_x[id]; // Angstroms
-         //           const double ry = jj*cell_size_y[id];
-         //           const double rz = kk*cell_size_z[id];
-         //
-         //           const double rij = sqrt(rx*rx + ry*ry + rz*rz);
-         //           if (rij > 0.1){
-         //           const double irij = 1.0/rij;
-         //
-         //           const double ex = rx*irij;
-         //           const double ey = ry*irij;
-         //           const double ez = rz*irij;
-         //
-         //           const double rij3 = irij*irij*irij; // Angstroms
-         //           int id = (2*i*num_cells_y+j)*2*num_cells_z+k;
-         //
-         //           N2xx0[id][0] = (3.0*ex*ex - 1.0)*rij3;
-         //           N2xy0[id][0] = (3.0*ex*ey      )*rij3;
-         //           N2xz0[id][0] = (3.0*ex*ez      )*rij3;
-         //
-         //           N2yx0[id][0] = (3.0*ey*ex      )*rij3;
-         //           N2yy0[id][0] = (3.0*ey*ey - 1.0)*rij3;
-         //           N2yz0[id][0] = (3.0*ey*ez      )*rij3;
-         //
-         //           N2zx0[id][0] = (3.0*ez*ex      )*rij3;
-         //           N2zy0[id][0] = (3.0*ez*ey      )*rij3;
-         //           N2zz0[id][0] = (3.0*ez*ez - 1.0)*rij3;
-         //      //     std::cout << ii << '\t' << jj << '\t' << kk << "\t" << N2xx0[id][0] << '\t' << N2xy0[id][0] << '\t' << N2xz0[id][0] << '\t' << N2yy0[id][0] << '\t' << N2yz0[id][0] << '\t' << N2zz0[id][0] << std::endl;
-         //
-         //          }
-         //       }
-         //     }
-         //   }
-         //
-         // // fft calculations
-         // fftw_plan NxxP,NxyP,NxzP,NyxP,NyyP,NyzP,NzxP,NzyP,NzzP;
-         //
-         // //deterines the forward transform for the demag field arrays from N2xx0 to N2xx arrays
-         // NxxP = fftw_plan_dft_3d(2*num_cells_z,2*num_cells_y,2*num_cells_x, N2xx0,N2xx,FFTW_FORWARD,FFTW_ESTIMATE);
-         // fftw_execute(NxxP);
-         // NyxP = fftw_plan_dft_3d(2*num_cells_z,2*num_cells_y,2*num_cells_x, N2yx0,N2yx,FFTW_FORWARD,FFTW_ESTIMATE);
-         // fftw_execute(NyxP);
-         // NzxP = fftw_plan_dft_3d(2*num_cells_z,2*num_cells_y,2*num_cells_x, N2zx0,N2zx,FFTW_FORWARD,FFTW_ESTIMATE);
-         // fftw_execute(NzxP);
-         // NxyP = fftw_plan_dft_3d(2*num_cells_z,2*num_cells_y,2*num_cells_x, N2xy0,N2xy,FFTW_FORWARD,FFTW_ESTIMATE);
-         // fftw_execute(NxyP);
-         // NyyP = fftw_plan_dft_3d(2*num_cells_z,2*num_cells_y,2*num_cells_x, N2yy0,N2yy,FFTW_FORWARD,FFTW_ESTIMATE);
-         // fftw_execute(NyyP);
-         // NzyP = fftw_plan_dft_3d(2*num_cells_z,2*num_cells_y,2*num_cells_x, N2zy0,N2zy,FFTW_FORWARD,FFTW_ESTIMATE);
-         // fftw_execute(NzyP);
-         // NxzP = fftw_plan_dft_3d(2*num_cells_z,2*num_cells_y,2*num_cells_x, N2xz0,N2xz,FFTW_FORWARD,FFTW_ESTIMATE);
-         // fftw_execute(NxzP);
-         // NyzP = fftw_plan_dft_3d(2*num_cells_z,2*num_cells_y,2*num_cells_x, N2yz0,N2yz,FFTW_FORWARD,FFTW_ESTIMATE);
-         // fftw_execute(NyzP);
-         // NzzP = fftw_plan_dft_3d(2*num_cells_z,2*num_cells_y,2*num_cells_x, N2zz0,N2zz,FFTW_FORWARD,FFTW_ESTIMATE);
-         // fftw_execute(NzzP);
-         //
-         // // free memory from FFTW plans
-         // fftw_destroy_plan(NxxP);
-         // fftw_destroy_plan(NxyP);
-         // fftw_destroy_plan(NxzP);
-         // fftw_destroy_plan(NyxP);
-         // fftw_destroy_plan(NyyP);
-         // fftw_destroy_plan(NyzP);
-         // fftw_destroy_plan(NzxP);
-         // fftw_destroy_plan(NzyP);
-         // fftw_destroy_plan(NzzP);
-         //
-         //
-         // MxP = fftw_plan_dft_3d(2*num_cells_z,2*num_cells_y,2*num_cells_x,Mx_in,Mx_out,FFTW_FORWARD,FFTW_ESTIMATE);
-         // MyP = fftw_plan_dft_3d(2*num_cells_z,2*num_cells_y,2*num_cells_x,My_in,My_out,FFTW_FORWARD,FFTW_ESTIMATE);
-         // MzP = fftw_plan_dft_3d(2*num_cells_z,2*num_cells_y,2*num_cells_x,Mz_in,Mz_out,FFTW_FORWARD,FFTW_ESTIMATE);
-         //
-         // HxP = fftw_plan_dft_3d(2*num_cells_z,2*num_cells_y,2*num_cells_x,Hx_in,Hx_out,FFTW_BACKWARD,FFTW_ESTIMATE);
-         // HyP = fftw_plan_dft_3d(2*num_cells_z,2*num_cells_y,2*num_cells_x,Hy_in,Hy_out,FFTW_BACKWARD,FFTW_ESTIMATE);
-         // HzP = fftw_plan_dft_3d(2*num_cells_z,2*num_cells_y,2*num_cells_x,Hz_in,Hz_out,FFTW_BACKWARD,FFTW_ESTIMATE);
-         //
-         // std::cout << "End of dipole fields initialisation..." << std::endl;
-         //
-         // #endif
          return 0;
 
       }
@@ -282,210 +335,58 @@ namespace environment{
              int num_local_atoms = atoms::num_atoms;
           #endif
 
+         #ifdef FFT
+         if(demag_fft::enabled) demag_fft::calculate();
+         else{
+         #endif
+
         int interaction_no = 0;
            const double imuB = 1.0/9.27400915e-24;
 
-      //  std::cout << "calcualte demag env " <<std::endl;
-
       for(int cell_i = 0; cell_i<num_cells;cell_i++){
 
-        //const double V = cell_volume[cell_i];
-        //const double eightPI_three_cell_volume = 8.0*M_PI/(3.0*V);
-        //double self_demag = eightPI_three_cell_volume;
-        // Normalise cell magnetisation by the Bohr magneton
-
-        //std::cout << cell_i << '\t' << mx_i << '\t' << my_i << '\t' << mz_i << std::endl;
-        //Add self-demagnetisation as mu_0/4_PI * 8PI*m_cell/3V
-        dipole_field_x[cell_i] = 0.0;//self_demag * mx_i*0.0; //*0.0
-        dipole_field_y[cell_i] = 0.0;//self_demag * my_i*0.0; //*0.0
-        dipole_field_z[cell_i] = 0.0;//self_demag * mz_i*0.0; //*0.0
-
+        dipole_field_x[cell_i] = 0.0;
+        dipole_field_y[cell_i] = 0.0;
+        dipole_field_z[cell_i] = 0.0;
 
         for(int cell_j = 0; cell_j<num_cells;cell_j++){
           int shield = shield_number[cell_j];
-          //dont loop over micromagnetic cells to stop double couting - only environment cell_size
-          //mm -> mm calculated in the main micromagnetic module
+
+          // only include magnetic environment cells
           if (shield != num_shields){
              int j = interaction_no;
 
              const double mx = x_mag_array[cell_j]*imuB;
              const double my = y_mag_array[cell_j]*imuB;
              const double mz = z_mag_array[cell_j]*imuB;
-           //std::cout<< cell_i << '\t' << mx_i << '\t' << my_i << '\t' << mz_i << "\t" <<  cell_j << '\t' << mx << '\t' << my << '\t' << mz <<std::endl;
+
              dipole_field_x[cell_i]      +=(mx*rij_tensor_xx[j] + my*rij_tensor_xy[j] + mz*rij_tensor_xz[j]);
              dipole_field_y[cell_i]      +=(mx*rij_tensor_xy[j] + my*rij_tensor_yy[j] + mz*rij_tensor_yz[j]);
              dipole_field_z[cell_i]      +=(mx*rij_tensor_xz[j] + my*rij_tensor_yz[j] + mz*rij_tensor_zz[j]);
-           // Demag field
-            //std::cout << rij_tensor_xx[j] << '\t' << rij_tensor_xy[j] << '\t' << rij_tensor_xz[j] << '\t' << mx << std::endl;
+
             }
             interaction_no ++;
          }
-        //std::cout <<"D\t" << cell_i << '\t' << dipole::cells_field_array_x[cell_i] <<'\t' << dipole::cells_field_array_y[cell_i] <<'\t' << dipole::cells_field_array_z[cell_i] <<std::endl;
 
         dipole_field_x[cell_i] = dipole_field_x[cell_i]*9.27400915e-01;
         dipole_field_y[cell_i] = dipole_field_y[cell_i]*9.27400915e-01;
         dipole_field_z[cell_i] = dipole_field_z[cell_i]*9.27400915e-01;
-    //   std::cout << sim::time << cell_i << '\t' << dipole_field_x[cell_i] << '\t' << dipole_field_y[cell_i] << '\t' << dipole_field_z[cell_i] << '\t' << std::endl;
-      }
-    // std::cout << interaction_no << '\t' << num_cells*num_cells << std::endl;
-    // std::cin.get();
-    // saves the dipole field for each cell to the environment cell for use in the environment module
-      for(int lc=0; lc<cells::num_local_cells; lc++){
-         int cell = cells::cell_id_array[lc];
-         int env_cell = list_env_cell_atomistic_cell[cell];
-         //std::cout << cell << '\t' << env_cell <<std::endl;
-         environment_field_x[cell] = dipole_field_x[env_cell];// + bias_field_x[env_cell];
-         environment_field_y[cell] = dipole_field_y[env_cell];// + bias_field_y[env_cell];
-         environment_field_z[cell] = dipole_field_z[env_cell];//+ bias_field_z[env_cell];
-
-      //  std::cout << cells::pos_and_mom_array[4*cell+0] << '\t' << cells::pos_and_mom_array[4*cell+1] << '\t' << cells::pos_and_mom_array[4*cell+2] << '\t' << environment_field_x[cell] << '\t' << environment_field_y[cell] << '\t' <<environment_field_z[cell] << '\t' << std::endl;
 
       }
-      //  std::cin.get();
-//          #ifdef FFT
-//          //initalise all components of M and H arrays to 0
-//          for (int id = 0; id < eight_num_cells; id++){
-//
-//                   Mx_in[id][0]=0;
-//                   Mx_in[id][1]=0;
-//                   My_in[id][0]=0;
-//                   My_in[id][1]=0;
-//                   Mz_in[id][0]=0;
-//                   Mz_in[id][1]=0;
-//
-//
-//                   Mx_out[id][0]=0;
-//                   Mx_out[id][1]=0;
-//                   My_out[id][0]=0;
-//                   My_out[id][1]=0;
-//                   Mz_out[id][0]=0;
-//                   Mz_out[id][1]=0;
-//
-//
-//                   Hx_in[id][0]=0;
-//                   Hx_in[id][1]=0;
-//                   Hy_in[id][0]=0;
-//                   Hy_in[id][1]=0;
-//                   Hz_in[id][0]=0;
-//                   Hz_in[id][1]=0;
-//
-//
-//                   Hx_out[id][0]=0;
-//                   Hx_out[id][1]=0;
-//                   Hy_out[id][0]=0;
-//                   Hy_out[id][1]=0;
-//                   Hz_out[id][0]=0;
-//                   Hz_out[id][1]=0;
-//                }
-//
-//
-//         // std::ofstream pfile;
-//       //   pfile.open("m.txt");
-//          //initialised the in components for the FT to the magnetisation of each cell
-//          int cell = 0;
-//          const double imuB = 1.0/9.27400915e-24;
-//
-//          for(unsigned int k = 0 ; k < num_cells_z ; k++){
-//             for(unsigned int j = 0 ; j < num_cells_y; j++){
-//                for(unsigned int i = 0 ; i < num_cells_x ; i++){
-//                   int id = k * 2*num_cells_x*2*num_cells_y + j * 2*num_cells_x + i;
-//
-//                   // get cell index
-//                   int cell = k * num_cells_x*num_cells_y + j * num_cells_x + i;
-//
-//                   Mx_in[id][0] = x_mag_array[cell] * imuB;
-//                   My_in[id][0] = y_mag_array[cell] * imuB;
-//                   Mz_in[id][0] = z_mag_array[cell] * imuB;
-//               //    pfile <<i << '\t' << j << '\t' << k << "\t"<< cell << '\t' <<   Mx_in[id][0] << "\t" << My_in[id][0] << "\t" << Mz_in[id][0] << "\t" << std::endl;
-//                 }
-//               }
-//             }
-//
-//
-//          fftw_execute(MxP);
-//          fftw_execute(MyP);
-//          fftw_execute(MzP);
-//
-//
-//          cell = 0;
-//
-//          // performs the converlusion between Nk and Mk
-//          for(unsigned int k = 0 ; k < 2*num_cells_z ; k++){
-//             for(unsigned int j = 0 ; j < 2*num_cells_y; j++){
-//                for(unsigned int i = 0 ; i < 2*num_cells_x ; i++){
-//                  int id = k * 2*num_cells_x*2*num_cells_y + j * 2*num_cells_x + i;
-//
-//                   Hx_in[id][0] = N2xx[id][0]*Mx_out[id][0] + N2xy[id][0]*My_out[id][0] + N2xz[id][0]*Mz_out[id][0]; //summing the real part
-//                   Hx_in[id][0] -= (N2xx[id][1]*Mx_out[id][1] + N2xy[id][1]*My_out[id][1] + N2xz[id][1]*Mz_out[id][1]);
-//
-//                   Hx_in[id][1] = N2xx[id][0]*Mx_out[id][1] + N2xy[id][0]*My_out[id][1] + N2xz[id][0]*Mz_out[id][1];
-//                   Hx_in[id][1] += (N2xx[id][1]*Mx_out[id][0] + N2xy[id][1]*My_out[id][0] + N2xz[id][1]*Mz_out[id][0]);
-//
-//                   Hy_in[id][0] = N2yx[id][0]*Mx_out[id][0] + N2yy[id][0]*My_out[id][0] + N2yz[id][0]*Mz_out[id][0];
-//                   Hy_in[id][0] -= (N2yx[id][1]*Mx_out[id][1] + N2yy[id][1]*My_out[id][1] + N2yz[id][1]*Mz_out[id][1]);
-//
-//                   Hy_in[id][1] = N2yx[id][0]*Mx_out[id][1] + N2yy[id][0]*My_out[id][1] + N2yz[id][0]*Mz_out[id][1];
-//                   Hy_in[id][1] += (N2yx[id][1]*Mx_out[id][0] + N2yy[id][1]*My_out[id][0] + N2yz[id][1]*Mz_out[id][0]);
-//
-//                   Hz_in[id][0] = N2zx[id][0]*Mx_out[id][0] + N2zy[id][0]*My_out[id][0] + N2zz[id][0]*Mz_out[id][0]; //summing the real part
-//                   Hz_in[id][0] -= (N2zx[id][1]*Mx_out[id][1] + N2zy[id][1]*My_out[id][1] + N2zz[id][1]*Mz_out[id][1]);
-//
-//                   Hz_in[id][1] = N2zx[id][0]*Mx_out[id][1] + N2zy[id][0]*My_out[id][1] + N2zz[id][0]*Mz_out[id][1];
-//                   Hz_in[id][1] += (N2zx[id][1]*Mx_out[id][0] + N2zy[id][1]*My_out[id][0] + N2zz[id][1]*Mz_out[id][0]);
-//                   cell++;
-//                }
-//             }
-//          }
-//          fftw_execute(HxP);
-//          fftw_execute(HyP);
-//          fftw_execute(HzP);
-//
-//          double constant = 9.27400915e-01/eight_num_cells;
-//
-//
-//          // for (int i = 0; i< num_cells; i++){
-//          //
-//          //    // Add self-demagnetisation as mu_0/4_PI * 8PI/3V
-//          //    dipole_field_x[i]=0.0;//eightPI_three_cell_volume*(x_mag_array[i]/9.27400915e-24);
-//          //    dipole_field_y[i]=0.0;//eightPI_three_cell_volume*(y_mag_array[i]/9.27400915e-24);
-//          //    dipole_field_z[i]=0.0;//eightPI_three_cell_volume*(z_mag_array[i]/9.27400915e-24);
-//          // }
-//
-//       //   std::ofstream ofile;
-//       //   ofile.open("field.txt");
-//
-//          //sums the dipole field N.m + self demag/eightnumcells
-//          for(unsigned int k = 0 ; k < num_cells_z ; k++){
-//             for(unsigned int j = 0 ; j < num_cells_y; j++){
-//                for(unsigned int i = 0 ; i < num_cells_x ; i++){
-//                   int id = k * 2*num_cells_x*2*num_cells_y + j * 2*num_cells_x + i;
-//
-//
-//                 // get cell index
-//                 int cell = k * num_cells_x*num_cells_y + j * num_cells_x + i;
-//
-//                //   std:: cout << dipole_field_x[cell] << '\t' << dipole_field_y[cell] << '\t' << dipole_field_z[cell] << '\t' << Hx_out[id][0] << '\t' << Hy_out[id][0] << '\t' << Hz_out[id][0] << std::endl;
-//                  dipole_field_x[cell] = Hx_out[id][0]*constant;
-//                  dipole_field_y[cell] = Hy_out[id][0]*constant;
-//                  dipole_field_z[cell] = Hz_out[id][0]*constant;
-//               //   ofile <<i << '\t' << j << '\t' << k << "\t" <<  cell << '\t' << dipole_field_x[cell] << '\t' << dipole_field_y[cell] << '\t' << dipole_field_z[cell] << '\t' << std::endl;
-//                }
-//              }
-//            }
-// //std::cin.get();
-  //  std::ofstream ofile;
-  // ofile.open("field.txt");
-//          //saves the dipole field for each cell to the environment cell for use in the environment module
+
+         #ifdef FFT
+         }
+         #endif
+
+         //saves the dipole field for each cell to the environment cell for use in the environment module
          for(int lc=0; lc<cells::num_local_cells; lc++){
             int cell = cells::cell_id_array[lc];
             int env_cell = list_env_cell_atomistic_cell[cell];
-            //std::cout << cell << '\t' << env_cell <<std::endl;
+
             environment_field_x[cell] = dipole_field_x[env_cell];// + bias_field_x[env_cell];
             environment_field_y[cell] = dipole_field_y[env_cell];// + bias_field_y[env_cell];
             environment_field_z[cell] = dipole_field_z[env_cell];// + bias_field_z[env_cell];
 
-         //   std::cout << cells::pos_and_mom_array[4*cell+0] << '\t' << cells::pos_and_mom_array[4*cell+1] << '\t' << cells::pos_and_mom_array[4*cell+2] << '\t' << environment_field_x[cell] << '\t' << environment_field_y[cell] << '\t' <<environment_field_z[cell] << '\t' << std::endl;
-
          }
          for (int atom =0; atom < num_local_atoms; atom++){
             int cell = cells::atom_cell_id_array[atom];
@@ -209,12 +209,8 @@ namespace environment{
       test="demag-field-update-rate";
       if(word==test){
          int dpur=atoi(value.c_str());
-         vin::check_for_valid_int(dpur, word, line, prefix, 0, 1000000,"input","0 - 1,000,000");
-         #ifdef FFT
+         vin::check_for_valid_int(dpur, word, line, prefix, 1, 1000000,"input","1 - 1,000,000");
          environment::demag_update_rate=dpur;
-         #else
-         std::cout << "FFT not enabled - no demag calculation" <<std::endl;
-         #endif
          return true;
       }
 
@@ -32,6 +32,17 @@ namespace exchange{
    	// energy
    	double energy=0.0;
 
+      // biquadratic exchange merged with bilinear exchange list
+      if(internal::fused_biquadratic){
+         for(int nn = atoms::neighbour_list_start_index[atom]; nn <= atoms::neighbour_list_end_index[atom]; ++nn){
+            const int natom = atoms::neighbour_list_array[nn];
+            const double Jbq = internal::csr_jbq[nn];
+            const double si_dot_sj = sx*atoms::x_spin_array[natom] + sy*atoms::y_spin_array[natom] + sz*atoms::z_spin_array[natom];
+            energy -= Jbq * si_dot_sj * si_dot_sj;
+         }
+         return energy;
+      }
+
    	// Loop over neighbouring spins to calculate exchange
    	for(int nn = internal::biquadratic_neighbour_list_start_index[atom]; nn <= internal::biquadratic_neighbour_list_end_index[atom]; ++nn){
 
@@ -91,4 +102,48 @@ namespace exchange{
 
    }
 
+   //-----------------------------------------------------------------------------------------
+   // Function to calculate bilinear and biquadratic exchange energy for spin atom, using a
+   // single pass over neighbours when the two share the compact neighbour list
+   //-----------------------------------------------------------------------------------------
+   double single_spin_bilinear_biquadratic_energy(const int atom, const double sx, const double sy, const double sz){
+
+      if(!internal::fused_biquadratic){
+         return single_spin_energy(atom, sx, sy, sz) + single_spin_biquadratic_energy(atom, sx, sy, sz);
+      }
+
+      // energies
+      double energy = 0.0;
+      double bq_energy = 0.0;
+
+      // vectorial exchange uses separate constants for each component
+      const bool vectorial = (internal::exchange_type == exchange::vectorial);
+      const double* const jxx = internal::csr_jxx.data();
+      const double* const jyy = vectorial ? internal::csr_jyy.data() : jxx;
+      const double* const jzz = vectorial ? internal::csr_jzz.data() : jxx;
+
+      // Loop over neighbouring spins to calculate exchange
+      for(int nn = atoms::neighbour_list_start_index[atom]; nn <= atoms::neighbour_list_end_index[atom]; ++nn){
+
+         const int natom = atoms::neighbour_list_array[nn];
+
+         // load spin Sj components
+         const double sjx = atoms::x_spin_array[natom];
+         const double sjy = atoms::y_spin_array[natom];
+         const double sjz = atoms::z_spin_array[natom];
+
+         // bilinear exchange
+         if(vectorial) energy -= ( jxx[nn] * sjx * sx + jyy[nn] * sjy * sy + jzz[nn] * sjz * sz );
+         else          energy -= jxx[nn] * (sjx * sx + sjy * sy + sjz * sz);
+
+         // biquadratic exchange
+         const double si_dot_sj = sx*sjx + sy*sjy + sz*sjz;
+         bq_energy -= internal::csr_jbq[nn] * si_dot_sj * si_dot_sj;
+
+      }
+
+      return energy + bq_energy;
+
+   }
+
 } // end of exchange namespace
@@ -103,6 +103,99 @@ namespace internal{
 
 	}
 
+   //-----------------------------------------------------------------------------------------
+   // Function to calculate bilinear and isotropic biquadratic exchange fields for spins
+   // between start and end index in a single pass over the shared compact neighbour list
+   //
+   // Bilinear and biquadratic terms are summed separately and added to the field arrays in
+   // the same order as the separate (scalar) calculations, so results are unchanged.
+   //-----------------------------------------------------------------------------------------
+   void fused_biquadratic_exchange_fields(const int start_index, // first atom for exchange interactions to be calculated
+                                          const int end_index, // last +1 atom to be calculated
+                                          const std::vector<int>& neighbour_list_start_index,
+                                          const std::vector<int>& neighbour_list_end_index,
+                                          const std::vector<int>& neighbour_list_array, // list of interactions between atoms
+                                          const std::vector<double>& spin_array_x, // spin vectors for atoms
+                                          const std::vector<double>& spin_array_y,
+                                          const std::vector<double>& spin_array_z,
+                                          std::vector<double>& field_array_x, // field vectors for atoms
+                                          std::vector<double>& field_array_y,
+                                          std::vector<double>& field_array_z){
+
+      // pointers to neighbour list, inline exchange constants and spin data
+      const int* const    nl_start  = neighbour_list_start_index.data();
+      const int* const    nl_end    = neighbour_list_end_index.data();
+      const int* const    nl        = neighbour_list_array.data();
+      const double* const jxx       = csr_jxx.data();
+      const double* const jbq       = csr_jbq.data();
+      const double* const sx        = spin_array_x.data();
+      const double* const sy        = spin_array_y.data();
+      const double* const sz        = spin_array_z.data();
+
+      // vectorial exchange uses separate constants for each component
+      const bool vectorial = (internal::exchange_type == exchange::vectorial);
+      const double* const jyy = vectorial ? csr_jyy.data() : jxx;
+      const double* const jzz = vectorial ? csr_jzz.data() : jxx;
+
+      // loop over all atoms
+      for(int atom = start_index; atom < end_index; ++atom){
+
+         // temporary variables (registers) to calculate intermediate sums
+         double hx = 0.0;
+         double hy = 0.0;
+         double hz = 0.0;
+
+         double bx = 0.0;
+         double by = 0.0;
+         double bz = 0.0;
+
+         // load spin Si components into temporary contants
+         const double six = sx[atom];
+         const double siy = sy[atom];
+         const double siz = sz[atom];
+
+         // loop over all neighbours (fused list is never compacted by the
+         // lattice stencil, so constants have the same index as neighbours)
+         for(int nn = nl_start[atom]; nn <= nl_end[atom]; ++nn){
+
+            // get neighbouring atom number
+            const int natom = nl[nn];
+
+            // load spin Sj components
+            const double sjx = sx[natom];
+            const double sjy = sy[natom];
+            const double sjz = sz[natom];
+
+            // bilinear exchange
+            hx += jxx[nn] * sjx;
+            hy += jyy[nn] * sjy;
+            hz += jzz[nn] * sjz;
+
+            // biquadratic exchange
+            const double twoJbq = 2.0*jbq[nn];
+            const double si_dot_sj = six*sjx + siy*sjy + siz*sjz;
+
+            bx += twoJbq * sjx*si_dot_sj;
+            by += twoJbq * sjy*si_dot_sj;
+            bz += twoJbq * sjz*si_dot_sj;
+
+         }
+
+         // save total field to field array
+         field_array_x[atom] += hx;
+         field_array_y[atom] += hy;
+         field_array_z[atom] += hz;
+
+         field_array_x[atom] += bx;
+         field_array_y[atom] += by;
+         field_array_z[atom] += bz;
+
+      }
+
+      return;
+
+   }
+
 } // end of internal namespace
 
 } // end of exchange namespace
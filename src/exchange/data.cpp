@@ -55,23 +55,47 @@ namespace exchange{
       bool use_material_exchange_constants = true; // flag to enable material exchange parameters
       bool use_material_biquadratic_exchange_constants = true; // flag to enable material biquadratic exchange parameters
 
-      std::vector <int> four_spin_neighbour_list_array_i; // 1D list of j neighbours
-      std::vector <int> four_spin_neighbour_list_array_j; // 1D list of j neighbours
-      std::vector <int> four_spin_neighbour_list_array_k; // 1D list of k neighnours
-      std::vector <int> four_spin_neighbour_list_array_l; // 1D list of l neighbours
-      std::vector <int> four_spin_neighbour_list_start_index; // list of first four spin neighbour for atom i
-      std::vector <int> four_spin_neighbour_list_end_index;   // list of last four spin neighbours for atom i
-      std::vector <double> four_spin_exchange_list;   // value of four_spin
+      std::vector <int> four_spin_start_index;     // offset of first quadruplet for central atom i (num_atoms+1)
+      std::vector <int> four_spin_neighbour_array; // j, k and l atoms of each quadruplet grouped by central atom
+      std::vector <double> four_spin_exchange_list; // value of four spin constant for each quadruplet
 
       std::vector <int> biquadratic_neighbour_list_array; // 1D list of biquadratic neighbours
       std::vector <int> biquadratic_neighbour_interaction_type_array; // 1D list of biquadratic exchange interaction types
       std::vector <int> biquadratic_neighbour_list_start_index; // list of first biquadratic neighbour for atom i
       std::vector <int> biquadratic_neighbour_list_end_index;   // list of last biquadratic neighbour for atom i
 
+      std::vector <int> csr_start_index;       // offset of inline exchange constants of first neighbour for atom i (num_atoms+1)
+      std::vector <uint16_t> csr_tensor_id_16; // index of unique tensor for each pair (tensorial exchange, < 65536 tensors)
+      std::vector <uint32_t> csr_tensor_id_32; // index of unique tensor for each pair (tensorial exchange, otherwise)
+      std::vector <double> csr_jxx; // inline exchange constants for each pair (isotropic uses xx only)
+      std::vector <double> csr_jyy;
+      std::vector <double> csr_jzz;
+
+      bool fused_biquadratic = false;      // flag set when biquadratic exchange shares the bilinear compact list
+      std::vector <double> csr_jbq; // inline isotropic biquadratic exchange constants for each pair of fused list
+
       std::vector <exchange::internal::value_t  > bq_i_exchange_list(0); // list of isotropic biquadratic exchange constants
       std::vector <exchange::internal::vector_t > bq_v_exchange_list(0); // list of vectorial biquadratic exchange constants
       std::vector <exchange::internal::tensor_t > bq_t_exchange_list(0); // list of tensorial biquadratic exchange constants
 
+      bool lattice_stencil = false; // flag to enable lattice stencil form of exchange list
+      bool stencil_active = false;  // flag set when atoms use the lattice stencil
+      int stencil_site_bits = 0;    // number of bits for unit cell site in stencil grid index
+      int stencil_dims[3] = {0,0,0}; // number of unit cells in local stencil grid
+      std::vector <int> stencil_start;  // first stencil interaction for each unit cell site (num_sites+1)
+      std::vector <int> stencil_dx;     // unit cell offsets for each stencil interaction
+      std::vector <int> stencil_dy;
+      std::vector <int> stencil_dz;
+      std::vector <int> stencil_site;   // unit cell site of neighbour for each stencil interaction
+      int stencil_count_bits = 0;       // number of bits for number of interactions in encoded offset pattern
+      std::vector <int> stencil_offset; // offset in atom number of neighbour for each entry in offset patterns
+      std::vector <double> stencil_jxx; // exchange constants for each stencil interaction, followed by offset patterns
+      std::vector <double> stencil_jyy;
+      std::vector <double> stencil_jzz;
+      std::vector <uint32_t> stencil_tensor_id; // index of unique tensor for each stencil interaction, followed by offset patterns
+      std::vector <int> stencil_index_array; // encoded offset pattern (or -2-stencil grid index) for each atom, or -1 for explicit neighbour list
+      std::vector <int> stencil_atom_map;    // atom at each stencil grid point, or -1 if missing
+
    } // end of internal namespace
 
 } // end of exchange namespace
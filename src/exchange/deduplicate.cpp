@@ -0,0 +1,116 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2024. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+// Vampire headers
+#include "atoms.hpp"
+#include "exchange.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// exchange module headers
+#include "internal.hpp"
+
+namespace exchange{
+
+   namespace internal{
+
+   //----------------------------------------------------------------------------
+   // Key for hashing of exchange tensors using the bit pattern of each element
+   //----------------------------------------------------------------------------
+   struct tensor_key_t{
+
+      uint64_t bits[9];
+
+      explicit tensor_key_t(const zten_t& tensor){
+         std::memcpy(bits, tensor.Jij, sizeof(bits));
+      }
+
+      bool operator==(const tensor_key_t& other) const{
+         return std::memcmp(bits, other.bits, sizeof(bits)) == 0;
+      }
+
+   };
+
+   struct tensor_hash_t{
+
+      size_t operator()(const tensor_key_t& key) const{
+         // FNV-1a style combination of element bit patterns
+         uint64_t hash = 14695981039346656037ULL;
+         for(int i = 0; i < 9; i++){
+            hash ^= key.bits[i] ^ (key.bits[i] >> 29);
+            hash *= 1099511628211ULL;
+         }
+         return size_t(hash);
+      }
+
+   };
+
+   //----------------------------------------------------------------------------
+   // Function to remove duplicate tensors from the tensorial exchange list
+   //
+   // With DMI or Kitaev interactions the exchange list is unrolled to a full
+   // tensor for every neighbour pair, although in a crystal most of these are
+   // identical. Tensors are hashed by their exact bit patterns into a table of
+   // unique tensors and the interaction type of each pair is set to its index
+   // in the table, so that results are unchanged. Must be called after
+   // calculation of DMI/Kitaev terms and before generating the CSR list.
+   //----------------------------------------------------------------------------
+   void deduplicate_tensorial_exchange(){
+
+      const size_t num_tensors = atoms::t_exchange_list.size();
+      const size_t num_interactions = atoms::neighbour_interaction_type_array.size();
+
+      std::unordered_map<tensor_key_t, int, tensor_hash_t> table;
+      table.reserve(64);
+
+      std::vector<zten_t> unique_list;
+
+      // map each tensor in the old list to its index in the unique list
+      std::vector<int> unique_id(num_tensors);
+      for(size_t i = 0; i < num_tensors; i++){
+         const tensor_key_t key(atoms::t_exchange_list[i]);
+         std::unordered_map<tensor_key_t, int, tensor_hash_t>::iterator it = table.find(key);
+         if(it == table.end()){
+            const int id = unique_list.size();
+            table.insert(std::make_pair(key, id));
+            unique_list.push_back(atoms::t_exchange_list[i]);
+            unique_id[i] = id;
+         }
+         else unique_id[i] = it->second;
+      }
+
+      // relabel interaction types of all pairs
+      for(size_t nn = 0; nn < num_interactions; nn++){
+         atoms::neighbour_interaction_type_array[nn] = unique_id[ atoms::neighbour_interaction_type_array[nn] ];
+      }
+
+      // replace exchange list with unique tensors, releasing memory
+      atoms::t_exchange_list.swap(unique_list);
+      std::vector<zten_t>().swap(unique_list);
+
+      zlog << zTs() << "Reduced tensorial exchange list from " << num_tensors << " to " << atoms::t_exchange_list.size()
+           << " unique tensors on rank " << vmpi::my_rank << " (" << double(num_tensors - atoms::t_exchange_list.size())*double(sizeof(zten_t))*1.0e-6
+           << " MB RAM saved)" << std::endl;
+
+      return;
+
+   }
+
+   } // end of internal namespace
+
+} // end of exchange namespace
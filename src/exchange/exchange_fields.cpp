@@ -11,12 +11,15 @@
 //
 
 // C++ standard library headers
+#include <cstdint>
+#if (defined(__AVX2__) && defined(__FMA__)) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
 
 // Vampire headers
-//#include "atoms.hpp" // for exchange list type defs
+#include "atoms.hpp" // for exchange list type defs
 #include "exchange.hpp"
-#include "dipole.hpp"
-#include <iostream>
+
 // exchange module headers
 #include "internal.hpp"
 
@@ -24,19 +27,185 @@ namespace exchange{
 
 namespace internal{
 
+#if defined(__AVX512F__)
+   //-----------------------------------------------------------------------------
+   // Functions to load 8 unique tensor ids as offsets of the first element of
+   // each tensor (9 doubles) in the table of unique tensors
+   //-----------------------------------------------------------------------------
+   static inline __m256i tensor_offsets(const uint16_t* const id){
+      return _mm256_mullo_epi32(_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(id))), _mm256_set1_epi32(9));
+   }
+   static inline __m256i tensor_offsets(const uint32_t* const id){
+      return _mm256_mullo_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(id)), _mm256_set1_epi32(9));
+   }
+#elif defined(__AVX2__) && defined(__FMA__)
+   //-----------------------------------------------------------------------------
+   // Function to sum the elements of an AVX register
+   //-----------------------------------------------------------------------------
+   static inline double horizontal_sum(const __m256d v){
+      __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+      sum = _mm_add_sd(sum, _mm_unpackhi_pd(sum, sum));
+      return _mm_cvtsd_f64(sum);
+   }
+
+   //-----------------------------------------------------------------------------
+   // Functions to load 4 unique tensor ids as offsets of the first element of
+   // each tensor (9 doubles) in the table of unique tensors
+   //-----------------------------------------------------------------------------
+   static inline __m128i tensor_offsets(const uint16_t* const id){
+      return _mm_mullo_epi32(_mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(id))), _mm_set1_epi32(9));
+   }
+   static inline __m128i tensor_offsets(const uint32_t* const id){
+      return _mm_mullo_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(id)), _mm_set1_epi32(9));
+   }
+#endif
+
+   //-----------------------------------------------------------------------------
+   // Function to calculate tensorial exchange fields from the compact list, with
+   // each pair storing an index (of type T) into the table of unique tensors.
+   // The vectorised form gathers the nine components of each tensor using 32-bit
+   // offsets, which limits the table to 2^31/9 unique tensors.
+   //-----------------------------------------------------------------------------
+   template <typename T>
+   static void tensorial_exchange_fields(const int start_index, const int end_index,
+                                         const int* const nl_start, const int* const nl,
+                                         const int* const csr_start, const T* const csr_tid,
+                                         const double* const sx, const double* const sy, const double* const sz,
+                                         std::vector<double>& field_array_x,
+                                         std::vector<double>& field_array_y,
+                                         std::vector<double>& field_array_z){
+
+      const zten_t* const t_exchange_list = atoms::t_exchange_list.data();
+      #if defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))
+         const double* const J = &t_exchange_list[0].Jij[0][0];
+      #endif
+
+      // loop over all atoms
+      for(int atom = start_index; atom < end_index; ++atom){
+
+         // temporary variables (registers) to calculate intermediate sum
+         double hx = 0.0;
+         double hy = 0.0;
+         double hz = 0.0;
+
+         // atoms in perfect lattice use unit cell stencil
+         if(stencil_active && stencil_index_array[atom] != -1){
+            const uint32_t* const tid = stencil_tensor_id.data();
+            for_each_stencil_neighbour(atom, stencil_index_array[atom], [&](const int k, const int natom){
+               const zten_t& J = t_exchange_list[ tid[k] ];
+               const double S[3]={sx[natom], sy[natom], sz[natom]};
+               hx += ( J.Jij[0][0] * S[0] + J.Jij[0][1] * S[1] + J.Jij[0][2] * S[2]);
+               hy += ( J.Jij[1][0] * S[0] + J.Jij[1][1] * S[1] + J.Jij[1][2] * S[2]);
+               hz += ( J.Jij[2][0] * S[0] + J.Jij[2][1] * S[1] + J.Jij[2][2] * S[2]);
+            });
+            field_array_x[atom] += hx;
+            field_array_y[atom] += hy;
+            field_array_z[atom] += hz;
+            continue;
+         }
+
+         // temporary constants for loop start and end indices
+         const int start = nl_start[atom];
+         const int end   = start + csr_start[atom+1] - csr_start[atom];
+
+         int nn = start;
+
+         // unique tensor ids for neighbours of atom
+         const T* const tid = csr_tid + (csr_start[atom] - start);
+
+         #if defined(__AVX512F__)
+            // vectorised loop over neighbours in blocks of 8
+            __m512d vhx = _mm512_setzero_pd();
+            __m512d vhy = _mm512_setzero_pd();
+            __m512d vhz = _mm512_setzero_pd();
+            for(; nn + 8 <= end; nn += 8){
+               const __m256i natoms = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(nl + nn));
+               const __m256i jid    = tensor_offsets(tid + nn);
+               const __m512d Sx = _mm512_i32gather_pd(natoms, sx, 8);
+               const __m512d Sy = _mm512_i32gather_pd(natoms, sy, 8);
+               const __m512d Sz = _mm512_i32gather_pd(natoms, sz, 8);
+               vhx = _mm512_fmadd_pd(_mm512_i32gather_pd(jid, J+0, 8), Sx, vhx);
+               vhx = _mm512_fmadd_pd(_mm512_i32gather_pd(jid, J+1, 8), Sy, vhx);
+               vhx = _mm512_fmadd_pd(_mm512_i32gather_pd(jid, J+2, 8), Sz, vhx);
+               vhy = _mm512_fmadd_pd(_mm512_i32gather_pd(jid, J+3, 8), Sx, vhy);
+               vhy = _mm512_fmadd_pd(_mm512_i32gather_pd(jid, J+4, 8), Sy, vhy);
+               vhy = _mm512_fmadd_pd(_mm512_i32gather_pd(jid, J+5, 8), Sz, vhy);
+               vhz = _mm512_fmadd_pd(_mm512_i32gather_pd(jid, J+6, 8), Sx, vhz);
+               vhz = _mm512_fmadd_pd(_mm512_i32gather_pd(jid, J+7, 8), Sy, vhz);
+               vhz = _mm512_fmadd_pd(_mm512_i32gather_pd(jid, J+8, 8), Sz, vhz);
+            }
+            hx = _mm512_reduce_add_pd(vhx);
+            hy = _mm512_reduce_add_pd(vhy);
+            hz = _mm512_reduce_add_pd(vhz);
+         #elif defined(__AVX2__) && defined(__FMA__)
+            // vectorised loop over neighbours in blocks of 4
+            __m256d vhx = _mm256_setzero_pd();
+            __m256d vhy = _mm256_setzero_pd();
+            __m256d vhz = _mm256_setzero_pd();
+            for(; nn + 4 <= end; nn += 4){
+               const __m128i natoms = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nl + nn));
+               const __m128i jid    = tensor_offsets(tid + nn);
+               const __m256d Sx = _mm256_i32gather_pd(sx, natoms, 8);
+               const __m256d Sy = _mm256_i32gather_pd(sy, natoms, 8);
+               const __m256d Sz = _mm256_i32gather_pd(sz, natoms, 8);
+               vhx = _mm256_fmadd_pd(_mm256_i32gather_pd(J+0, jid, 8), Sx, vhx);
+               vhx = _mm256_fmadd_pd(_mm256_i32gather_pd(J+1, jid, 8), Sy, vhx);
+               vhx = _mm256_fmadd_pd(_mm256_i32gather_pd(J+2, jid, 8), Sz, vhx);
+               vhy = _mm256_fmadd_pd(_mm256_i32gather_pd(J+3, jid, 8), Sx, vhy);
+               vhy = _mm256_fmadd_pd(_mm256_i32gather_pd(J+4, jid, 8), Sy, vhy);
+               vhy = _mm256_fmadd_pd(_mm256_i32gather_pd(J+5, jid, 8), Sz, vhy);
+               vhz = _mm256_fmadd_pd(_mm256_i32gather_pd(J+6, jid, 8), Sx, vhz);
+               vhz = _mm256_fmadd_pd(_mm256_i32gather_pd(J+7, jid, 8), Sy, vhz);
+               vhz = _mm256_fmadd_pd(_mm256_i32gather_pd(J+8, jid, 8), Sz, vhz);
+            }
+            hx = horizontal_sum(vhx);
+            hy = horizontal_sum(vhy);
+            hz = horizontal_sum(vhz);
+         #endif
+
+         // loop over all (remaining) neighbours
+         for(; nn < end; ++nn){
+
+            const int natom = nl[nn]; // get neighbouring atom number
+            const zten_t& J = t_exchange_list[ tid[nn] ]; // interaction tensor
+
+            const double S[3]={sx[natom], sy[natom], sz[natom]};
+
+            hx += ( J.Jij[0][0] * S[0] + J.Jij[0][1] * S[1] + J.Jij[0][2] * S[2]);
+            hy += ( J.Jij[1][0] * S[0] + J.Jij[1][1] * S[1] + J.Jij[1][2] * S[2]);
+            hz += ( J.Jij[2][0] * S[0] + J.Jij[2][1] * S[1] + J.Jij[2][2] * S[2]);
+         }
+
+         field_array_x[atom] += hx; // save total field to field array
+         field_array_y[atom] += hy;
+         field_array_z[atom] += hz;
+
+      }
+
+      return;
+
+   }
+
    //-----------------------------------------------------------------------------
    // Function to calculate exchange fields for spins between start and end index
+   //
+   // Neighbours are read from the 1D neighbour list starting at
+   // neighbour_list_start_index for each atom, with exchange constants stored
+   // inline for each pair starting at csr_start_index (num_atoms+1 offsets, the
+   // difference of which gives the number of neighbours), or from the unit cell
+   // stencil for atoms in the perfect lattice. The two offsets differ once the
+   // inline constants of stencil atoms are removed, as the neighbour list itself
+   // is still needed by other modules.
+   // When compiled with AVX2 and FMA or AVX-512 support the isotropic, vectorial
+   // and tensorial exchange are calculated using explicit gathers of the
+   // neighbour spins (and tensors) with fused multiply-adds, with the remainder
+   // of each neighbour list added in scalar form.
+   // Otherwise the summation order is the same as the simple 1D list.
    //-----------------------------------------------------------------------------
    void exchange_fields(const int start_index, // first atom for exchange interactions to be calculated
                         const int end_index, // last +1 atom to be calculated
                         const std::vector<int>& neighbour_list_start_index,
-                        const std::vector<int>& neighbour_list_end_index,
-                        const std::vector<int>& type_array, // type for atom
                         const std::vector<int>& neighbour_list_array, // list of interactions between atoms
-                        const std::vector<int>& neighbour_interaction_type_array, // list of interaction type for each pair of atoms with value given in exchange list
-                        const std::vector <zval_t>& i_exchange_list, // list of isotropic exchange constants
-                        const std::vector <zvec_t>& v_exchange_list, // list of vectorial exchange constants
-                        const std::vector <zten_t>& t_exchange_list, // list of tensorial exchange constants
                         const std::vector<double>& spin_array_x, // spin vectors for atoms
                         const std::vector<double>& spin_array_y,
                         const std::vector<double>& spin_array_z,
@@ -44,10 +213,20 @@ namespace internal{
                         std::vector<double>& field_array_y,
                         std::vector<double>& field_array_z){
 
+      // pointers to neighbour list, inline exchange constant offsets and spin data
+      const int* const    nl_start  = neighbour_list_start_index.data();
+      const int* const    nl        = neighbour_list_array.data();
+      const int* const    csr_start = csr_start_index.data();
+      const double* const sx        = spin_array_x.data();
+      const double* const sy        = spin_array_y.data();
+      const double* const sz        = spin_array_z.data();
+
    	// Use appropriate function for exchange calculation
    	switch(internal::exchange_type){
 
-   		case exchange::isotropic:
+   		case exchange::isotropic:{
+
+            const double* const jxx = csr_jxx.data();
 
             // loop over all atoms
    			for(int atom = start_index; atom < end_index; ++atom){
@@ -57,19 +236,69 @@ namespace internal{
    				double hy = 0.0;
    				double hz = 0.0;
 
-               // temporray constants for loop start and end indices
-   				const int start = neighbour_list_start_index[atom];
-   				const int end   = neighbour_list_end_index[atom]+1;
-
-               // loop over all neighbours
-   				for(int nn = start; nn < end; ++nn){
-
-   					const int natom = neighbour_list_array[nn]; // get neighbouring atom number
-   					const double Jij = i_exchange_list[ neighbour_interaction_type_array[nn] ].Jij; // get exchange constant between atoms
-
-   					hx += Jij * spin_array_x[natom]; // add exchange fields
-   					hy += Jij * spin_array_y[natom];
-   					hz += Jij * spin_array_z[natom];
+               // atoms in perfect lattice use unit cell stencil
+               if(stencil_active && stencil_index_array[atom] != -1){
+                  const double* const sjxx = stencil_jxx.data();
+                  for_each_stencil_neighbour(atom, stencil_index_array[atom], [&](const int k, const int natom){
+                     hx += sjxx[k] * sx[natom];
+                     hy += sjxx[k] * sy[natom];
+                     hz += sjxx[k] * sz[natom];
+                  });
+                  field_array_x[atom] += hx;
+                  field_array_y[atom] += hy;
+                  field_array_z[atom] += hz;
+                  continue;
+               }
+
+               // temporary constants for loop start and end indices
+   				const int start = nl_start[atom];
+   				const int end   = start + csr_start[atom+1] - csr_start[atom];
+               int nn = start;
+
+               // exchange constants for neighbours of atom
+               const double* const Jxx = jxx + (csr_start[atom] - start);
+
+               #if defined(__AVX512F__)
+                  // vectorised loop over neighbours in blocks of 8
+                  __m512d vhx = _mm512_setzero_pd();
+                  __m512d vhy = _mm512_setzero_pd();
+                  __m512d vhz = _mm512_setzero_pd();
+                  for(; nn + 8 <= end; nn += 8){
+                     const __m256i natoms = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(nl + nn));
+                     const __m512d Jij    = _mm512_loadu_pd(Jxx + nn);
+                     vhx = _mm512_fmadd_pd(Jij, _mm512_i32gather_pd(natoms, sx, 8), vhx);
+                     vhy = _mm512_fmadd_pd(Jij, _mm512_i32gather_pd(natoms, sy, 8), vhy);
+                     vhz = _mm512_fmadd_pd(Jij, _mm512_i32gather_pd(natoms, sz, 8), vhz);
+                  }
+                  hx = _mm512_reduce_add_pd(vhx);
+                  hy = _mm512_reduce_add_pd(vhy);
+                  hz = _mm512_reduce_add_pd(vhz);
+               #elif defined(__AVX2__) && defined(__FMA__)
+                  // vectorised loop over neighbours in blocks of 4
+                  __m256d vhx = _mm256_setzero_pd();
+                  __m256d vhy = _mm256_setzero_pd();
+                  __m256d vhz = _mm256_setzero_pd();
+                  for(; nn + 4 <= end; nn += 4){
+                     const __m128i natoms = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nl + nn));
+                     const __m256d Jij    = _mm256_loadu_pd(Jxx + nn);
+                     vhx = _mm256_fmadd_pd(Jij, _mm256_i32gather_pd(sx, natoms, 8), vhx);
+                     vhy = _mm256_fmadd_pd(Jij, _mm256_i32gather_pd(sy, natoms, 8), vhy);
+                     vhz = _mm256_fmadd_pd(Jij, _mm256_i32gather_pd(sz, natoms, 8), vhz);
+                  }
+                  hx = horizontal_sum(vhx);
+                  hy = horizontal_sum(vhy);
+                  hz = horizontal_sum(vhz);
+               #endif
+
+               // loop over all (remaining) neighbours
+   				for(; nn < end; ++nn){
+
+   					const int natom = nl[nn]; // get neighbouring atom number
+   					const double Jij = Jxx[nn]; // get exchange constant between atoms
+
+   					hx += Jij * sx[natom]; // add exchange fields
+   					hy += Jij * sy[natom];
+   					hz += Jij * sz[natom];
 
    				}
 
@@ -79,45 +308,13 @@ namespace internal{
 
    			}
    			break;
+         }
 
-   		case exchange::vectorial: // vector
-
-            // loop over all atoms
-            for(int atom = start_index; atom < end_index; ++atom){
-
-               // temporary variables (registers) to calculate intermediate sum
-               double hx = 0.0;
-               double hy = 0.0;
-               double hz = 0.0;
-
-               // temporray constants for loop start and end indices
-               const int start = neighbour_list_start_index[atom];
-               const int end   = neighbour_list_end_index[atom]+1;
-
-               // loop over all neighbours
-               for(int nn = start; nn < end; ++nn){
-
-                  const int natom = neighbour_list_array[nn]; // get neighbouring atom number
-                  const int iid = neighbour_interaction_type_array[nn]; // interaction id
-
-   					const double Jij[3]={v_exchange_list[iid].Jij[0],
-   												v_exchange_list[iid].Jij[1],
-   												v_exchange_list[iid].Jij[2]};
-
-                  hx += Jij[0] * spin_array_x[natom]; // add exchange fields
-   					hy += Jij[1] * spin_array_y[natom];
-   					hz += Jij[2] * spin_array_z[natom];
-
-   				}
+   		case exchange::vectorial:{ // vector
 
-               field_array_x[atom] += hx; // save total field to field array
-   				field_array_y[atom] += hy;
-   				field_array_z[atom] += hz;
-
-   			}
-   			break;
-
-   		case exchange::tensorial: // tensor
+            const double* const jxx = csr_jxx.data();
+            const double* const jyy = csr_jyy.data();
+            const double* const jzz = csr_jzz.data();
 
             // loop over all atoms
             for(int atom = start_index; atom < end_index; ++atom){
@@ -127,33 +324,72 @@ namespace internal{
                double hy = 0.0;
                double hz = 0.0;
 
-               // temporray constants for loop start and end indices
-               const int start = neighbour_list_start_index[atom];
-               const int end   = neighbour_list_end_index[atom]+1;
-
-               // loop over all neighbours
-               for(int nn = start; nn < end; ++nn){
-
-                  const int natom = neighbour_list_array[nn]; // get neighbouring atom number
-                  const int iid = neighbour_interaction_type_array[nn]; // interaction id
-
-   					const double Jij[3][3]={ {t_exchange_list[iid].Jij[0][0],
-   													  t_exchange_list[iid].Jij[0][1],
-   												     t_exchange_list[iid].Jij[0][2]},
-
-   													 {t_exchange_list[iid].Jij[1][0],
-   													  t_exchange_list[iid].Jij[1][1],
-   													  t_exchange_list[iid].Jij[1][2]},
-
-   													 {t_exchange_list[iid].Jij[2][0],
-   													  t_exchange_list[iid].Jij[2][1],
-   													  t_exchange_list[iid].Jij[2][2]} };
+               // atoms in perfect lattice use unit cell stencil
+               if(stencil_active && stencil_index_array[atom] != -1){
+                  const double* const sjxx = stencil_jxx.data();
+                  const double* const sjyy = stencil_jyy.data();
+                  const double* const sjzz = stencil_jzz.data();
+                  for_each_stencil_neighbour(atom, stencil_index_array[atom], [&](const int k, const int natom){
+                     hx += sjxx[k] * sx[natom];
+                     hy += sjyy[k] * sy[natom];
+                     hz += sjzz[k] * sz[natom];
+                  });
+                  field_array_x[atom] += hx;
+                  field_array_y[atom] += hy;
+                  field_array_z[atom] += hz;
+                  continue;
+               }
+
+               // temporary constants for loop start and end indices
+               const int start = nl_start[atom];
+               const int end   = start + csr_start[atom+1] - csr_start[atom];
+               int nn = start;
+
+               // exchange constants for neighbours of atom
+               const int offset = csr_start[atom] - start;
+               const double* const Jxx = jxx + offset;
+               const double* const Jyy = jyy + offset;
+               const double* const Jzz = jzz + offset;
+
+               #if defined(__AVX512F__)
+                  // vectorised loop over neighbours in blocks of 8
+                  __m512d vhx = _mm512_setzero_pd();
+                  __m512d vhy = _mm512_setzero_pd();
+                  __m512d vhz = _mm512_setzero_pd();
+                  for(; nn + 8 <= end; nn += 8){
+                     const __m256i natoms = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(nl + nn));
+                     vhx = _mm512_fmadd_pd(_mm512_loadu_pd(Jxx + nn), _mm512_i32gather_pd(natoms, sx, 8), vhx);
+                     vhy = _mm512_fmadd_pd(_mm512_loadu_pd(Jyy + nn), _mm512_i32gather_pd(natoms, sy, 8), vhy);
+                     vhz = _mm512_fmadd_pd(_mm512_loadu_pd(Jzz + nn), _mm512_i32gather_pd(natoms, sz, 8), vhz);
+                  }
+                  hx = _mm512_reduce_add_pd(vhx);
+                  hy = _mm512_reduce_add_pd(vhy);
+                  hz = _mm512_reduce_add_pd(vhz);
+               #elif defined(__AVX2__) && defined(__FMA__)
+                  // vectorised loop over neighbours in blocks of 4
+                  __m256d vhx = _mm256_setzero_pd();
+                  __m256d vhy = _mm256_setzero_pd();
+                  __m256d vhz = _mm256_setzero_pd();
+                  for(; nn + 4 <= end; nn += 4){
+                     const __m128i natoms = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nl + nn));
+                     vhx = _mm256_fmadd_pd(_mm256_loadu_pd(Jxx + nn), _mm256_i32gather_pd(sx, natoms, 8), vhx);
+                     vhy = _mm256_fmadd_pd(_mm256_loadu_pd(Jyy + nn), _mm256_i32gather_pd(sy, natoms, 8), vhy);
+                     vhz = _mm256_fmadd_pd(_mm256_loadu_pd(Jzz + nn), _mm256_i32gather_pd(sz, natoms, 8), vhz);
+                  }
+                  hx = horizontal_sum(vhx);
+                  hy = horizontal_sum(vhy);
+                  hz = horizontal_sum(vhz);
+               #endif
+
+               // loop over all (remaining) neighbours
+               for(; nn < end; ++nn){
+
+                  const int natom = nl[nn]; // get neighbouring atom number
+
+                  hx += Jxx[nn] * sx[natom]; // add exchange fields
+   					hy += Jyy[nn] * sy[natom];
+   					hz += Jzz[nn] * sz[natom];
 
-   					const double S[3]={spin_array_x[natom], spin_array_y[natom], spin_array_z[natom]};
-
-   					hx += ( Jij[0][0] * S[0] + Jij[0][1] * S[1] + Jij[0][2] * S[2]);
-   					hy += ( Jij[1][0] * S[0] + Jij[1][1] * S[1] + Jij[1][2] * S[2]);
-   					hz += ( Jij[2][0] * S[0] + Jij[2][1] * S[1] + Jij[2][2] * S[2]);
    				}
 
                field_array_x[atom] += hx; // save total field to field array
@@ -162,29 +398,24 @@ namespace internal{
 
    			}
    			break;
+         }
+
+   		case exchange::tensorial:{ // tensor
+
+            // select unique tensor index width
+            if(!csr_tensor_id_16.empty()){
+               tensorial_exchange_fields(start_index, end_index, nl_start, nl, csr_start, csr_tensor_id_16.data(),
+                                         sx, sy, sz, field_array_x, field_array_y, field_array_z);
+            }
+            else{
+               tensorial_exchange_fields(start_index, end_index, nl_start, nl, csr_start, csr_tensor_id_32.data(),
+                                         sx, sy, sz, field_array_x, field_array_y, field_array_z);
+            }
+   			break;
+         }
 
    		}
 
-         // if (dipole::atomsitic_tensor_enabled){
-         //
-         //    for(int atom = start_index; atom < end_index; ++atom){
-         //       // temporray constants for loop start and end indices
-         //       const int start = dipole::atomistic_dd_neighbourlist_start[atom];
-         //       const int end   = dipole::atomistic_dd_neighbourlist_end[atom]+1;
-         //       std::cout << atom << '\t' << start << '\t' << end << std::endl;
-         //       // loop over all neighbours
-         //       for(int nn = start; nn < end; ++nn){
-         //          int atomj = dipole::atomistic_dd_neighbourlist[nn];
-         //       //   std::cout <<"NN:\t" << atom << '\t' << atomj << '\t' <<  std::endl;
-         //       }
-         //    }
-         //
-         //
-         //    }
-
-
-
-
    		return;
 
    	}
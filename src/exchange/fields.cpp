@@ -30,10 +30,6 @@ namespace exchange{
                const std::vector<int>& neighbour_list_end_index,
                const std::vector<int>& type_array, // type for atom
                const std::vector<int>& neighbour_list_array, // list of interactions between atoms
-               const std::vector<int>& neighbour_interaction_type_array, // list of interaction type for each pair of atoms with value given in exchange list
-               const std::vector <zval_t>& i_exchange_list, // list of isotropic exchange constants
-               const std::vector <zvec_t>& v_exchange_list, // list of vectorial exchange constants
-               const std::vector <zten_t>& t_exchange_list, // list of tensorial exchange constants
                const std::vector<double>& spin_array_x, // spin vectors for atoms
                const std::vector<double>& spin_array_y,
                const std::vector<double>& spin_array_z,
@@ -42,22 +38,31 @@ namespace exchange{
                std::vector<double>& field_array_z){
 
 
-   	// Calculate standard (bilinear) exchange fields
-      exchange::internal::exchange_fields(start_index, end_index,
-                                neighbour_list_start_index, neighbour_list_end_index,
-                                type_array, neighbour_list_array, neighbour_interaction_type_array,
-                                i_exchange_list, v_exchange_list, t_exchange_list,
-                                spin_array_x, spin_array_y, spin_array_z,
-                                field_array_x, field_array_y, field_array_z);
-
-      // calculate biquadratic exchange field
-      if(exchange::biquadratic){
-         exchange::internal::biquadratic_exchange_fields(start_index, end_index,
-                                                         exchange::internal::biquadratic_neighbour_list_start_index, exchange::internal::biquadratic_neighbour_list_end_index,
-                                                         type_array, exchange::internal::biquadratic_neighbour_list_array, exchange::internal::biquadratic_neighbour_interaction_type_array,
-                                                         internal::bq_i_exchange_list, internal::bq_v_exchange_list, internal::bq_t_exchange_list,
-                                                         spin_array_x, spin_array_y, spin_array_z,
-                                                         field_array_x, field_array_y, field_array_z);
+      // calculate bilinear and biquadratic exchange fields in a single pass for shared list
+      if(exchange::internal::fused_biquadratic){
+         exchange::internal::fused_biquadratic_exchange_fields(start_index, end_index,
+                                                               neighbour_list_start_index, neighbour_list_end_index, neighbour_list_array,
+                                                               spin_array_x, spin_array_y, spin_array_z,
+                                                               field_array_x, field_array_y, field_array_z);
+      }
+      else{
+
+         // Calculate standard (bilinear) exchange fields
+         exchange::internal::exchange_fields(start_index, end_index,
+                                             neighbour_list_start_index, neighbour_list_array,
+                                             spin_array_x, spin_array_y, spin_array_z,
+                                             field_array_x, field_array_y, field_array_z);
+
+         // calculate biquadratic exchange field
+         if(exchange::biquadratic){
+            exchange::internal::biquadratic_exchange_fields(start_index, end_index,
+                                                            exchange::internal::biquadratic_neighbour_list_start_index, exchange::internal::biquadratic_neighbour_list_end_index,
+                                                            type_array, exchange::internal::biquadratic_neighbour_list_array, exchange::internal::biquadratic_neighbour_interaction_type_array,
+                                                            internal::bq_i_exchange_list, internal::bq_v_exchange_list, internal::bq_t_exchange_list,
+                                                            spin_array_x, spin_array_y, spin_array_z,
+                                                            field_array_x, field_array_y, field_array_z);
+         }
+
       }
 
       if (exchange::four_spin){
@@ -68,4 +73,164 @@ namespace exchange{
 
    }
 
+   //-----------------------------------------------------------------------------
+   // Function to add bilinear exchange fields for spins between start and end
+   // index to field arrays, excluding biquadratic and four spin terms so that
+   // the bilinear exchange energy is given by E = -S.H
+   //-----------------------------------------------------------------------------
+   void bilinear_fields(const int start_index, // first atom for exchange interactions to be calculated
+                        const int end_index, // last +1 atom to be calculated
+                        const std::vector<double>& spin_array_x, // spin vectors for atoms
+                        const std::vector<double>& spin_array_y,
+                        const std::vector<double>& spin_array_z,
+                        std::vector<double>& field_array_x, // field vectors for atoms
+                        std::vector<double>& field_array_y,
+                        std::vector<double>& field_array_z){
+
+      exchange::internal::exchange_fields(start_index, end_index,
+                                          atoms::neighbour_list_start_index, atoms::neighbour_list_array,
+                                          spin_array_x, spin_array_y, spin_array_z,
+                                          field_array_x, field_array_y, field_array_z);
+
+      return;
+
+   }
+
+   //-----------------------------------------------------------------------------
+   // Function to add bilinear exchange field for a single spin to hx, hy, hz
+   //-----------------------------------------------------------------------------
+   void single_spin_field(const int atom, double& hx, double& hy, double& hz){
+
+      // atoms in perfect lattice use unit cell stencil
+      if(internal::stencil_active && internal::stencil_index_array[atom] != -1){
+         const double* const sx = atoms::x_spin_array.data();
+         const double* const sy = atoms::y_spin_array.data();
+         const double* const sz = atoms::z_spin_array.data();
+         switch(internal::exchange_type){
+            case exchange::isotropic:
+               internal::for_each_stencil_neighbour(atom, internal::stencil_index_array[atom], [&](const int k, const int natom){
+                  const double Jij = internal::stencil_jxx[k];
+                  hx += Jij * sx[natom];
+                  hy += Jij * sy[natom];
+                  hz += Jij * sz[natom];
+               });
+               break;
+            case exchange::vectorial:
+               internal::for_each_stencil_neighbour(atom, internal::stencil_index_array[atom], [&](const int k, const int natom){
+                  hx += internal::stencil_jxx[k] * sx[natom];
+                  hy += internal::stencil_jyy[k] * sy[natom];
+                  hz += internal::stencil_jzz[k] * sz[natom];
+               });
+               break;
+            case exchange::tensorial:
+               internal::for_each_stencil_neighbour(atom, internal::stencil_index_array[atom], [&](const int k, const int natom){
+                  const zten_t& J = atoms::t_exchange_list[ internal::stencil_tensor_id[k] ];
+                  const double S[3] = {sx[natom], sy[natom], sz[natom]};
+                  hx += ( J.Jij[0][0] * S[0] + J.Jij[0][1] * S[1] + J.Jij[0][2] * S[2]);
+                  hy += ( J.Jij[1][0] * S[0] + J.Jij[1][1] * S[1] + J.Jij[1][2] * S[2]);
+                  hz += ( J.Jij[2][0] * S[0] + J.Jij[2][1] * S[1] + J.Jij[2][2] * S[2]);
+               });
+               break;
+         }
+         return;
+      }
+
+      const int start = atoms::neighbour_list_start_index[atom];
+      const int end   = atoms::neighbour_list_end_index[atom]+1;
+
+      // offset of inline exchange constants from neighbour list index
+      const int offset = internal::csr_start_index[atom] - start;
+
+      switch(internal::exchange_type){
+
+         case exchange::isotropic:
+            for(int nn = start; nn < end; ++nn){
+               const int natom = atoms::neighbour_list_array[nn];
+               const double Jij = internal::csr_jxx[nn+offset];
+               hx += Jij * atoms::x_spin_array[natom];
+               hy += Jij * atoms::y_spin_array[natom];
+               hz += Jij * atoms::z_spin_array[natom];
+            }
+            break;
+
+         case exchange::vectorial:
+            for(int nn = start; nn < end; ++nn){
+               const int natom = atoms::neighbour_list_array[nn];
+               hx += internal::csr_jxx[nn+offset] * atoms::x_spin_array[natom];
+               hy += internal::csr_jyy[nn+offset] * atoms::y_spin_array[natom];
+               hz += internal::csr_jzz[nn+offset] * atoms::z_spin_array[natom];
+            }
+            break;
+
+         case exchange::tensorial:
+            for(int nn = start; nn < end; ++nn){
+               const int natom = atoms::neighbour_list_array[nn];
+               const int iid = internal::csr_tensor_id_16.empty() ? int(internal::csr_tensor_id_32[nn+offset]) : int(internal::csr_tensor_id_16[nn+offset]);
+               const zten_t& J = atoms::t_exchange_list[iid];
+               const double S[3] = {atoms::x_spin_array[natom], atoms::y_spin_array[natom], atoms::z_spin_array[natom]};
+               hx += ( J.Jij[0][0] * S[0] + J.Jij[0][1] * S[1] + J.Jij[0][2] * S[2]);
+               hy += ( J.Jij[1][0] * S[0] + J.Jij[1][1] * S[1] + J.Jij[1][2] * S[2]);
+               hz += ( J.Jij[2][0] * S[0] + J.Jij[2][1] * S[1] + J.Jij[2][2] * S[2]);
+            }
+            break;
+
+      }
+
+      return;
+
+   }
+
+   //-----------------------------------------------------------------------------
+   // Function to add bilinear exchange field for a single spin to hx, hy, hz and
+   // return the change in biquadratic exchange energy for a trial move from
+   // old_spin to new_spin, in a single pass over the neighbours when the two
+   // share the compact neighbour list
+   //-----------------------------------------------------------------------------
+   double single_spin_field_and_biquadratic_delta_energy(const int atom, const double old_spin[3], const double new_spin[3],
+                                                         double& hx, double& hy, double& hz){
+
+      if(!internal::fused_biquadratic){
+         single_spin_field(atom, hx, hy, hz);
+         return single_spin_biquadratic_energy(atom, new_spin[0], new_spin[1], new_spin[2])
+              - single_spin_biquadratic_energy(atom, old_spin[0], old_spin[1], old_spin[2]);
+      }
+
+      // biquadratic energies for new and old spin directions
+      double new_energy = 0.0;
+      double old_energy = 0.0;
+
+      // vectorial exchange uses separate constants for each component
+      const bool vectorial = (internal::exchange_type == exchange::vectorial);
+      const double* const jxx = internal::csr_jxx.data();
+      const double* const jyy = vectorial ? internal::csr_jyy.data() : jxx;
+      const double* const jzz = vectorial ? internal::csr_jzz.data() : jxx;
+
+      // fused list is never compacted by the lattice stencil, so constants
+      // have the same index as neighbours
+      for(int nn = atoms::neighbour_list_start_index[atom]; nn <= atoms::neighbour_list_end_index[atom]; ++nn){
+
+         const int natom = atoms::neighbour_list_array[nn];
+
+         const double sjx = atoms::x_spin_array[natom];
+         const double sjy = atoms::y_spin_array[natom];
+         const double sjz = atoms::z_spin_array[natom];
+
+         // bilinear exchange field
+         hx += jxx[nn] * sjx;
+         hy += jyy[nn] * sjy;
+         hz += jzz[nn] * sjz;
+
+         // biquadratic exchange energy
+         const double Jbq = internal::csr_jbq[nn];
+         const double new_dot_sj = new_spin[0]*sjx + new_spin[1]*sjy + new_spin[2]*sjz;
+         const double old_dot_sj = old_spin[0]*sjx + old_spin[1]*sjy + old_spin[2]*sjz;
+         new_energy -= Jbq * new_dot_sj * new_dot_sj;
+         old_energy -= Jbq * old_dot_sj * old_dot_sj;
+
+      }
+
+      return new_energy - old_energy;
+
+   }
+
 } // end of exchange namespace
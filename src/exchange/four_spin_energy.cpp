@@ -44,16 +44,19 @@ double single_spin_four_spin_energy(const int atom, const double sx, const doubl
 
    double energy=0.0;
 
-   const double six = atoms::x_spin_array[atom];
-   const double siy = atoms::y_spin_array[atom];
-   const double siz = atoms::z_spin_array[atom];
+   // check for initialised four spin list
+   if(internal::four_spin_start_index.empty()) return 0.0;
 
-   // Loop over neighbouring spins to calculate exchange
-   for(int nn = internal::four_spin_neighbour_list_start_index[atom]; nn <= internal::four_spin_neighbour_list_end_index[atom]; ++nn){
+   const double six = sx;
+   const double siy = sy;
+   const double siz = sz;
 
-      const int natomj = internal::four_spin_neighbour_list_array_j[nn];
-		const int natomk = internal::four_spin_neighbour_list_array_k[nn];
-		const int natoml = internal::four_spin_neighbour_list_array_l[nn];
+   // Loop over quadruplets of central atom to calculate exchange
+   for(int nn = internal::four_spin_start_index[atom]; nn < internal::four_spin_start_index[atom+1]; ++nn){
+
+      const int natomj = internal::four_spin_neighbour_array[3*nn+0];
+      const int natomk = internal::four_spin_neighbour_array[3*nn+1];
+      const int natoml = internal::four_spin_neighbour_array[3*nn+2];
 
       const double sjx = atoms::x_spin_array[natomj];
       const double sjy = atoms::y_spin_array[natomj];
@@ -79,7 +82,7 @@ double single_spin_four_spin_energy(const int atom, const double sx, const doubl
 
     }
 
-    return 0;
+    return energy;
 }
 
 } // end of namespace
@@ -29,46 +29,73 @@ namespace exchange{
 
 namespace internal{
 
+//-----------------------------------------------------------------------------
+// Function to calculate four spin exchange fields for spins between start and
+// end index
+//
+// Quadruplets are stored grouped by central atom in compact (CSR) form, so
+// only atoms in range are visited and each atom accumulates its own field,
+// allowing threading over atoms and MPI core/boundary splitting. As for the
+// bilinear exchange, threads call this function for their own range of atoms.
+//-----------------------------------------------------------------------------
 void four_spin_exchange_fields(const int start_index, // first atom for exchange interactions to be calculated
-                               const int end_index,                                 // field vectors for atoms
-                               std::vector<double>& field_array_x,
+                               const int end_index, // last +1 atom to be calculated
+                               std::vector<double>& field_array_x, // field vectors for atoms
                                std::vector<double>& field_array_y,
-                               std::vector<double>& field_array_z){ // last +1 atom to be calculated){
+                               std::vector<double>& field_array_z){
+
+   // check for initialised four spin list
+   if(four_spin_start_index.empty()) return;
+
+   const int* const    fs_start = four_spin_start_index.data();
+   const int* const    fs_nn    = four_spin_neighbour_array.data();
+   const double* const fs_J     = four_spin_exchange_list.data();
+   const double* const sx       = atoms::x_spin_array.data();
+   const double* const sy       = atoms::y_spin_array.data();
+   const double* const sz       = atoms::z_spin_array.data();
+
+   const double athird = 1.0/3.0;
+
+   // loop over all atoms in range
+   for(int atom = start_index; atom < end_index; ++atom){
+
+      // temporary variables (registers) to calculate intermediate sum
+      double hx = field_array_x[atom];
+      double hy = field_array_y[atom];
+      double hz = field_array_z[atom];
 
-   std::vector < int > numbers(atoms::num_atoms,0);
+      for(int nn = fs_start[atom]; nn < fs_start[atom+1]; ++nn){
 
-   // loop over all neighbours
-	for(int nn = 0; nn < four_spin_neighbour_list_array_l.size(); ++nn){
+         const int natomj = fs_nn[3*nn+0];
+         const int natomk = fs_nn[3*nn+1];
+         const int natoml = fs_nn[3*nn+2];
+         const double Jij = fs_J[nn];
 
-      // get neighbouring atom number
-   	const int atom = four_spin_neighbour_list_array_i[nn];
-   	const int natomj = four_spin_neighbour_list_array_j[nn];
-   	const int natomk = four_spin_neighbour_list_array_k[nn];
-      const int natoml = four_spin_neighbour_list_array_l[nn];
-      //const int jmaterial = atoms::type_array[natomj];
-      const double Jij = four_spin_exchange_list[nn];
+         const double sjx = sx[natomj];
+         const double sjy = sy[natomj];
+         const double sjz = sz[natomj];
 
-      const double sjx = atoms::x_spin_array[natomj];
-      const double sjy = atoms::y_spin_array[natomj];
-      const double sjz = atoms::z_spin_array[natomj];
+         const double skx = sx[natomk];
+         const double sky = sy[natomk];
+         const double skz = sz[natomk];
 
-      const double skx = atoms::x_spin_array[natomk];
-      const double sky = atoms::y_spin_array[natomk];
-      const double skz = atoms::z_spin_array[natomk];
+         const double slx = sx[natoml];
+         const double sly = sy[natoml];
+         const double slz = sz[natoml];
 
-      const double slx = atoms::x_spin_array[natoml];
-      const double sly = atoms::y_spin_array[natoml];
-      const double slz = atoms::z_spin_array[natoml];
+         const double sk_dot_sl = dot_product(skx,sky,skz,slx,sly,slz);
+         const double sj_dot_sk = dot_product(skx,sky,skz,sjx,sjy,sjz);
+         const double sj_dot_sl = dot_product(sjx,sjy,sjz,slx,sly,slz);
 
-      const double sk_dot_sl = dot_product(skx,sky,skz,slx,sly,slz);
-      const double sj_dot_sk = dot_product(skx,sky,skz,sjx,sjy,sjz);
-      const double sj_dot_sl = dot_product(sjx,sjy,sjz,slx,sly,slz);
+         hx = hx + (Jij*athird)*(sjx*sk_dot_sl + skx*sj_dot_sl + slx*sj_dot_sk);
+         hy = hy + (Jij*athird)*(sjy*sk_dot_sl + sky*sj_dot_sl + sly*sj_dot_sk);
+         hz = hz + (Jij*athird)*(sjz*sk_dot_sl + skz*sj_dot_sl + slz*sj_dot_sk);
 
-      double athird=1.0/3.0;
+      }
 
-      field_array_x[atom] = field_array_x[atom] + (Jij*athird)*(sjx*sk_dot_sl + skx*sj_dot_sl + slx*sj_dot_sk);
-      field_array_y[atom] = field_array_y[atom] + (Jij*athird)*(sjy*sk_dot_sl + sky*sj_dot_sl + sly*sj_dot_sk);
-      field_array_z[atom] = field_array_z[atom] + (Jij*athird)*(sjz*sk_dot_sl + skz*sj_dot_sl + slz*sj_dot_sk);
+      field_array_x[atom] = hx;
+      field_array_y[atom] = hy;
+      field_array_z[atom] = hz;
 
    }
 
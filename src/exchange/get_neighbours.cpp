@@ -0,0 +1,53 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2024. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+
+// Vampire headers
+#include "atoms.hpp"
+#include "exchange.hpp"
+
+// exchange module headers
+#include "internal.hpp"
+
+namespace exchange{
+
+   //------------------------------------------------------------------------------
+   // Function to append all atoms interacting with atom via bilinear,
+   // biquadratic or four spin exchange to list of neighbours
+   //------------------------------------------------------------------------------
+   void get_neighbours(const int atom, std::vector<int>& neighbours){
+
+      // bilinear exchange
+      for(int nn = atoms::neighbour_list_start_index[atom]; nn <= atoms::neighbour_list_end_index[atom]; ++nn){
+         neighbours.push_back(atoms::neighbour_list_array[nn]);
+      }
+
+      // biquadratic exchange (unless sharing bilinear list)
+      if(exchange::biquadratic && !internal::fused_biquadratic){
+         for(int nn = internal::biquadratic_neighbour_list_start_index[atom]; nn <= internal::biquadratic_neighbour_list_end_index[atom]; ++nn){
+            neighbours.push_back(internal::biquadratic_neighbour_list_array[nn]);
+         }
+      }
+
+      // four spin exchange (j, k and l atoms of quadruplets with central atom)
+      if(exchange::four_spin && !internal::four_spin_start_index.empty()){
+         for(int nn = 3*internal::four_spin_start_index[atom]; nn < 3*internal::four_spin_start_index[atom+1]; ++nn){
+            neighbours.push_back(internal::four_spin_neighbour_array[nn]);
+         }
+      }
+
+      return;
+
+   }
+
+} // end of exchange namespace
@@ -50,8 +50,8 @@ namespace exchange{
    //----------------------------------------------------------------------------
    // Function to initialize exchange module
    //----------------------------------------------------------------------------
-   void initialize(std::vector<std::vector <neighbours::neighbour_t> >& bilinear,
-                   std::vector<std::vector <neighbours::neighbour_t> >& biquadratic){
+   void initialize(neighbours::list_t& bilinear,
+                   neighbours::list_t& biquadratic){
 
       zlog << zTs() << "Initialising data structures for exchange calculation." << std::endl;
 
@@ -285,6 +285,15 @@ namespace exchange{
       // Calculate Kitaev interactions (must be done after exchange unrolling)
       exchange::internal::calculate_kitaev(bilinear);
 
+      // Remove duplicate tensors from unrolled exchange list
+      if(exchange::internal::exchange_type == exchange::tensorial) exchange::internal::deduplicate_tensorial_exchange();
+
+      // Generate compact form of exchange list for field calculation
+      exchange::internal::initialize_csr_exchange();
+
+      // Merge biquadratic exchange into compact list where pairs coincide
+      exchange::internal::initialize_fused_biquadratic_exchange();
+
       return;
 
    }
@@ -0,0 +1,194 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2024. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cstdint>
+
+// Vampire headers
+#include "atoms.hpp"
+#include "exchange.hpp"
+#include "vio.hpp"
+
+// exchange module headers
+#include "internal.hpp"
+
+namespace exchange{
+
+   namespace internal{
+
+   //----------------------------------------------------------------------------
+   // Function to generate compact (CSR) form of the bilinear exchange list
+   //
+   // Isotropic and vectorial exchange constants are copied inline for each pair
+   // in the atoms neighbour list, so that the field calculation streams
+   // contiguous arrays instead of looking up constants through the interaction
+   // type. Offsets of the constants for each atom are stored (num_atoms+1) so
+   // that the constants of stencil atoms can later be removed.
+   // Tensorial interactions keep a 16-bit (or 32-bit for more than 65536 unique
+   // tensors) index into the deduplicated tensor list. Must be called after
+   // exchange unrolling, calculation of DMI/Kitaev terms and deduplication.
+   //----------------------------------------------------------------------------
+   void initialize_csr_exchange(){
+
+      const int num_atoms = atoms::num_atoms;
+      const int num_interactions = atoms::neighbour_list_array.size();
+
+      csr_start_index.resize(num_atoms+1, 0);
+
+      // generate offsets of exchange constants, initially the same as the neighbour list
+      for(int atom = 0; atom < num_atoms; atom++){
+         csr_start_index[atom] = atoms::neighbour_list_start_index[atom];
+      }
+      csr_start_index[num_atoms] = num_atoms > 0 ? atoms::neighbour_list_end_index[num_atoms-1]+1 : 0;
+
+      // reset exchange constant arrays in case of reinitialisation
+      csr_jxx.clear();
+      csr_jyy.clear();
+      csr_jzz.clear();
+      csr_tensor_id_16.clear();
+      csr_tensor_id_32.clear();
+
+      uint64_t bytes_per_interaction = 0;
+
+      switch(internal::exchange_type){
+
+         case exchange::isotropic:
+            csr_jxx.resize(num_interactions);
+            for(int nn = 0; nn < num_interactions; nn++){
+               csr_jxx[nn] = atoms::i_exchange_list[ atoms::neighbour_interaction_type_array[nn] ].Jij;
+            }
+            bytes_per_interaction += sizeof(double);
+            break;
+
+         case exchange::vectorial:
+            csr_jxx.resize(num_interactions);
+            csr_jyy.resize(num_interactions);
+            csr_jzz.resize(num_interactions);
+            for(int nn = 0; nn < num_interactions; nn++){
+               const int iid = atoms::neighbour_interaction_type_array[nn];
+               csr_jxx[nn] = atoms::v_exchange_list[iid].Jij[0];
+               csr_jyy[nn] = atoms::v_exchange_list[iid].Jij[1];
+               csr_jzz[nn] = atoms::v_exchange_list[iid].Jij[2];
+            }
+            bytes_per_interaction += 3*sizeof(double);
+            break;
+
+         case exchange::tensorial:
+            if(atoms::t_exchange_list.size() <= 65536){
+               csr_tensor_id_16.resize(num_interactions);
+               for(int nn = 0; nn < num_interactions; nn++){
+                  csr_tensor_id_16[nn] = atoms::neighbour_interaction_type_array[nn];
+               }
+               bytes_per_interaction += sizeof(uint16_t);
+            }
+            else{
+               csr_tensor_id_32.resize(num_interactions);
+               for(int nn = 0; nn < num_interactions; nn++){
+                  csr_tensor_id_32[nn] = atoms::neighbour_interaction_type_array[nn];
+               }
+               bytes_per_interaction += sizeof(uint32_t);
+            }
+            break;
+
+      }
+
+      // include table of unique tensors for tensorial exchange
+      const double bytes = double(bytes_per_interaction)*double(num_interactions) + double(atoms::t_exchange_list.size())*double(sizeof(zten_t));
+
+      zlog << zTs() << "Inline exchange constants require " << bytes*1.0e-6 << " MB RAM" << std::endl;
+
+      return;
+
+   }
+
+   //----------------------------------------------------------------------------
+   // Function to merge isotropic biquadratic exchange into the compact list
+   //
+   // In most materials the biquadratic interactions are defined over the same
+   // neighbour shells as the bilinear exchange, giving identical lists of
+   // pairs. In this case the biquadratic constants are copied inline to the
+   // compact list and the separate biquadratic list is released, so that the
+   // bilinear and biquadratic fields and energies are calculated in a single
+   // pass over the neighbours. Must be called after initialize_csr_exchange().
+   //----------------------------------------------------------------------------
+   void initialize_fused_biquadratic_exchange(){
+
+      fused_biquadratic = false;
+      csr_jbq.clear();
+
+      if(!exchange::biquadratic) return;
+
+      // only isotropic biquadratic exchange with isotropic or vectorial bilinear exchange
+      if(internal::biquadratic_exchange_type != exchange::isotropic) return;
+      if(internal::exchange_type == exchange::tensorial) return;
+
+      const int num_atoms = atoms::num_atoms;
+      const int num_interactions = atoms::neighbour_list_array.size();
+
+      if(int(biquadratic_neighbour_list_array.size()) != num_interactions) return;
+
+      // check that all pairs coincide and are in the same order
+      for(int atom = 0; atom < num_atoms; atom++){
+         const int start = biquadratic_neighbour_list_start_index[atom];
+         const int end   = biquadratic_neighbour_list_end_index[atom]+1;
+         if(start != csr_start_index[atom] || end != csr_start_index[atom+1]) return;
+         for(int nn = start; nn < end; nn++){
+            if(biquadratic_neighbour_list_array[nn] != atoms::neighbour_list_array[nn]) return;
+         }
+      }
+
+      csr_jbq.resize(num_interactions);
+      for(int nn = 0; nn < num_interactions; nn++){
+         csr_jbq[nn] = bq_i_exchange_list[ biquadratic_neighbour_interaction_type_array[nn] ].Jij;
+      }
+
+      // release separate biquadratic list
+      std::vector<int>().swap(biquadratic_neighbour_list_array);
+      std::vector<int>().swap(biquadratic_neighbour_interaction_type_array);
+      std::vector<int>().swap(biquadratic_neighbour_list_start_index);
+      std::vector<int>().swap(biquadratic_neighbour_list_end_index);
+      std::vector<value_t>().swap(bq_i_exchange_list);
+
+      fused_biquadratic = true;
+
+      zlog << zTs() << "Biquadratic exchange merged with bilinear exchange list, requiring " << double(num_interactions)*double(sizeof(double))*1.0e-6
+           << " MB RAM" << std::endl;
+
+      return;
+
+   }
+
+   } // end of internal namespace
+
+   //----------------------------------------------------------------------------
+   // Function to release interaction types of the bilinear exchange list
+   //
+   // Exchange constants are stored inline in the compact list, so that the
+   // per-pair interaction types are only needed to initialise other modules
+   // (GPU and micromagnetic) and are released before the simulation starts.
+   //----------------------------------------------------------------------------
+   void release_interaction_types(){
+
+      // keep interaction types if compact list has not been generated
+      if(internal::csr_start_index.empty()) return;
+
+      const double bytes = double(atoms::neighbour_interaction_type_array.size())*double(sizeof(int));
+
+      std::vector<int>().swap(atoms::neighbour_interaction_type_array);
+
+      zlog << zTs() << "Released " << bytes*1.0e-6 << " MB RAM of exchange interaction types" << std::endl;
+
+      return;
+
+   }
+
+} // end of exchange namespace
@@ -20,6 +20,7 @@
 #include "atoms.hpp"
 #include "create.hpp"
 #include "material.hpp"
+#include "vmpi.hpp"
 
 
 // exchange module headers
@@ -31,14 +32,11 @@ namespace exchange{
 
 namespace internal{
 
-   void initialize_four_spin_exchange(std::vector<std::vector <neighbours::neighbour_t> >& cneighbourlist){
+   void initialize_four_spin_exchange(neighbours::list_t& cneighbourlist){
 
       // if four spin exchange is not needed then do nothing
       if(!internal::enable_fourspin) return;
 
-      exchange::internal::four_spin_neighbour_list_start_index.resize(atoms::num_atoms,0);
-      exchange::internal::four_spin_neighbour_list_end_index.resize(atoms::num_atoms,0);
-
       //distances here are for a cubic system of normalised dimension
       double nn_distance = internal::fs_cutoff_1;
       double nnn_distance = internal::fs_cutoff_2;
@@ -62,6 +60,13 @@ namespace internal{
       start_first_neigh.resize(atoms::num_atoms);
       end_first_neigh.resize(atoms::num_atoms);
 
+      // temporary lists of quadruplets i-j-k-l in order of generation
+      std::vector <int> quad_i(0);
+      std::vector <int> quad_j(0);
+      std::vector <int> quad_k(0);
+      std::vector <int> quad_l(0);
+      std::vector <double> quad_J(0);
+
       //to print out the four-spin interaction
       std::ofstream ofile;
       ofile.open("fourspin_quartets.txt");
@@ -108,8 +113,6 @@ namespace internal{
          const int imaterial = atoms::type_array[i];
          const double imus = 1.0 / mp::material[imaterial].mu_s_SI; // get inverse spin moment
 
-         four_spin_neighbour_list_start_index[i] = n_interactions;
-
          for(int a=start;a<end;a++){
             //const int jmaterial = atoms::type_array[a];
             for(int b=a;b<end;b++){
@@ -155,39 +158,38 @@ namespace internal{
                   if (((d1 <= nnn_distance+0.01) && (d1 >= nnn_distance-0.01))&& ((d2 <= nnn_distance+0.01) && (d2 >= nnn_distance-0.01)) &&((d3 <= nnn_distance+0.01) && (d3 >= nnn_distance-0.01)) ){
                      //get four spin exchange constant from material i to material j
                      //add j k l to arrays for atom i .
-                     four_spin_neighbour_list_array_i.push_back(i);
-                     four_spin_neighbour_list_array_j.push_back(first_neigh[a]);
-                     four_spin_neighbour_list_array_k.push_back(first_neigh[b]);
-                     four_spin_neighbour_list_array_l.push_back(first_neigh[c]);
+                     quad_i.push_back(i);
+                     quad_j.push_back(first_neigh[a]);
+                     quad_k.push_back(first_neigh[b]);
+                     quad_l.push_back(first_neigh[c]);
 
-                     four_spin_neighbour_list_array_i.push_back(first_neigh[a]);
-                     four_spin_neighbour_list_array_j.push_back(first_neigh[b]);
-                     four_spin_neighbour_list_array_k.push_back(first_neigh[c]);
-                     four_spin_neighbour_list_array_l.push_back(i);
+                     quad_i.push_back(first_neigh[a]);
+                     quad_j.push_back(first_neigh[b]);
+                     quad_k.push_back(first_neigh[c]);
+                     quad_l.push_back(i);
 
-                     four_spin_neighbour_list_array_i.push_back(first_neigh[b]);
-                     four_spin_neighbour_list_array_j.push_back(first_neigh[c]);
-                     four_spin_neighbour_list_array_k.push_back(i);
-                     four_spin_neighbour_list_array_l.push_back(first_neigh[a]);
+                     quad_i.push_back(first_neigh[b]);
+                     quad_j.push_back(first_neigh[c]);
+                     quad_k.push_back(i);
+                     quad_l.push_back(first_neigh[a]);
 
-                     four_spin_neighbour_list_array_i.push_back(first_neigh[c]);
-                     four_spin_neighbour_list_array_j.push_back(i);
-                     four_spin_neighbour_list_array_k.push_back(first_neigh[a]);
-                     four_spin_neighbour_list_array_l.push_back(first_neigh[b]);
+                     quad_i.push_back(first_neigh[c]);
+                     quad_j.push_back(i);
+                     quad_k.push_back(first_neigh[a]);
+                     quad_l.push_back(first_neigh[b]);
 
 
                      //    four times for all the permutations
                      double fs_value= exchange::internal::mp[atoms::type_array[i]].fs[atoms::type_array[first_neigh[a]]];
-                     four_spin_exchange_list.push_back(fs_value*imus);
-                     four_spin_exchange_list.push_back(fs_value*imus);
-                     four_spin_exchange_list.push_back(fs_value*imus);
-                     four_spin_exchange_list.push_back(fs_value*imus);
+                     quad_J.push_back(fs_value*imus);
+                     quad_J.push_back(fs_value*imus);
+                     quad_J.push_back(fs_value*imus);
+                     quad_J.push_back(fs_value*imus);
 
                      //4 interactions due to the permutations
                      n_interactions=n_interactions+1;
 
                      ofile << n_interactions << "\t" << i << "\t" <<  a << "\t" << b << "\t" << c <<"\t"<<-0.23e-21*imus<<std::endl;
-                     four_spin_neighbour_list_end_index[i] = n_interactions;
                   }
                }
             }
@@ -195,6 +197,47 @@ namespace internal{
       }
 
       ofile.close();
+
+      //------------------------------------------------------------------------
+      // Group quadruplets by central atom i in compact (CSR) form, preserving
+      // the order of generation for each atom. In parallel only quadruplets
+      // for local atoms are stored since fields are not needed for halo atoms.
+      //------------------------------------------------------------------------
+      #ifdef MPICF
+         const int num_local_atoms = vmpi::num_core_atoms + vmpi::num_bdry_atoms;
+      #else
+         const int num_local_atoms = atoms::num_atoms;
+      #endif
+
+      const int num_quadruplets = quad_i.size();
+
+      four_spin_start_index.assign(atoms::num_atoms+1, 0);
+      for(int q = 0; q < num_quadruplets; q++){
+         if(quad_i[q] < num_local_atoms) four_spin_start_index[quad_i[q]+1]++;
+      }
+      for(int atom = 0; atom < atoms::num_atoms; atom++) four_spin_start_index[atom+1] += four_spin_start_index[atom];
+
+      const int num_stored = four_spin_start_index[atoms::num_atoms];
+      four_spin_neighbour_array.resize(3*num_stored);
+      four_spin_exchange_list.resize(num_stored);
+
+      // use start index as insertion point for each atom
+      for(int q = 0; q < num_quadruplets; q++){
+         const int atom = quad_i[q];
+         if(atom >= num_local_atoms) continue;
+         const int index = four_spin_start_index[atom]++;
+         four_spin_neighbour_array[3*index+0] = quad_j[q];
+         four_spin_neighbour_array[3*index+1] = quad_k[q];
+         four_spin_neighbour_array[3*index+2] = quad_l[q];
+         four_spin_exchange_list[index] = quad_J[q];
+      }
+
+      // restore start index
+      for(int atom = atoms::num_atoms; atom > 0; atom--) four_spin_start_index[atom] = four_spin_start_index[atom-1];
+      four_spin_start_index[0] = 0;
+
+      zlog << zTs() << "Four-spin exchange list with " << num_stored << " quadruplets requires "
+           << double(num_stored)*double(3*sizeof(int)+sizeof(double))*1.0e-6 << " MB RAM" << std::endl;
       std::cout<<"Four-spin quartets have been initialised"<<std::endl;
 
       return;
@@ -0,0 +1,419 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2024. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+// Vampire headers
+#include "atoms.hpp"
+#include "create.hpp"
+#include "exchange.hpp"
+#include "unitcell.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// exchange module headers
+#include "internal.hpp"
+
+namespace exchange{
+
+   namespace internal{
+
+      //------------------------------------------------------------------------
+      // Function to append the exchange constants of interaction nn in the
+      // compact list to a byte string, for comparing atoms with the stencil
+      //------------------------------------------------------------------------
+      void append_exchange_constants(const int nn, std::string& signature){
+
+         switch(exchange_type){
+            case exchange::isotropic:
+               signature.append(reinterpret_cast<const char*>(&csr_jxx[nn]), sizeof(double));
+               break;
+            case exchange::vectorial:
+               signature.append(reinterpret_cast<const char*>(&csr_jxx[nn]), sizeof(double));
+               signature.append(reinterpret_cast<const char*>(&csr_jyy[nn]), sizeof(double));
+               signature.append(reinterpret_cast<const char*>(&csr_jzz[nn]), sizeof(double));
+               break;
+            case exchange::tensorial:{
+               const uint32_t id = csr_tensor_id_16.empty() ? csr_tensor_id_32[nn] : uint32_t(csr_tensor_id_16[nn]);
+               signature.append(reinterpret_cast<const char*>(&id), sizeof(uint32_t));
+               break;
+            }
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to release stencil data
+      //------------------------------------------------------------------------
+      void clear_stencil(){
+         stencil_active = false;
+         std::vector<int>().swap(stencil_start);
+         std::vector<int>().swap(stencil_dx);
+         std::vector<int>().swap(stencil_dy);
+         std::vector<int>().swap(stencil_dz);
+         std::vector<int>().swap(stencil_site);
+         std::vector<int>().swap(stencil_offset);
+         std::vector<double>().swap(stencil_jxx);
+         std::vector<double>().swap(stencil_jyy);
+         std::vector<double>().swap(stencil_jzz);
+         std::vector<uint32_t>().swap(stencil_tensor_id);
+         std::vector<int>().swap(stencil_index_array);
+         std::vector<int>().swap(stencil_atom_map);
+         return;
+      }
+
+   } // end of internal namespace
+
+   //---------------------------------------------------------------------------
+   // Function to initialise lattice stencil form of the bilinear exchange list
+   //
+   // In a perfect crystal all atoms on the same unit cell site have the same
+   // neighbours relative to their unit cell, given by the unit cell exchange
+   // template. Atoms are placed on a grid of (unit cell, site) and for atoms
+   // whose explicit neighbour list and exchange constants are identical to the
+   // template (stencil), neighbours are calculated on the fly in the field
+   // calculation, either from the usual offsets in atom number for each site
+   // or by lookup of the neighbouring grid points. Inline exchange constants
+   // are kept only for atoms near surfaces, interfaces, vacancies or with
+   // different exchange constants. atoms::neighbour_list_array is still needed
+   // by the energy, micromagnetic, environment and GPU code and is not
+   // released, so the memory saved is that of the exchange constants (8 of
+   // the 12 bytes per interaction for isotropic exchange), while the field
+   // calculation for stencil atoms reads neither list. The stencil sums
+   // neighbours in the same order as the explicit list so that results are
+   // unchanged. Must be called after exchange initialisation.
+   //---------------------------------------------------------------------------
+   void initialize_lattice_stencil(const std::vector<cs::catom_t>& atom_array){
+
+      namespace ei = exchange::internal;
+
+      if(!ei::lattice_stencil) return;
+
+      // compact list is shared with biquadratic exchange so must be kept
+      if(ei::fused_biquadratic){
+         zlog << zTs() << "Lattice stencil not used as biquadratic exchange is merged with the bilinear exchange list" << std::endl;
+         return;
+      }
+
+      ei::clear_stencil();
+
+      const int num_atoms = atoms::num_atoms;
+      const int ns = cs::unit_cell.atom.size();
+      const std::vector<unitcell::interaction_t>& interaction = cs::unit_cell.bilinear.interaction;
+
+      zlog << zTs() << "Initialising lattice stencil form of exchange list" << std::endl;
+
+      //------------------------------------------------------------------------
+      // Generate stencil for each unit cell site in order of interactions
+      //------------------------------------------------------------------------
+      ei::stencil_start.assign(ns+1, 0);
+      std::vector<int> stencil_interaction;
+      for(int site = 0; site < ns; site++){
+         ei::stencil_start[site] = stencil_interaction.size();
+         for(size_t i = 0; i < interaction.size(); i++){
+            if(int(interaction[i].i) == site) stencil_interaction.push_back(i);
+         }
+      }
+      ei::stencil_start[ns] = stencil_interaction.size();
+
+      const int num_stencil = stencil_interaction.size();
+      ei::stencil_dx.resize(num_stencil);
+      ei::stencil_dy.resize(num_stencil);
+      ei::stencil_dz.resize(num_stencil);
+      ei::stencil_site.resize(num_stencil);
+      for(int k = 0; k < num_stencil; k++){
+         const unitcell::interaction_t& uci = interaction[ stencil_interaction[k] ];
+         ei::stencil_dx[k]   = uci.dx;
+         ei::stencil_dy[k]   = uci.dy;
+         ei::stencil_dz[k]   = uci.dz;
+         ei::stencil_site[k] = uci.j;
+      }
+
+      //------------------------------------------------------------------------
+      // Determine grid of unit cells (as for neighbour list generation)
+      //------------------------------------------------------------------------
+      int64_t min[3] = { INT_MAX, INT_MAX, INT_MAX };
+      int64_t max[3] = { INT_MIN, INT_MIN, INT_MIN };
+      for(int atom = 0; atom < num_atoms; atom++){
+         const int64_t c[3] = { atom_array[atom].scx, atom_array[atom].scy, atom_array[atom].scz };
+         for(int i = 0; i < 3; i++){
+            if(c[i] < min[i]) min[i] = c[i];
+            if(c[i] > max[i]) max[i] = c[i];
+         }
+      }
+
+      // number of bits for unit cell site in grid index
+      ei::stencil_site_bits = 0;
+      while((1 << ei::stencil_site_bits) < ns) ei::stencil_site_bits++;
+      const int bits = ei::stencil_site_bits;
+
+      int64_t grid_size = num_atoms > 0 ? int64_t(1) << bits : 0;
+      for(int i = 0; i < 3; i++){
+         ei::stencil_dims[i] = num_atoms > 0 ? max[i] - min[i] + 1 : 0;
+         grid_size *= ei::stencil_dims[i];
+      }
+      if(grid_size == 0 || grid_size > INT_MAX){
+         zlog << zTs() << "\tUnable to generate stencil grid with " << grid_size << " points; using explicit neighbour lists" << std::endl;
+         ei::clear_stencil();
+         return;
+      }
+      const int* const D = ei::stencil_dims;
+
+      // periodic boundaries are handled by halo atoms in parallel mode
+      bool wrap[3] = { false, false, false };
+      #ifndef MPICF
+         for(int i = 0; i < 3; i++) wrap[i] = cs::pbc[i];
+      #endif
+
+      // place atoms on grid, marking duplicate grid points as missing
+      ei::stencil_atom_map.assign(grid_size, -1);
+      std::vector<int> grid_index(num_atoms);
+      for(int atom = 0; atom < num_atoms; atom++){
+         const int cx = atom_array[atom].scx - min[0];
+         const int cy = atom_array[atom].scy - min[1];
+         const int cz = atom_array[atom].scz - min[2];
+         const int index = (((cz*D[1] + cy)*D[0] + cx) << bits) + int(atom_array[atom].uc_id);
+         grid_index[atom] = index;
+         if(ei::stencil_atom_map[index] == -1) ei::stencil_atom_map[index] = atom;
+         else ei::stencil_atom_map[index] = -2;
+      }
+
+      //------------------------------------------------------------------------
+      // Identify atoms whose explicit neighbour list matches the stencil
+      //------------------------------------------------------------------------
+      const int* const csr_start = &ei::csr_start_index[0];
+      const int mask = (1 << bits) - 1;
+      const int min_pattern_atoms = 8; // minimum number of atoms sharing a pattern of neighbour offsets
+      std::vector<bool> candidate(num_atoms, false);
+      std::vector< std::map<std::string, int> > signature_count(ns);
+      std::vector< std::map<std::vector<int>, int> > offset_count(ns);
+
+      // function to determine offsets in atom number of explicit neighbours
+      auto neighbour_offsets = [&](const int atom){
+         std::vector<int> offsets;
+         for(int nn = csr_start[atom]; nn < csr_start[atom+1]; nn++) offsets.push_back(atoms::neighbour_list_array[nn] - atom);
+         return offsets;
+      };
+
+      for(int atom = 0; atom < num_atoms; atom++){
+
+         const int index = grid_index[atom];
+         if(ei::stencil_atom_map[index] != atom) continue;
+
+         const int site = index & mask;
+         const int start = csr_start[atom];
+         if(csr_start[atom+1] - start != ei::stencil_start[site+1] - ei::stencil_start[site]) continue;
+
+         // check all neighbour cells are on the grid
+         const int cell = index >> bits;
+         const int c[3] = { cell % D[0], (cell / D[0]) % D[1], cell / (D[0]*D[1]) };
+         bool ok = true;
+         for(int k = ei::stencil_start[site]; k < ei::stencil_start[site+1] && ok; k++){
+            const int d[3] = { ei::stencil_dx[k], ei::stencil_dy[k], ei::stencil_dz[k] };
+            for(int i = 0; i < 3; i++){
+               int n = c[i] + d[i];
+               if(wrap[i]){
+                  if(n < 0) n += D[i]; else if(n >= D[i]) n -= D[i];
+               }
+               if(n < 0 || n >= D[i]) ok = false;
+            }
+         }
+         if(!ok) continue;
+
+         // check stencil neighbours are identical to explicit list
+         const int* const explicit_nn = &atoms::neighbour_list_array[start];
+         ei::for_each_stencil_neighbour(atom, -2 - index, [&](const int k, const int natom){
+            if(natom != explicit_nn[k - ei::stencil_start[site]]) ok = false;
+         });
+         if(!ok) continue;
+
+         candidate[atom] = true;
+         std::string signature;
+         for(int nn = start; nn < csr_start[atom+1]; nn++) ei::append_exchange_constants(nn, signature);
+         signature_count[site][signature]++;
+         offset_count[site][neighbour_offsets(atom)]++;
+
+      }
+
+      // use most common exchange constants for each site in stencil
+      std::vector<std::string> site_signature(ns);
+      for(int site = 0; site < ns; site++){
+         int count = 0;
+         for(std::map<std::string, int>::const_iterator it = signature_count[site].begin(); it != signature_count[site].end(); ++it){
+            if(it->second > count){
+               count = it->second;
+               site_signature[site] = it->first;
+            }
+         }
+      }
+
+      // number of bits for number of interactions in encoded offset pattern
+      ei::stencil_count_bits = 0;
+      for(int site = 0; site < ns; site++){
+         while((1 << ei::stencil_count_bits) <= ei::stencil_start[site+1] - ei::stencil_start[site]) ei::stencil_count_bits++;
+      }
+
+      // save common patterns of neighbour offsets after stencil interactions, replacing count with encoded pattern (or -1)
+      ei::stencil_offset.assign(num_stencil, 0);
+      std::vector<int> entry_interaction(num_stencil);
+      for(int k = 0; k < num_stencil; k++) entry_interaction[k] = k;
+      for(int site = 0; site < ns; site++){
+         for(std::map<std::vector<int>, int>::iterator it = offset_count[site].begin(); it != offset_count[site].end(); ++it){
+            const int64_t start = ei::stencil_offset.size();
+            if(it->second < min_pattern_atoms || ((start + 1) << ei::stencil_count_bits) > INT_MAX){
+               it->second = -1;
+               continue;
+            }
+            it->second = (start << ei::stencil_count_bits) | int64_t(it->first.size());
+            for(size_t q = 0; q < it->first.size(); q++){
+               ei::stencil_offset.push_back(it->first[q]);
+               entry_interaction.push_back(ei::stencil_start[site] + q);
+            }
+         }
+      }
+      const int num_entries = ei::stencil_offset.size();
+
+      ei::stencil_index_array.assign(num_atoms, -1);
+      std::vector<bool> site_set(ns, false);
+      int num_stencil_atoms = 0;
+      int num_lookup_atoms = 0;
+
+      switch(ei::exchange_type){
+         case exchange::isotropic:
+            ei::stencil_jxx.resize(num_entries);
+            break;
+         case exchange::vectorial:
+            ei::stencil_jxx.resize(num_entries);
+            ei::stencil_jyy.resize(num_entries);
+            ei::stencil_jzz.resize(num_entries);
+            break;
+         case exchange::tensorial:
+            ei::stencil_tensor_id.resize(num_entries);
+            break;
+      }
+
+      for(int atom = 0; atom < num_atoms; atom++){
+
+         if(!candidate[atom]) continue;
+
+         const int index = grid_index[atom];
+         const int site = index & mask;
+         std::string signature;
+         for(int nn = csr_start[atom]; nn < csr_start[atom+1]; nn++) ei::append_exchange_constants(nn, signature);
+         if(signature != site_signature[site]) continue;
+
+         // atoms without a common pattern of offsets use grid lookup, encoded as -2-index
+         const int pattern = offset_count[site][neighbour_offsets(atom)];
+         ei::stencil_index_array[atom] = pattern >= 0 ? pattern : -2 - index;
+         num_stencil_atoms++;
+         if(pattern < 0) num_lookup_atoms++;
+
+         // save exchange constants for site from first matching atom
+         if(!site_set[site]){
+            site_set[site] = true;
+            const int start = csr_start[atom];
+            for(int k = ei::stencil_start[site]; k < ei::stencil_start[site+1]; k++){
+               const int nn = start + k - ei::stencil_start[site];
+               switch(ei::exchange_type){
+                  case exchange::isotropic:
+                     ei::stencil_jxx[k] = ei::csr_jxx[nn];
+                     break;
+                  case exchange::vectorial:
+                     ei::stencil_jxx[k] = ei::csr_jxx[nn];
+                     ei::stencil_jyy[k] = ei::csr_jyy[nn];
+                     ei::stencil_jzz[k] = ei::csr_jzz[nn];
+                     break;
+                  case exchange::tensorial:
+                     ei::stencil_tensor_id[k] = ei::csr_tensor_id_16.empty() ? ei::csr_tensor_id_32[nn] : uint32_t(ei::csr_tensor_id_16[nn]);
+                     break;
+               }
+            }
+         }
+
+      }
+
+      if(num_stencil_atoms == 0){
+         zlog << zTs() << "\tNo atoms match the unit cell stencil; using explicit neighbour lists" << std::endl;
+         ei::clear_stencil();
+         return;
+      }
+
+      // copy exchange constants to offset patterns
+      for(int e = num_stencil; e < num_entries; e++){
+         const int k = entry_interaction[e];
+         if(!ei::stencil_jxx.empty()) ei::stencil_jxx[e] = ei::stencil_jxx[k];
+         if(!ei::stencil_jyy.empty()) ei::stencil_jyy[e] = ei::stencil_jyy[k];
+         if(!ei::stencil_jzz.empty()) ei::stencil_jzz[e] = ei::stencil_jzz[k];
+         if(!ei::stencil_tensor_id.empty()) ei::stencil_tensor_id[e] = ei::stencil_tensor_id[k];
+      }
+
+      //------------------------------------------------------------------------
+      // Remove exchange constants of stencil atoms from compact list
+      //------------------------------------------------------------------------
+      const int64_t old_interactions = atoms::neighbour_list_array.size();
+      double bytes_per_interaction = 0.0;
+      if(!ei::csr_jxx.empty()) bytes_per_interaction += sizeof(double);
+      if(!ei::csr_jyy.empty()) bytes_per_interaction += sizeof(double);
+      if(!ei::csr_jzz.empty()) bytes_per_interaction += sizeof(double);
+      if(!ei::csr_tensor_id_16.empty()) bytes_per_interaction += sizeof(uint16_t);
+      if(!ei::csr_tensor_id_32.empty()) bytes_per_interaction += sizeof(uint32_t);
+      const double old_bytes = bytes_per_interaction * double(old_interactions);
+      int counter = 0;
+      for(int atom = 0; atom < num_atoms; atom++){
+         const int start = ei::csr_start_index[atom];
+         const int end   = ei::csr_start_index[atom+1];
+         ei::csr_start_index[atom] = counter;
+         if(ei::stencil_index_array[atom] != -1) continue;
+         for(int nn = start; nn < end; nn++){
+            if(!ei::csr_jxx.empty()) ei::csr_jxx[counter] = ei::csr_jxx[nn];
+            if(!ei::csr_jyy.empty()) ei::csr_jyy[counter] = ei::csr_jyy[nn];
+            if(!ei::csr_jzz.empty()) ei::csr_jzz[counter] = ei::csr_jzz[nn];
+            if(!ei::csr_tensor_id_16.empty()) ei::csr_tensor_id_16[counter] = ei::csr_tensor_id_16[nn];
+            if(!ei::csr_tensor_id_32.empty()) ei::csr_tensor_id_32[counter] = ei::csr_tensor_id_32[nn];
+            counter++;
+         }
+      }
+      ei::csr_start_index[num_atoms] = counter;
+
+      // release memory of removed interactions
+      if(!ei::csr_jxx.empty()) std::vector<double>(ei::csr_jxx.begin(), ei::csr_jxx.begin() + counter).swap(ei::csr_jxx);
+      if(!ei::csr_jyy.empty()) std::vector<double>(ei::csr_jyy.begin(), ei::csr_jyy.begin() + counter).swap(ei::csr_jyy);
+      if(!ei::csr_jzz.empty()) std::vector<double>(ei::csr_jzz.begin(), ei::csr_jzz.begin() + counter).swap(ei::csr_jzz);
+      if(!ei::csr_tensor_id_16.empty()) std::vector<uint16_t>(ei::csr_tensor_id_16.begin(), ei::csr_tensor_id_16.begin() + counter).swap(ei::csr_tensor_id_16);
+      if(!ei::csr_tensor_id_32.empty()) std::vector<uint32_t>(ei::csr_tensor_id_32.begin(), ei::csr_tensor_id_32.begin() + counter).swap(ei::csr_tensor_id_32);
+
+      ei::stencil_active = true;
+
+      // estimate memory for inline exchange constants before and after
+      const double new_bytes = bytes_per_interaction * double(counter) + double(sizeof(int))*double(num_atoms + grid_size + num_entries);
+
+      // neighbour list retained for energy, micromagnetic and GPU calculations
+      const double list_bytes = double(sizeof(int))*double(old_interactions + 2*num_atoms);
+
+      zlog << zTs() << "\tLattice stencil used for " << num_stencil_atoms << " of " << num_atoms << " atoms on rank " << vmpi::my_rank
+           << " (" << num_lookup_atoms << " by grid lookup) with " << counter << " explicit interactions" << std::endl;
+      zlog << zTs() << "\tExchange constant memory reduced from " << old_bytes*1.0e-6 << " MB to " << new_bytes*1.0e-6 << " MB" << std::endl;
+      zlog << zTs() << "\tAtomic neighbour list of " << list_bytes*1.0e-6 << " MB is retained" << std::endl;
+
+      return;
+
+   }
+
+} // end of exchange namespace
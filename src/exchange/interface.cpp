@@ -97,6 +97,11 @@ namespace exchange{
          else internal::exchange_factor = 1.0;
          return true;
       }
+      //--------------------------------------------------------------------
+      if( word == "lattice-stencil" ){
+         internal::lattice_stencil = vin::check_for_valid_bool(value, word, line, prefix,"input");
+         return true;
+      }
       //-------------------------------------------------------------------
       test="four-spin-cutoff-1";
       if(word==test){
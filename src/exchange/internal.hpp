@@ -20,6 +20,7 @@
 //---------------------------------------------------------------------
 
 // C++ standard library headers
+#include <cstdint>
 
 // Vampire headers
 #include "exchange.hpp"
@@ -242,36 +243,100 @@ namespace exchange{
       extern std::vector <int> biquadratic_neighbour_list_start_index; // list of first biquadratic neighbour for atom i
       extern std::vector <int> biquadratic_neighbour_list_end_index;   // list of last biquadratic neighbour for atom i
 
-      extern std::vector <int> four_spin_neighbour_list_array_j; // 1D list of j neighbours
-      extern std::vector <int> four_spin_neighbour_list_array_k; // 1D list of k neighnours
-      extern std::vector <int> four_spin_neighbour_list_array_l; // 1D list of l neighbours
-      extern std::vector <int> four_spin_neighbour_list_array_i; // 1D list of l neighbours
-      extern std::vector <int> four_spin_neighbour_list_start_index; // list of first four spin neighbour for atom i
-      extern std::vector <int> four_spin_neighbour_list_end_index;   // list of last four spin neighbours for atom i
-      extern std::vector <double> four_spin_exchange_list;   // value of fourspin
+      extern std::vector <int> four_spin_start_index;     // offset of first quadruplet for central atom i (num_atoms+1)
+      extern std::vector <int> four_spin_neighbour_array; // j, k and l atoms of each quadruplet grouped by central atom
+      extern std::vector <double> four_spin_exchange_list; // value of four spin constant for each quadruplet
+
+      extern std::vector <int> csr_start_index;       // offset of inline exchange constants of first neighbour for atom i (num_atoms+1)
+      extern std::vector <uint16_t> csr_tensor_id_16; // index of unique tensor for each pair (tensorial exchange, < 65536 tensors)
+      extern std::vector <uint32_t> csr_tensor_id_32; // index of unique tensor for each pair (tensorial exchange, otherwise)
+      extern std::vector <double> csr_jxx; // inline exchange constants for each pair (isotropic uses xx only)
+      extern std::vector <double> csr_jyy;
+      extern std::vector <double> csr_jzz;
+
+      extern bool fused_biquadratic;      // flag set when biquadratic exchange shares the bilinear compact list
+      extern std::vector <double> csr_jbq; // inline isotropic biquadratic exchange constants for each pair of fused list
 
       extern std::vector <exchange::internal::value_t > bq_i_exchange_list; // list of isotropic biquadratic exchange constants
       extern std::vector <exchange::internal::vector_t> bq_v_exchange_list; // list of vectorial biquadratic exchange constants
       extern std::vector <exchange::internal::tensor_t> bq_t_exchange_list; // list of tensorial biquadratic exchange constants
 
+      extern bool lattice_stencil; // flag to enable lattice stencil form of exchange list
+      extern bool stencil_active;  // flag set when atoms use the lattice stencil
+      extern int stencil_site_bits; // number of bits for unit cell site in stencil grid index
+      extern int stencil_dims[3];   // number of unit cells in local stencil grid
+      extern std::vector <int> stencil_start;  // first stencil interaction for each unit cell site (num_sites+1)
+      extern std::vector <int> stencil_dx;     // unit cell offsets for each stencil interaction
+      extern std::vector <int> stencil_dy;
+      extern std::vector <int> stencil_dz;
+      extern std::vector <int> stencil_site;   // unit cell site of neighbour for each stencil interaction
+      extern int stencil_count_bits; // number of bits for number of interactions in encoded offset pattern
+      extern std::vector <int> stencil_offset; // offset in atom number of neighbour for each entry in offset patterns
+      extern std::vector <double> stencil_jxx; // exchange constants for each stencil interaction, followed by offset patterns
+      extern std::vector <double> stencil_jyy;
+      extern std::vector <double> stencil_jzz;
+      extern std::vector <uint32_t> stencil_tensor_id; // index of unique tensor for each stencil interaction, followed by offset patterns
+      extern std::vector <int> stencil_index_array; // encoded offset pattern (or -2-stencil grid index) for each atom, or -1 for explicit neighbour list
+      extern std::vector <int> stencil_atom_map;    // atom at each stencil grid point, or -1 if missing
+
       //-------------------------------------------------------------------------
       // Internal function declarations
       //-------------------------------------------------------------------------
-      void calculate_dmi(std::vector<std::vector <neighbours::neighbour_t> >& cneighbourlist);
-      void calculate_kitaev(std::vector<std::vector <neighbours::neighbour_t> >& cneighbourlist);
-      void unroll_exchange_interactions(std::vector<std::vector <neighbours::neighbour_t> >& bilinear);
-      void unroll_normalised_exchange_interactions(std::vector<std::vector <neighbours::neighbour_t> >& bilinear);
+      void calculate_dmi(neighbours::list_t& cneighbourlist);
+      void calculate_kitaev(neighbours::list_t& cneighbourlist);
+      void unroll_exchange_interactions(neighbours::list_t& bilinear);
+      void unroll_normalised_exchange_interactions(neighbours::list_t& bilinear);
       void unroll_normalised_biquadratic_exchange_interactions();
+      void deduplicate_tensorial_exchange();
+      void initialize_csr_exchange();
+      void initialize_fused_biquadratic_exchange();
+
+      //-------------------------------------------------------------------------
+      // Function to call f(k, natom) for each stencil interaction k of an atom.
+      // Most atoms have neighbours at one of a few patterns of offsets in atom
+      // number, encoded as (start << count_bits) | count, with the interaction
+      // k running over the entries of the pattern. For other atoms the
+      // neighbours are looked up in the grid of (unit cell, site), with index
+      // encoded as -2-((cell << site_bits) | site), wrapping at (periodic) grid
+      // boundaries, and k is the unit cell interaction.
+      //-------------------------------------------------------------------------
+      template <typename F>
+      inline void for_each_stencil_neighbour(const int atom, const int encoded_index, F f){
+
+         if(encoded_index >= 0){
+            const int start = encoded_index >> stencil_count_bits;
+            const int end   = start + (encoded_index & ((1 << stencil_count_bits) - 1));
+            const int* const offset = stencil_offset.data();
+            for(int k = start; k < end; ++k) f(k, atom + offset[k]);
+         }
+         else{
+            const int* const map = stencil_atom_map.data();
+            const int index = -2 - encoded_index;
+            const int site  = index & ((1 << stencil_site_bits) - 1);
+            const int cell  = index >> stencil_site_bits;
+            const int cx    = cell % stencil_dims[0];
+            const int cy    = (cell / stencil_dims[0]) % stencil_dims[1];
+            const int cz    = cell / (stencil_dims[0]*stencil_dims[1]);
+            const int end   = stencil_start[site+1];
+            for(int k = stencil_start[site]; k < end; ++k){
+               int nx = cx + stencil_dx[k];
+               int ny = cy + stencil_dy[k];
+               int nz = cz + stencil_dz[k];
+               if(nx < 0) nx += stencil_dims[0]; else if(nx >= stencil_dims[0]) nx -= stencil_dims[0];
+               if(ny < 0) ny += stencil_dims[1]; else if(ny >= stencil_dims[1]) ny -= stencil_dims[1];
+               if(nz < 0) nz += stencil_dims[2]; else if(nz >= stencil_dims[2]) nz -= stencil_dims[2];
+               f(k, map[(((nz*stencil_dims[1] + ny)*stencil_dims[0] + nx) << stencil_site_bits) + stencil_site[k]]);
+            }
+         }
+
+         return;
+
+      }
+
       void exchange_fields(const int start_index, // first atom for exchange interactions to be calculated
                            const int end_index, // last +1 atom to be calculated
                            const std::vector<int>& neighbour_list_start_index,
-                           const std::vector<int>& neighbour_list_end_index,
-                           const std::vector<int>& type_array, // type for atom
                            const std::vector<int>& neighbour_list_array, // list of interactions between atoms
-                           const std::vector<int>& neighbour_interaction_type_array, // list of interaction type for each pair of atoms with value given in exchange list
-                           const std::vector<zval_t>& i_exchange_list, // list of isotropic exchange constants
-                           const std::vector<zvec_t>& v_exchange_list, // list of vectorial exchange constants
-                           const std::vector<zten_t>& t_exchange_list, // list of tensorial exchange constants
                            const std::vector<double>& spin_array_x, // spin vectors for atoms
                            const std::vector<double>& spin_array_y,
                            const std::vector<double>& spin_array_z,
@@ -296,6 +361,18 @@ namespace exchange{
                                        std::vector<double>& field_array_y,
                                        std::vector<double>& field_array_z);
 
+      void fused_biquadratic_exchange_fields(const int start_index, // first atom for exchange interactions to be calculated
+                                             const int end_index, // last +1 atom to be calculated
+                                             const std::vector<int>& neighbour_list_start_index,
+                                             const std::vector<int>& neighbour_list_end_index,
+                                             const std::vector<int>& neighbour_list_array, // list of interactions between atoms
+                                             const std::vector<double>& spin_array_x, // spin vectors for atoms
+                                             const std::vector<double>& spin_array_y,
+                                             const std::vector<double>& spin_array_z,
+                                             std::vector<double>& field_array_x, // field vectors for atoms
+                                             std::vector<double>& field_array_y,
+                                             std::vector<double>& field_array_z);
+
       void four_spin_exchange_fields(const int start_index, // first atom for exchange interactions to be calculated
                                      const int end_index, // last +1 atom to be calculated
                                      std::vector<double>& field_array_x, // field vectors for atoms
@@ -303,7 +380,7 @@ namespace exchange{
                                      std::vector<double>& field_array_z);
 
       void initialize_biquadratic_exchange();
-      void initialize_four_spin_exchange(std::vector<std::vector <neighbours::neighbour_t> >& cneighbourlist);
+      void initialize_four_spin_exchange(neighbours::list_t& cneighbourlist);
 
    } // end of internal namespace
 
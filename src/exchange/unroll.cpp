@@ -29,7 +29,7 @@ namespace exchange{
    //----------------------------------------------------------------------------
    // Function to unroll neighbour list into 1D
    //----------------------------------------------------------------------------
-   void unroll_exchange_interactions(std::vector<std::vector <neighbours::neighbour_t> >& bilinear){
+   void unroll_exchange_interactions(neighbours::list_t& bilinear){
 
       // if dmi is enabled then set exchange type to force normalised tensor form of exchange
       if(internal::enable_dmi || internal::enable_kitaev){
@@ -34,7 +34,7 @@ namespace exchange{
    // This requires additional memory since each interaction is potentially
    // unique, requiring that the whole exchange list be unrolled
    //----------------------------------------------------------------------------
-   void unroll_normalised_exchange_interactions(std::vector<std::vector <neighbours::neighbour_t> >& bilinear2){
+   void unroll_normalised_exchange_interactions(neighbours::list_t& bilinear2){
 
    	// temporary class variables
    	zval_t tmp_zval;
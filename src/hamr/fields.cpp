@@ -13,6 +13,7 @@
 
 // Vampire headers
 #include "atoms.hpp"
+#include "create.hpp"
 #include "errors.hpp"
 #include "hamr.hpp"
 #include "material.hpp"
@@ -43,9 +44,15 @@ namespace hamr{
 		const double Hloc_parity_field=H_applied;
 
 		// Add localised thermal field
-		generate (hamr::internal::x_field_array.begin()+start_index,hamr::internal::x_field_array.begin()+end_index, mtrandom::gaussian);
-		generate (hamr::internal::y_field_array.begin()+start_index,hamr::internal::y_field_array.begin()+end_index, mtrandom::gaussian);
-		generate (hamr::internal::z_field_array.begin()+start_index,hamr::internal::z_field_array.begin()+end_index, mtrandom::gaussian);
+		if(mtrandom::counter_based_noise){
+			mtrandom::counter_gaussian_fill(mtrandom::hamr_stream, start_index, end_index, create::global_atom_id,
+			                                hamr::internal::x_field_array, hamr::internal::y_field_array, hamr::internal::z_field_array);
+		}
+		else{
+			generate (hamr::internal::x_field_array.begin()+start_index,hamr::internal::x_field_array.begin()+end_index, mtrandom::gaussian);
+			generate (hamr::internal::y_field_array.begin()+start_index,hamr::internal::y_field_array.begin()+end_index, mtrandom::gaussian);
+			generate (hamr::internal::z_field_array.begin()+start_index,hamr::internal::z_field_array.begin()+end_index, mtrandom::gaussian);
+		}
 
 		if(hamr::head_laser_on){
 
@@ -67,6 +67,10 @@ namespace hierarchical{
       std::vector<double> rij_tensor_yz;
       std::vector<double> rij_tensor_zz;
 
+      std::vector < int > interactions_start_index;             // start of interactions for each local cell
+      std::vector < interaction_t<double> > interactions;       // compact list of non-zero interactions
+      std::vector < interaction_t<float> > interactions_sp;     // single precision compact interactions
+
       std::vector<double> ha_cells_pos_and_mom_array;    //
       std::vector < int > ha_proc_cell_index_array1D;    //
 
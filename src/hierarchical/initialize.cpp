@@ -765,6 +765,9 @@ void initialize(const double system_dimensions_x,
    timer.stop();
    segment_time[8] = timer.elapsed_time();
 
+   // pack non-zero interactions into compact lists for field update
+   ha::initialize_compact_interactions(cells_num_local_cells);
+
    //---------------------------------------------------------------------------
    // Output detailed timings for the hierarchical initialisation
    //---------------------------------------------------------------------------
@@ -0,0 +1,121 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2024. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+#include <vector>
+
+// Vampire headers
+#include "dipole.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// hierarchical module headers
+#include "internal.hpp"
+#include "../dipole/internal.hpp"
+
+// alias internal hierarchical namespace for brevity
+namespace ha = hierarchical::internal;
+
+namespace hierarchical{
+
+namespace internal{
+
+   //---------------------------------------------------------------------------
+   // Function to copy non-zero interactions of local cells into compact list
+   //---------------------------------------------------------------------------
+   template <typename T>
+   void compact_interactions(const int cells_num_local_cells, std::vector< interaction_t<T> >& list){
+
+      list.clear();
+      ha::interactions_start_index.assign(cells_num_local_cells+1, 0);
+
+      for(int lc = 0; lc < cells_num_local_cells; lc++){
+
+         ha::interactions_start_index[lc] = list.size();
+
+         const int start = ha::interaction_list_start_index[lc];
+         const int end   = std::max(start, ha::interaction_list_end_index[lc]);
+
+         for(int j = start; j < end; j++){
+
+            // skip interactions without a tensor (empty cells)
+            if(ha::rij_tensor_xx[j] == 0.0 && ha::rij_tensor_xy[j] == 0.0 && ha::rij_tensor_xz[j] == 0.0 &&
+               ha::rij_tensor_yy[j] == 0.0 && ha::rij_tensor_yz[j] == 0.0 && ha::rij_tensor_zz[j] == 0.0) continue;
+
+            interaction_t<T> interaction;
+            interaction.cell = ha::interaction_list[j];
+            interaction.xx = ha::rij_tensor_xx[j];
+            interaction.xy = ha::rij_tensor_xy[j];
+            interaction.xz = ha::rij_tensor_xz[j];
+            interaction.yy = ha::rij_tensor_yy[j];
+            interaction.yz = ha::rij_tensor_yz[j];
+            interaction.zz = ha::rij_tensor_zz[j];
+            list.push_back(interaction);
+
+         }
+
+      }
+
+      ha::interactions_start_index[cells_num_local_cells] = list.size();
+
+      // release spare capacity
+      std::vector< interaction_t<T> >(list).swap(list);
+
+      return;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to initialise compact interaction lists for field update
+   //
+   // Each interaction of a local cell stores the interacting hierarchical cell
+   // and the six unique components of the symmetric tensor together, so that
+   // the update streams through a single array. Interactions with zero tensors
+   // (cells without atoms) contribute nothing and are dropped. The tensors are
+   // stored in single or double precision depending on dipole:precision, and
+   // the separate tensor component arrays are then released.
+   //---------------------------------------------------------------------------
+   void initialize_compact_interactions(const int cells_num_local_cells){
+
+      const size_t num_interactions = ha::interaction_list.size();
+
+      double bytes = 0.0;
+      if(dipole::internal::single_precision){
+         compact_interactions(cells_num_local_cells, ha::interactions_sp);
+         bytes = double(ha::interactions_sp.size())*sizeof(interaction_t<float>);
+      }
+      else{
+         compact_interactions(cells_num_local_cells, ha::interactions);
+         bytes = double(ha::interactions.size())*sizeof(interaction_t<double>);
+      }
+
+      const size_t num_compact = ha::interactions_start_index[cells_num_local_cells];
+
+      // free tensor component arrays
+      std::vector<double>().swap(ha::rij_tensor_xx);
+      std::vector<double>().swap(ha::rij_tensor_xy);
+      std::vector<double>().swap(ha::rij_tensor_xz);
+      std::vector<double>().swap(ha::rij_tensor_yy);
+      std::vector<double>().swap(ha::rij_tensor_yz);
+      std::vector<double>().swap(ha::rij_tensor_zz);
+
+      zlog << zTs() << "\tCompacted hierarchical interactions from " << num_interactions << " to " << num_compact << " on rank " << vmpi::my_rank
+           << " (" << bytes/1.0e6 << " MB)" << std::endl;
+
+      return;
+
+   }
+
+} // end of internal namespace
+
+} // end of hierarchical namespace
@@ -36,6 +36,13 @@ namespace hierarchical{
       // Internal data type definitions
       //-------------------------------------------------------------------------
 
+      // compact cell-cell interaction with symmetric dipole tensor
+      template <typename T>
+      struct interaction_t{
+         int cell; // hierarchical cell ID (any level)
+         T xx, xy, xz, yy, yz, zz; // unique tensor components
+      };
+
       extern int num_levels;
       //create arrays for data storage
       extern std::vector < double > cell_positions;
@@ -70,6 +77,11 @@ namespace hierarchical{
       extern std::vector<double> rij_tensor_yz;
       extern std::vector<double> rij_tensor_zz;
 
+      // compact lists of non-zero interactions for each local cell [lc]
+      extern std::vector < int > interactions_start_index;
+      extern std::vector < interaction_t<double> > interactions;
+      extern std::vector < interaction_t<float> > interactions_sp; // single precision
+
 
       extern double av_cell_size;
 
@@ -84,7 +96,8 @@ namespace hierarchical{
                                                 std::vector <double>& y_spin_array,
                                                 std::vector <double>& z_spin_array,
                                                 std::vector <double>& m_spin_array, // atomic spin moment
-                                                std::vector < bool >& magnetic);    // is magnetic);
+                                                std::vector < bool >& magnetic,     // is magnetic
+                                                const bool update_magnetisation);   // update cell magnetisation
 
       // new version of inter tensor method
       void calc_inter(const int celli,                                                // global ID of cell i
@@ -105,6 +118,8 @@ namespace hierarchical{
                       const std::vector< std::vector<double> >& atoms_in_cells_array  // output array of positions and moments of atoms in cells
                      );
 
+      void initialize_compact_interactions(const int cells_num_local_cells);
+
       void calc_tensor(int cells_num_local_cells,
                        std::vector < std::vector < double > >& cells_atom_in_cell_coords_array_x,
                        std::vector < std::vector < double > >& cells_atom_in_cell_coords_array_y,
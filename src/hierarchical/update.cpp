@@ -33,122 +33,103 @@ namespace ha = hierarchical::internal;
 
 namespace hierarchical{
 
+namespace internal{
+
 //------------------------------------------------------------------------------
-// Function to update hierarchical cell magnetization and compute dipole field
+// Function to compute dipole fields for local cells from compact interactions
+//
+// Each local cell is independent and so cells are distributed between
+// threads. Tensors are stored in double or single precision (T) but the field
+// is always accumulated in double precision.
 //------------------------------------------------------------------------------
-void update(std::vector <double>& x_spin_array, // atomic spin directions
-            std::vector <double>& y_spin_array,
-            std::vector <double>& z_spin_array,
-            std::vector <double>& m_spin_array, // atomic spin moment
-            std::vector < bool >& magnetic){ // is magnetic
+template <typename T>
+void update_cell_fields(const std::vector< interaction_t<T> >& interactions){
 
    // inverse Bohr magneton
    const double imuB = 1.0/9.27400915e-24;
 
-   // update hierarchical magnetization in cells
-   hierarchical::internal::calculate_hierarchical_magnetisation(x_spin_array, y_spin_array, z_spin_array, m_spin_array, magnetic);
+   const int num_local_cells = dipole::internal::cells_num_local_cells;
 
-   // instantiate timer
-   vutil::vtimer_t timer;
-
-   // start timer
-   timer.start();
-
-   // initialise cell fields to a large negative number for MPI reduction
-   for (int i = 0 ; i < cells::num_cells; i ++){
-      dipole::cells_field_array_x[i] = -100000.0;
-      dipole::cells_field_array_y[i] = -100000.0;
-      dipole::cells_field_array_z[i] = -100000.0;
-   }
-
-   // Compute dipole fields for all cells with atoms (local cells)
-	for(int lc = 0; lc < dipole::internal::cells_num_local_cells; lc++){
+   #pragma omp parallel for schedule(dynamic, 16) num_threads(sim::num_threads)
+   for(int lc = 0; lc < num_local_cells; lc++){
 
       // get global cell ID from local cell list
-      int cell_i = cells::cell_id_array[lc];
-
-      // Store range of hierarchical cells contributing to dipole field for lc cell
-      const int start = ha::interaction_list_start_index[lc];
-      const int end = ha::interaction_list_end_index[lc];
+      const int cell_i = cells::cell_id_array[lc];
 
       // Self demagnetisation factor multiplying m(i)
-      const double V = dipole::internal::cells_volume_array[cell_i];
-      const double eightPI_three_cell_volume = 8.0*M_PI/(3.0*V);
-      const double self_demag = eightPI_three_cell_volume;
-      //std::cout << self_demag << std::endl;
+      const double self_demag = 8.0*M_PI/(3.0*dipole::internal::cells_volume_array[cell_i]);
 
       // Normalise cell magnetisation by the Bohr magneton
       const double mx_i = cells::mag_array_x[cell_i]*imuB;
       const double my_i = cells::mag_array_y[cell_i]*imuB;
       const double mz_i = cells::mag_array_z[cell_i]*imuB;
-      // std::cout << cell_i << '\t' << mx_i << '\t' << my_i << '\t' << mz_i << std::endl;
-
-      // Add self-demagnetisation as mu_0/4_PI * 8PI*m_cell/3V
-      dipole::cells_field_array_x[cell_i] = self_demag * mx_i; //*0.0
-      dipole::cells_field_array_y[cell_i] = self_demag * my_i; //*0.0
-      dipole::cells_field_array_z[cell_i] = self_demag * mz_i; //*0.0
-
-      // Add self demag to Hdemag --> To get only dipole-dipole contribution comment this and initialise to zero
-      dipole::cells_mu0Hd_field_array_x[cell_i] = -0.5*self_demag * mx_i;
-      dipole::cells_mu0Hd_field_array_y[cell_i] = -0.5*self_demag * my_i;
-      dipole::cells_mu0Hd_field_array_z[cell_i] = -0.5*self_demag * mz_i;
 
-      // Loop over all cells
-      for(int j = start; j<end;j++){
+      // Compute dipole field contribution from all interacting hierarchical cells using symmetric tensor
+      double hx = 0.0;
+      double hy = 0.0;
+      double hz = 0.0;
 
-         // get cell ID of neighbouring cell
-         int cell_j = ha::interaction_list[j];
+      const int start = ha::interactions_start_index[lc];
+      const int end   = ha::interactions_start_index[lc+1];
 
-         const double mx = ha::mag_array_x[cell_j];//*imuB;
-         const double my = ha::mag_array_y[cell_j];//*imuB;
-         const double mz = ha::mag_array_z[cell_j];//*imuB;
+      for(int j = start; j < end; j++){
 
-         //    if (cell_i == 389)  std::cout << cell_j << '\t' << mx << '\t' << my << '\t' << mz<< "\t" << cell_i << '\t' << std::endl;
-         //if (cell_i == 0)std::cout<< cell_i << '\t' << mx_i << '\t' << my_i << '\t' << mz_i << "\t" <<  cell_j << '\t' << mx << '\t' << my << '\t' << mz <<std::endl;
+         const interaction_t<T>& in = interactions[j];
 
-         // Compute dipole field contribution using dipole tensor
-         dipole::cells_field_array_x[cell_i]      +=(mx*ha::rij_tensor_xx[j] + my*ha::rij_tensor_xy[j] + mz*ha::rij_tensor_xz[j]);
-         dipole::cells_field_array_y[cell_i]      +=(mx*ha::rij_tensor_xy[j] + my*ha::rij_tensor_yy[j] + mz*ha::rij_tensor_yz[j]);
-         dipole::cells_field_array_z[cell_i]      +=(mx*ha::rij_tensor_xz[j] + my*ha::rij_tensor_yz[j] + mz*ha::rij_tensor_zz[j]);
+         const double mx = ha::mag_array_x[in.cell];
+         const double my = ha::mag_array_y[in.cell];
+         const double mz = ha::mag_array_z[in.cell];
 
-         // Demag field
-         dipole::cells_mu0Hd_field_array_x[cell_i] +=(mx*ha::rij_tensor_xx[j] + my*ha::rij_tensor_xy[j] + mz*ha::rij_tensor_xz[j]);
-         dipole::cells_mu0Hd_field_array_y[cell_i] +=(mx*ha::rij_tensor_xy[j] + my*ha::rij_tensor_yy[j] + mz*ha::rij_tensor_yz[j]);
-         dipole::cells_mu0Hd_field_array_z[cell_i] +=(mx*ha::rij_tensor_xz[j] + my*ha::rij_tensor_yz[j] + mz*ha::rij_tensor_zz[j]);
-         // std::cout << rij_tensor_xx[j] << '\t' << rij_tensor_xy[j] << '\t' << rij_tensor_xz[j] << '\t' << rij_tensor_yy[j] << '\t' << rij_tensor_yz[j] << '\t' << rij_tensor_zz[j] << '\t' <<std::endl;
+         hx += mx*in.xx + my*in.xy + mz*in.xz;
+         hy += mx*in.xy + my*in.yy + mz*in.yz;
+         hz += mx*in.xz + my*in.yz + mz*in.zz;
 
       }
-      //   std::cout <<"D\t" << cell_i << '\t' << dipole::cells_field_array_x[cell_i] <<'\t' << dipole::cells_field_array_y[cell_i] <<'\t' << dipole::cells_field_array_z[cell_i] <<std::endl;
 
-      // Multiply Hdemg by mu_0/4pi * 1e30 * mu_B to account for normalisation of magnetisation and volume in angstrom
-      dipole::cells_field_array_x[cell_i] = dipole::cells_field_array_x[cell_i] * 9.27400915e-01;
-      dipole::cells_field_array_y[cell_i] = dipole::cells_field_array_y[cell_i] * 9.27400915e-01;
-      dipole::cells_field_array_z[cell_i] = dipole::cells_field_array_z[cell_i] * 9.27400915e-01;
-      //std::cout << sim::time << '\t' << cell_i << '\t' << dipole::cells_field_array_x[cell_i] << '\t' << dipole::cells_field_array_y[cell_i] << '\t' << dipole::cells_field_array_z[cell_i] << '\t' << std::endl;
-      //std::cout << "SP" << dipole::cells_field_array_x[cell_i] << "\t" << dipole::cells_field_array_y[cell_i] << '\t' << dipole::cells_field_array_z[cell_i]<< std::endl;
+      // Add self-demagnetisation as mu_0/4_PI * 8PI*m_cell/3V and multiply by mu_0/4pi * 1e30 * mu_B
+      // to account for normalisation of magnetisation and volume in angstrom
+      dipole::cells_field_array_x[cell_i] = (self_demag * mx_i + hx) * 9.27400915e-01;
+      dipole::cells_field_array_y[cell_i] = (self_demag * my_i + hy) * 9.27400915e-01;
+      dipole::cells_field_array_z[cell_i] = (self_demag * mz_i + hz) * 9.27400915e-01;
 
-      // Multiply Hdemg by mu_0/4pi * 1e30 * mu_B to account for normalisation of magnetisation and volume in angstrom
-      dipole::cells_mu0Hd_field_array_x[cell_i] = dipole::cells_mu0Hd_field_array_x[cell_i] * 9.27400915e-01;
-      dipole::cells_mu0Hd_field_array_y[cell_i] = dipole::cells_mu0Hd_field_array_y[cell_i] * 9.27400915e-01;
-      dipole::cells_mu0Hd_field_array_z[cell_i] = dipole::cells_mu0Hd_field_array_z[cell_i] * 9.27400915e-01;
-      //if (cell_i == 0) std::cout << sim::time << '\t' << cell_i << '\t' <<  dipole::cells_field_array_x[cell_i] << '\t' << dipole::cells_field_array_y[cell_i] << '\t' << dipole::cells_field_array_z[cell_i] << '\t' << std::endl;
+      // Demag field includes self demag as -1/2 * 8PI*m_cell/3V
+      dipole::cells_mu0Hd_field_array_x[cell_i] = (-0.5*self_demag * mx_i + hx) * 9.27400915e-01;
+      dipole::cells_mu0Hd_field_array_y[cell_i] = (-0.5*self_demag * my_i + hy) * 9.27400915e-01;
+      dipole::cells_mu0Hd_field_array_z[cell_i] = (-0.5*self_demag * mz_i + hz) * 9.27400915e-01;
 
    }
 
-   #ifdef MPICF
-      // Reduce fields on all processors so all have correct field values
-      MPI_Allreduce(MPI_IN_PLACE, &dipole::cells_field_array_x[0], dipole::internal::cells_num_cells, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, &dipole::cells_field_array_y[0], dipole::internal::cells_num_cells, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, &dipole::cells_field_array_z[0], dipole::internal::cells_num_cells, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
-   #endif
-
-   // Check for cells with unrealistic fields from initialisation and zero
-   for (int i = 0 ; i < dipole::internal::cells_num_cells; i ++){
-      if (dipole::cells_field_array_x[i] < -1000) dipole::cells_field_array_x[i] = 0.0;
-      if (dipole::cells_field_array_y[i] < -1000) dipole::cells_field_array_y[i] = 0.0;
-      if (dipole::cells_field_array_z[i] < -1000) dipole::cells_field_array_z[i] = 0.0;
-      //  std::cout << i << '\t' << dipole::cells_field_array_x[i] << '\t' << dipole::cells_field_array_y[i] << '\t' << dipole::cells_field_array_z[i] <<std::endl;
-   }
+   return;
+
+}
+
+} // end of internal namespace
+
+//------------------------------------------------------------------------------
+// Function to update hierarchical cell magnetization and compute dipole field
+//------------------------------------------------------------------------------
+void update(std::vector <double>& x_spin_array, // atomic spin directions
+            std::vector <double>& y_spin_array,
+            std::vector <double>& z_spin_array,
+            std::vector <double>& m_spin_array, // atomic spin moment
+            std::vector < bool >& magnetic, // is magnetic
+            const bool update_magnetisation){ // update cell magnetisation
+
+   // update hierarchical magnetization in cells
+   hierarchical::internal::calculate_hierarchical_magnetisation(x_spin_array, y_spin_array, z_spin_array, m_spin_array, magnetic, update_magnetisation);
+
+   // instantiate timer
+   vutil::vtimer_t timer;
+
+   // start timer
+   timer.start();
+
+   // Compute dipole fields for all local cells
+   if(dipole::internal::single_precision) ha::update_cell_fields(ha::interactions_sp);
+   else ha::update_cell_fields(ha::interactions);
+
+   // exchange fields of cells needed by other processors
+   dipole::internal::exchange_cell_fields();
 
    timer.stop();
 
@@ -156,9 +156,17 @@ void mm::calculate_llg_external_fields(const double temperature,
       // calculate width of thermal field
       const double sigma_perp = sqrt( 2.0 * kB * temperature * mm::alpha_perp[cell] / ( mm::ms[cell] * mp::dt ) );
 
-      x_total_external_field_array[cell] = mm::ext_field[0] + sigma_perp*mtrandom::gaussian() + mm::pinning_field_x[cell];
-      y_total_external_field_array[cell] = mm::ext_field[1] + sigma_perp*mtrandom::gaussian() + mm::pinning_field_y[cell];
-      z_total_external_field_array[cell] = mm::ext_field[2] + sigma_perp*mtrandom::gaussian() + mm::pinning_field_z[cell];
+      double g[3];
+      if(mtrandom::counter_based_noise) mtrandom::counter_gaussian(mtrandom::micromagnetic_stream, cell, g);
+      else{
+         g[0] = mtrandom::gaussian();
+         g[1] = mtrandom::gaussian();
+         g[2] = mtrandom::gaussian();
+      }
+
+      x_total_external_field_array[cell] = mm::ext_field[0] + sigma_perp*g[0] + mm::pinning_field_x[cell];
+      y_total_external_field_array[cell] = mm::ext_field[1] + sigma_perp*g[1] + mm::pinning_field_y[cell];
+      z_total_external_field_array[cell] = mm::ext_field[2] + sigma_perp*g[2] + mm::pinning_field_z[cell];
 
    //   std::cout << pinning_field_y[cell] <<std::endl;
      // optionally add dipole field
@@ -201,6 +201,18 @@ int LLB( std::vector <int>& local_cell_array,
    //fill the noise terms
    for (int lc = 0; lc < number_of_micromagnetic_cells; lc++){
       int cell = list_of_micromagnetic_cells[lc];
+      if(mtrandom::counter_based_noise){
+         double g[3];
+         mtrandom::counter_gaussian(mtrandom::micromagnetic_stream, cell, g);
+         GW1x[cell] = g[0];
+         GW1y[cell] = g[1];
+         GW1z[cell] = g[2];
+         mtrandom::counter_gaussian(mtrandom::micromagnetic_parallel_stream, cell, g);
+         GW2x[cell] = g[0];
+         GW2y[cell] = g[1];
+         GW2z[cell] = g[2];
+         continue;
+      }
       GW1x[cell] = mtrandom::gaussian();
       GW1y[cell] = mtrandom::gaussian();
       GW1z[cell] = mtrandom::gaussian();
@@ -312,8 +312,6 @@ int cmc_mc_step(){
 	double delta_energy2;
 	double delta_energy21;
 
-	double Eold;
-	double Enew;
 
    std::vector<double> spin1_initial(3);
 	std::vector<double> spin1_final(3);
@@ -375,20 +373,14 @@ int cmc_mc_step(){
          // Make Monte Carlo move
          montecarlo::internal::mc_move(spin1_initial, spin1_final);
 
-			// Calculate current energy
-			Eold = sim::calculate_spin_energy(atom_number1);
+			// Calculate difference in Joules/mu_B
+			delta_energy1 = sim::calculate_spin_delta_energy(atom_number1, spin1_initial.data(), spin1_final.data())*mp::material[imat1].mu_s_SI*1.07828231e23; //1/9.27400915e-24
 
 			// Copy new spin position
 			atoms::x_spin_array[atom_number1] = spin1_final[0];
 			atoms::y_spin_array[atom_number1] = spin1_final[1];
 			atoms::z_spin_array[atom_number1] = spin1_final[2];
 
-			// Calculate new energy
-			Enew = sim::calculate_spin_energy(atom_number1);
-
-			// Calculate difference in Joules/mu_B
-			delta_energy1 = (Enew-Eold)*mp::material[imat1].mu_s_SI*1.07828231e23; //1/9.27400915e-24
-
 			// Check for lower energy state and accept unconditionally
 			if(delta_energy1<0){
             cmc::mc_success += 1.0;
@@ -430,20 +422,14 @@ int cmc_mc_step(){
 		spin1_fin_mvd[1]=cmc::cmc_mat[imat].ppolar_matrix[1][0]*spin1_final[0]+cmc::cmc_mat[imat].ppolar_matrix[1][1]*spin1_final[1]+cmc::cmc_mat[imat].ppolar_matrix[1][2]*spin1_final[2];
 		spin1_fin_mvd[2]=cmc::cmc_mat[imat].ppolar_matrix[2][0]*spin1_final[0]+cmc::cmc_mat[imat].ppolar_matrix[2][1]*spin1_final[1]+cmc::cmc_mat[imat].ppolar_matrix[2][2]*spin1_final[2];
 
-		// Calculate current energy
-		Eold = sim::calculate_spin_energy(atom_number1);
+		// Calculate difference in Joules/mu_B
+		delta_energy1 = sim::calculate_spin_delta_energy(atom_number1, spin1_initial.data(), spin1_final.data())*mp::material[imat1].mu_s_SI*1.07828231e23; //1/9.27400915e-24
 
 		// Copy new spin position (provisionally accept move)
 		atoms::x_spin_array[atom_number1] = spin1_final[0];
 		atoms::y_spin_array[atom_number1] = spin1_final[1];
 		atoms::z_spin_array[atom_number1] = spin1_final[2];
 
-		// Calculate new energy
-		Enew = sim::calculate_spin_energy(atom_number1);
-
-		// Calculate difference in Joules/mu_B
-		delta_energy1 = (Enew-Eold)*mp::material[imat1].mu_s_SI*1.07828231e23; //1/9.27400915e-24
-
 		// Compute second move
 
 		// Randomly select spin number 2 (i/=j) of same material type
@@ -480,20 +466,14 @@ int cmc_mc_step(){
 			spin2_final[2]=cmc::cmc_mat[imat].ppolar_matrix_tp[2][0]*spin2_fin_mvd[0]+cmc::cmc_mat[imat].ppolar_matrix_tp[2][1]*spin2_fin_mvd[1]+cmc::cmc_mat[imat].ppolar_matrix_tp[2][2]*spin2_fin_mvd[2];
 
 			//Calculate Energy Difference 2
-			// Calculate current energy
-			Eold = sim::calculate_spin_energy(atom_number2);
+         // Calculate difference in Joules/mu_B
+			delta_energy2 = sim::calculate_spin_delta_energy(atom_number2, spin2_initial, spin2_final)*mp::material[imat2].mu_s_SI*1.07828231e23; //1/9.27400915e-24
 
          // Copy new spin position (provisionally accept move)
 			atoms::x_spin_array[atom_number2] = spin2_final[0];
 			atoms::y_spin_array[atom_number2] = spin2_final[1];
 			atoms::z_spin_array[atom_number2] = spin2_final[2];
 
-			// Calculate new energy
-			Enew = sim::calculate_spin_energy(atom_number2);
-
-         // Calculate difference in Joules/mu_B
-			delta_energy2 = (Enew-Eold)*mp::material[imat2].mu_s_SI*1.07828231e23; //1/9.27400915e-24
-
 			// Calculate Delta E for both spins
 			delta_energy21 = delta_energy1*rescaled_material_kBTBohr[imat1] +
 			                 delta_energy2*rescaled_material_kBTBohr[imat2];
@@ -0,0 +1,113 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2024. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// Standard Libraries
+#include <vector>
+
+// Vampire Header files
+#include "exchange.hpp"
+#include "vio.hpp"
+
+// Internal header
+#include "internal.hpp"
+
+namespace montecarlo{
+
+namespace internal{
+
+//------------------------------------------------------------------------------
+// Function to colour the interaction graph so that no two atoms of the same
+// colour interact. Atoms are coloured greedily in index order with the lowest
+// colour not used by any of their neighbours. The graph is symmetrised so that
+// one-way interactions are also respected.
+//
+// The graph must contain every pair of atoms coupled by a term in
+// sim::calculate_spin_delta_energy. These are the bilinear, biquadratic and
+// four spin exchange, all returned by exchange::get_neighbours. Anisotropy,
+// local applied field and VCMA terms depend only on the spin being moved, and
+// the applied and dipole fields are constant during a Monte Carlo step.
+//------------------------------------------------------------------------------
+void initialize_colouring(const int num_atoms){
+
+   // determine symmetric list of interactions in compact form
+   std::vector<int> count(num_atoms+1, 0);
+   std::vector<int> neighbours;
+
+   for(int atom = 0; atom < num_atoms; atom++){
+      neighbours.clear();
+      exchange::get_neighbours(atom, neighbours);
+      for(size_t n = 0; n < neighbours.size(); n++){
+         const int natom = neighbours[n];
+         if(natom == atom || natom < 0 || natom >= num_atoms) continue;
+         count[atom+1]++;
+         count[natom+1]++;
+      }
+   }
+
+   for(int atom = 0; atom < num_atoms; atom++) count[atom+1] += count[atom];
+
+   std::vector<int> graph(count[num_atoms]);
+   std::vector<int> position(count.begin(), count.end()-1);
+
+   for(int atom = 0; atom < num_atoms; atom++){
+      neighbours.clear();
+      exchange::get_neighbours(atom, neighbours);
+      for(size_t n = 0; n < neighbours.size(); n++){
+         const int natom = neighbours[n];
+         if(natom == atom || natom < 0 || natom >= num_atoms) continue;
+         graph[position[atom]++] = natom;
+         graph[position[natom]++] = atom;
+      }
+   }
+
+   // greedy colouring of atoms
+   std::vector<int> colour(num_atoms, -1);
+   std::vector<int> last_used; // atom which last marked colour as unavailable
+   int num_colours = 0;
+
+   for(int atom = 0; atom < num_atoms; atom++){
+
+      // mark colours of already coloured neighbours as unavailable
+      for(int nn = count[atom]; nn < count[atom+1]; nn++){
+         const int c = colour[graph[nn]];
+         if(c >= 0) last_used[c] = atom;
+      }
+
+      // pick lowest available colour
+      int c = 0;
+      while(c < num_colours && last_used[c] == atom) c++;
+      if(c == num_colours){
+         num_colours++;
+         last_used.push_back(-1);
+      }
+      colour[atom] = c;
+
+   }
+
+   // save atoms of each colour in index order
+   colour_list.clear();
+   colour_list.resize(num_colours);
+   for(int atom = 0; atom < num_atoms; atom++) colour_list[colour[atom]].push_back(atom);
+
+   zlog << zTs() << "Coloured Monte Carlo using " << num_colours << " independent sets of atoms:";
+   for(int c = 0; c < num_colours; c++) zlog << " " << colour_list[c].size();
+   zlog << std::endl;
+
+   colouring_initialised = true;
+
+   return;
+
+}
+
+} // end of internal namespace
+
+} // End of namespace montecarlo
@@ -56,6 +56,10 @@ namespace montecarlo{
       std::vector<std::vector<int> > c_octants; //Core atoms of each octant
       std::vector<std::vector<int> > b_octants; //Boundary atoms of each octant
 
+      // Coloured MC variables
+      bool colouring_initialised = false; // flag to indicate atoms have been coloured
+      std::vector<std::vector<int> > colour_list; // list of atoms in each colour set
+
 
    } // end of internal namespace
 
@@ -20,6 +20,7 @@
 //---------------------------------------------------------------------
 
 // C++ standard library headers
+#include <random>
 #include <vector>
 
 // Vampire headers
@@ -61,10 +62,17 @@ namespace montecarlo{
       //MC-MPI variables
       extern std::vector<std::vector<int> > c_octants; //Core atoms of each octant
       extern std::vector<std::vector<int> > b_octants; //Boundary atoms of each octant
+
+      // Coloured MC variables
+      extern bool colouring_initialised; // flag to indicate atoms have been coloured
+      extern std::vector<std::vector<int> > colour_list; // list of atoms in each colour set
+
       //-------------------------------------------------------------------------
       // Internal function declarations
       //-------------------------------------------------------------------------
       void mc_move(const std::vector<double>&, std::vector<double>&);
+      void mc_move(const double old_spin[3], double new_spin[3], const double sigma, std::mt19937& generator);
+      void initialize_colouring(const int num_atoms);
 
    } // end of internal namespace
 
@@ -287,20 +287,14 @@ void cmc_mc_step_mask(){
          // Make Monte Carlo move
          montecarlo::internal::mc_move(spin1_initial, spin1_final);
 
-			// Calculate current energy
-			const double Eold = sim::calculate_spin_energy(atom1);
+			// Calculate difference in Joules/mu_B
+			const double delta_energy1 = sim::calculate_spin_delta_energy(atom1, spin1_initial.data(), spin1_final.data())*mp::material[mat1].mu_s_SI*1.07828231e23; //1/9.27400915e-24
 
 			// Copy new spin position
 			atoms::x_spin_array[atom1] = spin1_final[0];
 			atoms::y_spin_array[atom1] = spin1_final[1];
 			atoms::z_spin_array[atom1] = spin1_final[2];
 
-			// Calculate new energy
-			const double Enew = sim::calculate_spin_energy(atom1);
-
-			// Calculate difference in Joules/mu_B
-			const double delta_energy1 = (Enew-Eold)*mp::material[mat1].mu_s_SI*1.07828231e23; //1/9.27400915e-24
-
 			// Check for lower energy state and accept unconditionally
 			if(delta_energy1 < 0.0) cmc::mc_success += 1.0;
 
@@ -340,20 +334,14 @@ void cmc_mc_step_mask(){
 			spin1_fin_mvd[1]=cmc::cmc_mask[mask1].ppolar_matrix[1][0]*spin1_final[0]+cmc::cmc_mask[mask1].ppolar_matrix[1][1]*spin1_final[1]+cmc::cmc_mask[mask1].ppolar_matrix[1][2]*spin1_final[2];
 			spin1_fin_mvd[2]=cmc::cmc_mask[mask1].ppolar_matrix[2][0]*spin1_final[0]+cmc::cmc_mask[mask1].ppolar_matrix[2][1]*spin1_final[1]+cmc::cmc_mask[mask1].ppolar_matrix[2][2]*spin1_final[2];
 
-			// Calculate current energy
-			const double Eold = sim::calculate_spin_energy(atom1);
+			// Calculate difference in Joules/mu_B
+			const double delta_energy1 = sim::calculate_spin_delta_energy(atom1, spin1_initial.data(), spin1_final.data())*mp::material[mat1].mu_s_SI*1.07828231e23; //1/9.27400915e-24
 
 			// Copy new spin position (provisionally accept move)
 			atoms::x_spin_array[atom1] = spin1_final[0];
 			atoms::y_spin_array[atom1] = spin1_final[1];
 			atoms::z_spin_array[atom1] = spin1_final[2];
 
-			// Calculate new energy
-			const double Enew = sim::calculate_spin_energy(atom1);
-
-			// Calculate difference in Joules/mu_B
-			const double delta_energy1 = (Enew-Eold)*mp::material[mat1].mu_s_SI*1.07828231e23; //1/9.27400915e-24
-
 			// Compute second move
 
 			// Randomly select spin number 2 (i/=j) of same material type
@@ -384,20 +372,14 @@ void cmc_mc_step_mask(){
 				spin2_final[2]=cmc::cmc_mask[mask1].ppolar_matrix_tp[2][0]*spin2_fin_mvd[0]+cmc::cmc_mask[mask1].ppolar_matrix_tp[2][1]*spin2_fin_mvd[1]+cmc::cmc_mask[mask1].ppolar_matrix_tp[2][2]*spin2_fin_mvd[2];
 
 				//Calculate Energy Difference 2
-				// Calculate current energy
-				const double Eold = sim::calculate_spin_energy(atom2);
+	         // Calculate difference in Joules/mu_B
+				const double delta_energy2 = sim::calculate_spin_delta_energy(atom2, spin2_initial, spin2_final)*mp::material[mat2].mu_s_SI*1.07828231e23; //1/9.27400915e-24
 
 	         // Copy new spin position (provisionally accept move)
 				atoms::x_spin_array[atom2] = spin2_final[0];
 				atoms::y_spin_array[atom2] = spin2_final[1];
 				atoms::z_spin_array[atom2] = spin2_final[2];
 
-				// Calculate new energy
-				const double Enew = sim::calculate_spin_energy(atom2);
-
-	         // Calculate difference in Joules/mu_B
-				const double delta_energy2 = (Enew-Eold)*mp::material[mat2].mu_s_SI*1.07828231e23; //1/9.27400915e-24
-
 				// Calculate Delta E for both spins
 				const double delta_energy21 = delta_energy1*rescaled_material_kBTBohr[mat1] + delta_energy2*rescaled_material_kBTBohr[mat2];
 
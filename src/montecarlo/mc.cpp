@@ -37,8 +37,6 @@ void mc_step(std::vector<double> &x_spin_array,
 
       // Temporaries
       int atom=0;
-      double Eold=0.0;
-      double Enew=0.0;
       double DE=0.0;
 
       // Material dependent temperature rescaling
@@ -78,20 +76,14 @@ void mc_step(std::vector<double> &x_spin_array,
          // Make Monte Carlo move
          internal::mc_move(internal::Sold, internal::Snew);
 
-         // Calculate current energy
-         Eold = sim::calculate_spin_energy(atom);
+         // Calculate difference in Joules/mu_B
+         DE = sim::calculate_spin_delta_energy(atom, internal::Sold.data(), internal::Snew.data())*internal::mu_s_SI[imaterial]*1.07828231e23; //1/9.27400915e-24
 
          // Copy new spin position
          x_spin_array[atom] = internal::Snew[0];
          y_spin_array[atom] = internal::Snew[1];
          z_spin_array[atom] = internal::Snew[2];
 
-         // Calculate new energy
-         Enew = sim::calculate_spin_energy(atom);
-
-         // Calculate difference in Joules/mu_B
-         DE = (Enew-Eold)*internal::mu_s_SI[imaterial]*1.07828231e23; //1/9.27400915e-24
-
          // Check for lower energy state and accept unconditionally
          if(DE<0) continue;
          // Otherwise evaluate probability for move
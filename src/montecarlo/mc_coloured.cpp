@@ -0,0 +1,144 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2024. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// Standard Libraries
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// Vampire Header files
+#include "errors.hpp"
+#include "random.hpp"
+#include "sim.hpp"
+#include "vutil.hpp"
+
+// Internal header
+#include "internal.hpp"
+
+namespace montecarlo{
+
+//------------------------------------------------------------------------------
+// Integrates a Monte Carlo step using coloured sets of atoms
+//
+// Atoms of the same colour do not interact, and so trial moves for all atoms
+// of one colour can be made simultaneously by all shared memory threads,
+// each using an independent random number generator. Colours are swept in
+// turn, with a barrier between colours so that each colour sees the updated
+// spins of the others. Each step makes one trial move per atom.
+//------------------------------------------------------------------------------
+void mc_step_coloured(std::vector<double> &x_spin_array,
+                      std::vector<double> &y_spin_array,
+                      std::vector<double> &z_spin_array,
+                      std::vector<int> &type_array){
+
+   // check calling of routine if error checking is activated
+   if(err::check==true){std::cout << "montecarlo::mc_step_coloured has been called" << std::endl;}
+
+   // colour atoms on first call
+   if(!internal::colouring_initialised) internal::initialize_colouring(x_spin_array.size());
+
+   // Material dependent temperature rescaling
+   std::vector<double> rescaled_material_kBTBohr(internal::num_materials);
+   std::vector<double> sigma_array(internal::num_materials); // range for tuned gaussian random move
+   for(int m=0; m<internal::num_materials; ++m){
+      double alpha = internal::temperature_rescaling_alpha[m];
+      double Tc = internal::temperature_rescaling_Tc[m];
+      double rescaled_temperature = sim::temperature < Tc ? Tc*pow(sim::temperature/Tc,alpha) : sim::temperature;
+      rescaled_material_kBTBohr[m] = 9.27400915e-24/(rescaled_temperature*1.3806503e-23);
+      sigma_array[m] = rescaled_temperature < 1.0 ? 0.02 : pow(1.0/rescaled_material_kBTBohr[m],0.2)*0.08;
+   }
+
+   const int num_colours = internal::colour_list.size();
+
+   double statistics_moves = 0.0;
+   double statistics_reject = 0.0;
+
+   #pragma omp parallel num_threads(sim::num_threads) reduction(+:statistics_moves,statistics_reject)
+   {
+
+      // independent random number generator for this thread
+      std::mt19937& generator = mtrandom::thread_grnd[vutil::thread_id()];
+
+      for(int c = 0; c < num_colours; c++){
+
+         const std::vector<int>& atoms_in_colour = internal::colour_list[c];
+
+         // determine range of atoms in colour updated by this thread
+         int start_index = 0;
+         int end_index = 0;
+         vutil::thread_range(atoms_in_colour.size(), start_index, end_index);
+
+         for(int i = start_index; i < end_index; i++){
+
+            const int atom = atoms_in_colour[i];
+
+            // add one to number of moves counter
+            statistics_moves+=1.0;
+
+            // get material id
+            const int imaterial=type_array[atom];
+
+            // Save old spin position
+            const double Sold[3] = {x_spin_array[atom], y_spin_array[atom], z_spin_array[atom]};
+            double Snew[3];
+
+            // Make Monte Carlo move
+            internal::mc_move(Sold, Snew, sigma_array[imaterial], generator);
+
+            // Calculate difference in Joules/mu_B
+            const double DE = sim::calculate_spin_delta_energy(atom, Sold, Snew)*internal::mu_s_SI[imaterial]*1.07828231e23; //1/9.27400915e-24
+
+            // Copy new spin position
+            x_spin_array[atom] = Snew[0];
+            y_spin_array[atom] = Snew[1];
+            z_spin_array[atom] = Snew[2];
+
+            // Check for lower energy state and accept unconditionally
+            if(DE<0) continue;
+            // Otherwise evaluate probability for move
+            else if(exp(-DE*rescaled_material_kBTBohr[imaterial]) >= mtrandom::uniformc(generator)) continue;
+            // If rejected reset spin coordinates and continue
+            else{
+               x_spin_array[atom] = Sold[0];
+               y_spin_array[atom] = Sold[1];
+               z_spin_array[atom] = Sold[2];
+               // add one to rejection counter
+               statistics_reject += 1.0;
+            }
+
+         }
+
+         // wait for all threads to finish colour before moving to the next
+         #pragma omp barrier
+
+      }
+
+   } // end of parallel region
+
+   // calculate new adaptive step sigma angle
+   if(montecarlo::algorithm == montecarlo::adaptive){
+      const double last_rejection_rate = statistics_reject / statistics_moves;
+      const double factor = 0.5 / last_rejection_rate;
+      montecarlo::internal::adaptive_sigma *= factor;
+      // check for excessive range (too small angle takes too long to grow, too large does not improve performance) and truncate
+      if (montecarlo::internal::adaptive_sigma > 60.0 || montecarlo::internal::adaptive_sigma < 1e-5) montecarlo::internal::adaptive_sigma = 60.0;
+   }
+
+   // Save statistics to sim namespace variable
+   sim::mc_statistics_moves += statistics_moves;
+   sim::mc_statistics_reject += statistics_reject;
+
+   return;
+
+}
+
+} // End of namespace montecarlo
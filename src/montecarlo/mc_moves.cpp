@@ -10,6 +10,7 @@
 //------------------------------------------------------------------------------
 //
 // standard library header files
+#include <cmath>
 #include <vector>
 
 // vampire header files
@@ -23,56 +24,73 @@ namespace montecarlo{
 
 namespace internal{
 
-// Function declarations
-void mc_gaussian(const std::vector<double>&, std::vector<double>&);
-void mc_spin_flip(const std::vector<double>&, std::vector<double>&);
-void mc_uniform(std::vector<double>&);
-void mc_angle(const std::vector<double>&, std::vector<double>&, const double angle);
-void mc_hinzke_nowak(const std::vector<double>&, std::vector<double>&);
-void mc_adaptive(const std::vector<double>&, std::vector<double>&);
-
-///--------------------------------------------------------
+//-----------------------------------------------------------------------------------------
 ///
-///  Master function to call desired Monte Carlo move
+///  Master function to make desired Monte Carlo move using given random number
+///  generator, with the width of the angle move given by sigma
 ///
-///--------------------------------------------------------
-void mc_move(const std::vector<double>& old_spin, std::vector<double>& new_spin){
+///  Angle move: move spin within cone near old position
+///  Spin flip move: reverse spin direction
+///  Uniform move: place spin randomly on unit sphere
+///  Hinzke-Nowak move: combination move selecting random move from spin flip,
+///  uniform and angle
+///
+///  D. Hinzke, U. Nowak, Computer Physics Communications 121–122 (1999) 334–337
+///  "Monte Carlo simulation of magnetization switching in a Heisenberg model for small ferromagnetic particles"
+///
+///  Adaptive move: generates a new spin from a cone around the old spin, the cone
+///  width is derived from the acceptance rate of the previous monte carlo step.
+///
+///  Adaptive algorithm implemented
+///  JD. Alzate-Cardona
+///  RFL. Evans
+///  D. Sabogal-Suarez
+///  Implementation by Oscar David Arbeláez E., JD. Alzate-Cardona and R F L Evans 2018
+///
+//-----------------------------------------------------------------------------------------
+template <typename generator_t>
+static void move_spin(const double old_spin[3], double new_spin[3], const double sigma, generator_t& generator){
 
    // Reference enum list for readability
    using namespace montecarlo;
 
-   // Select algorithm using case statement
-   switch(algorithm){
+   // Select algorithm, picking random move type for Hinzke-Nowak algorithm
+   algorithm_t move = algorithm;
+   if(move == hinzke_nowak){
+      const int pick_move = int(3.0*mtrandom::uniformc(generator));
+      if(pick_move == 0)      move = spin_flip;
+      else if(pick_move == 1) move = uniform;
+      else                    move = angle;
+   }
+
+   switch(move){
 
-      case adaptive:
-         mc_adaptive(old_spin, new_spin);
-         break;
       case spin_flip:
-         mc_spin_flip(old_spin, new_spin);
-         break;
+         new_spin[0] = -old_spin[0];
+         new_spin[1] = -old_spin[1];
+         new_spin[2] = -old_spin[2];
+         return;
+
       case uniform:
-         mc_uniform(new_spin);
+         new_spin[0] = mtrandom::gaussianc(generator);
+         new_spin[1] = mtrandom::gaussianc(generator);
+         new_spin[2] = mtrandom::gaussianc(generator);
          break;
+
       case angle:
-         mc_angle(old_spin, new_spin, montecarlo::internal::delta_angle);
-         break;
-      case hinzke_nowak:
-         mc_hinzke_nowak(old_spin, new_spin);
+         new_spin[0] = old_spin[0] + mtrandom::gaussianc(generator) * sigma;
+         new_spin[1] = old_spin[1] + mtrandom::gaussianc(generator) * sigma;
+         new_spin[2] = old_spin[2] + mtrandom::gaussianc(generator) * sigma;
          break;
+
+      case adaptive:
       default:
-         mc_adaptive(old_spin, new_spin);
+         new_spin[0] = old_spin[0] + mtrandom::gaussianc(generator) * montecarlo::internal::adaptive_sigma;
+         new_spin[1] = old_spin[1] + mtrandom::gaussianc(generator) * montecarlo::internal::adaptive_sigma;
+         new_spin[2] = old_spin[2] + mtrandom::gaussianc(generator) * montecarlo::internal::adaptive_sigma;
          break;
-   }
-   return;
-}
 
-/// Angle move
-/// Move spin within cone near old position
-void mc_angle(const std::vector<double>& old_spin, std::vector<double>& new_spin, const double angle){
-
-   new_spin[0] = old_spin[0] + mtrandom::gaussian() * angle;
-   new_spin[1] = old_spin[1] + mtrandom::gaussian() * angle;
-   new_spin[2] = old_spin[2] + mtrandom::gaussian() * angle;
+   }
 
    // Calculate new spin length
    const double r = 1.0/sqrt (new_spin[0]*new_spin[0]+new_spin[1]*new_spin[1]+new_spin[2]*new_spin[2]);
@@ -86,78 +104,22 @@ void mc_angle(const std::vector<double>& old_spin, std::vector<double>& new_spin
 
 }
 
-/// Spin flip move
-/// Reverse spin direction
-void mc_spin_flip(const std::vector<double>& old_spin, std::vector<double>& new_spin){
-
-   new_spin[0]=-old_spin[0];
-   new_spin[1]=-old_spin[1];
-   new_spin[2]=-old_spin[2];
-
-   return;
-
-}
-
-/// Random move
-/// Place spin randomly on unit sphere
-void mc_uniform(std::vector<double>& new_spin){
-
-   new_spin[0]=mtrandom::gaussian();
-   new_spin[1]=mtrandom::gaussian();
-   new_spin[2]=mtrandom::gaussian();
-
-   // Calculate new spin length
-   const double r = 1.0/sqrt (new_spin[0]*new_spin[0]+new_spin[1]*new_spin[1]+new_spin[2]*new_spin[2]);
-
-   // Apply normalisation
-   for (size_t i=0; i < new_spin.size(); i++) {
-      new_spin[i]*=r;
-   }
-
+//-----------------------------------------------------------------------------------------
+// Monte Carlo move using the single global random number sequence, with the
+// width of the angle move given by delta_angle
+//-----------------------------------------------------------------------------------------
+void mc_move(const std::vector<double>& old_spin, std::vector<double>& new_spin){
+   move_spin(old_spin.data(), new_spin.data(), montecarlo::internal::delta_angle, mtrandom::grnd);
    return;
-
-}
-
-/// Combination move selecting random move from spin_flip, angle and random
-///
-/// D. Hinzke, U. Nowak, Computer Physics Communications 121–122 (1999) 334–337
-/// "Monte Carlo simulation of magnetization switching in a Heisenberg model for small ferromagnetic particles"
-///
-void mc_hinzke_nowak(const std::vector<double>& old_spin, std::vector<double>& new_spin){
-
-   // Select random move type
-   const int pick_move=int(3.0*mtrandom::grnd());
-
-      switch(pick_move){
-         case 0:
-            mc_spin_flip(old_spin, new_spin);
-            break;
-         case 1:
-            mc_uniform(new_spin);
-            break;
-         case 2:
-            mc_angle(old_spin, new_spin, montecarlo::internal::delta_angle);
-            break;
-         default:
-            mc_angle(old_spin, new_spin, montecarlo::internal::delta_angle);
-            break;
-      }
-      return;
 }
 
 //-----------------------------------------------------------------------------------------
-/// Generates a new spin from a cone around the old spin, the cone width is
-/// derived from the acceptance rate of the previous monte carlo step.
-///
-/// Adaptive algorithm implemented
-/// JD. Alzate-Cardona
-/// RFL. Evans
-/// D. Sabogal-Suarez
-// Implementation by Oscar David Arbeláez E., JD. Alzate-Cardona and R F L Evans 2018
+// Version of Monte Carlo move using an independent random number generator, for
+// use by shared memory threads. The trial width for the angle move is passed in
+// rather than read from delta_angle so that threads can use different widths.
 //-----------------------------------------------------------------------------------------
-void mc_adaptive(const std::vector<double>& old_spin, std::vector<double>& new_spin){
-   // Here we have adaptive_sigma, at least from the monte carlo algorithm
-   mc_angle(old_spin, new_spin, montecarlo::internal::adaptive_sigma);
+void mc_move(const double old_spin[3], double new_spin[3], const double sigma, std::mt19937& generator){
+   move_spin(old_spin, new_spin, sigma, generator);
    return;
 }
 
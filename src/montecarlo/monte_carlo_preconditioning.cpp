@@ -106,8 +106,8 @@ void monte_carlo_preconditioning(){
 
          //std::cout << "here" << std::endl;
 
-   		// Calculate current energy
-   		double old_energy = sim::calculate_spin_energy(atom);
+   		// Calculate difference in Joules/mu_B
+   		const double DE = sim::calculate_spin_delta_energy(atom, internal::Sold.data(), internal::Snew.data()) * moment_array[imaterial];
 
    		// Copy new spin position
    		atoms::x_spin_array[atom] = internal::Snew[0];
@@ -116,13 +116,6 @@ void monte_carlo_preconditioning(){
 
          //std::cout << "here2" << std::endl;
 
-
-   		// Calculate new energy
-   		const double new_energy = sim::calculate_spin_energy(atom);
-
-   		// Calculate difference in Joules/mu_B
-   		const double DE = (new_energy - old_energy) * moment_array[imaterial];
-
    		// Check for lower energy state and accept unconditionally
    		if(DE<0) continue;
    		// Otherwise evaluate probability for move
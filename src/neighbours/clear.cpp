@@ -25,10 +25,12 @@ void list_t::clear(){
    // force deallocation by making main object data go out of scope
    // Everybody who loves C++ scoping rules say woo!
 
-   // a simple unallocated array of neighbours
-   std::vector< std::vector <neighbours::neighbour_t> > tmp;
+   // simple unallocated arrays of neighbours
+   std::vector<uint64_t> tmp_start_index;
+   std::vector<neighbours::neighbour_t> tmp;
 
    // swap the pointers
+   tmp_start_index.swap(start_index);
    tmp.swap(list);
 
    // leaving unloved memory behind
@@ -12,12 +12,14 @@
 
 // C++ standard library headers
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 
 // Vampire headers
 #include "create_atoms_class.hpp" // class definition for atoms in create module
 #include "errors.hpp"
 #include "neighbours.hpp"
+#include "sim.hpp"
 #include "vio.hpp"
 #include "vmath.hpp"
 #include "vmpi.hpp"
@@ -45,6 +47,12 @@ namespace neighbours{
 //
 //  In this example offset=4, and max_cell = 8. Therefore 4 cells are needed.
 //
+// Atoms are binned in a flat array of (cell, unit cell site) and the list is
+// generated in two passes over cells, first counting the neighbours of each
+// atom and then filling the compact list. Each atom belongs to a single cell
+// so both passes are threaded over cells. The neighbours of each atom are in
+// the order of the exchange template.
+//
 //----------------------------------------------------------------------------------
 void list_t::generate( std::vector<cs::catom_t>& atom_array,    // array of atoms (as reference for speed)
                unitcell::exchange_template_t& exchange, // exchange template to calculate neighbour list
@@ -57,18 +65,6 @@ void list_t::generate( std::vector<cs::catom_t>& atom_array,    // array of atom
 	// put number of atoms into temporary variable
 	const int num_atoms = atom_array.size();
 
-	// Reserve space for num_atoms
-	list.reserve(num_atoms);
-
-	// estimate number of interactions per atom
-	const int64_t max_nn = int64_t( 1.1*( double(exchange.interaction.size()) / double(num_atoms_in_unit_cell) ) );
-
-	// Reserve space for each atom in neighbour list according to material type
-	for(int atom=0; atom < num_atoms; atom++){
-		list.push_back(std::vector<neighbour_t>());
-		list[atom].reserve(max_nn);
-	}
-
    // Calculate system dimensions and number of supercells
    const int64_t max_val=1000000000000;
    int64_t min[3] = {max_val,max_val,max_val}; // lowest cell id
@@ -111,65 +107,17 @@ void list_t::generate( std::vector<cs::catom_t>& atom_array,    // array of atom
                           ( max_cell[1] - offset[1] + 1 ),
                           ( max_cell[2] - offset[2] + 1 )};
 
-	// Declare temporary array for 3D supercell array
-	std::vector<std::vector<std::vector<std::vector<int> > > > supercell_array;
-
-   // calculate total number of neighbours and inform user of memory needed
-   double num_neighbours = double(d[0]) * double(d[1]) * double(d[2]) * double(num_atoms_in_unit_cell);
-   #ifdef MPICF
-      // calculate total interactions for entire system
-      double total_neighbours = 0.0;
-      MPI_Allreduce(&total_neighbours, &num_neighbours, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-      if(vmpi::master){
-         zlog << zTs() << "Memory required for neighbourlist calculation (each cpu):" <<
-         8.0*total_neighbours/(vmpi::num_processors * 1.0e6) << " MB" << std::endl;
-         zlog << zTs() << "Memory required for neighbourlist calculation (all cpus):" <<
-         8.0*total_neighbours/1.0e6 << " MB" << std::endl;
-      }
-   #else
-      zlog << zTs() << "Memory required for neighbourlist calculation:" <<
-      8.0*num_neighbours/1.0e6 << " MB" << std::endl;
-   #endif
+	// total number of cells, ordered as (x, y, z) with z fastest
+	const int64_t num_cells = num_atoms > 0 ? d[0]*d[1]*d[2] : 0;
+   const int64_t ns = num_atoms_in_unit_cell;
 
    // Inform user that neighbour list calculation is beginning
    zlog << zTs() << "Allocating memory for supercell array in neighbourlist calculation" << std::endl;
 
-   // Allocate supercell array to list all atoms
-	supercell_array.resize(d[0]);
-	for(unsigned int i=0; i < d[0] ; i++){
-		supercell_array[i].resize(d[1]);
-		for(unsigned int j=0; j<d[1] ; j++){
-			supercell_array[i][j].resize(d[2]);
-			for(unsigned int k=0; k<d[2] ; k++){
-				supercell_array[i][j][k].resize(num_atoms_in_unit_cell,-1);
-			}
-		}
-	}
+   // Allocate flat array of atom ids for each (cell, site), -1 for missing atoms
+	std::vector<int> supercell_array(num_cells*ns, -1);
    zlog << zTs() << "\tAllocating memory done"<< std::endl;
 
-	// declare 1D cell array to loop over
-	const uint64_t num_cells = d[0]*d[1]*d[2];
-	std::vector< std::vector <int> > cell_coord_array;
-	cell_coord_array.reserve(num_cells);
-	for(uint64_t i=0; i < num_cells; i++){
-		cell_coord_array.push_back(std::vector<int>());
-		cell_coord_array[i].resize(3);
-	}
-
-	// Initialise cell_array
-	uint64_t cell=0; // cell counter
-	for(unsigned int x=0;x<d[0];x++){
-		for(unsigned int y=0;y<d[1];y++){
-			for(unsigned int z=0;z<d[2];z++){
-				//save cell coordinates
-				cell_coord_array[cell][0]=x;
-				cell_coord_array[cell][1]=y;
-				cell_coord_array[cell][2]=z;
-				cell++;
-			}
-		}
-	}
-
    // Inform user of time intensive process
    zlog << zTs() << "Populating supercell array for neighbourlist calculation..."<< std::endl;
 
@@ -209,10 +157,13 @@ void list_t::generate( std::vector<cs::catom_t>& atom_array,    // array of atom
 				err::vexit();
 			}
 		}
+
+      const int64_t cell = (scc[0]*d[1] + scc[1])*d[2] + scc[2];
+
 		// Check for atoms greater than max_atoms_per_supercell
 		if(atom_array[atom].uc_id < num_atoms_in_unit_cell){
 			// Add atom to supercell
-			supercell_array[scc[0]][scc[1]][scc[2]][atom_array[atom].uc_id]=atom;
+			supercell_array[cell*ns + atom_array[atom].uc_id]=atom;
 		}
 		else{
 			terminaltextcolor(RED);
@@ -223,8 +174,9 @@ void list_t::generate( std::vector<cs::catom_t>& atom_array,    // array of atom
 			std::cerr << "\tCell maxima:      " << d[0] << "\t" << d[1] << "\t" << d[2] << std::endl;
 			std::cerr << "\tCell offset:      " << offset[0] << "\t" << offset[1] << "\t" << offset[2] << std::endl;
 			std::cerr << "\tAtoms in Current Cell:" << std::endl;
-			for(unsigned int ix=0;ix<supercell_array[scc[0]][scc[1]][scc[2]].size();ix++){
-				const int ixatom=supercell_array[scc[0]][scc[1]][scc[2]][ix];
+			for(int64_t ix=0;ix<ns;ix++){
+				const int ixatom=supercell_array[cell*ns + ix];
+				if(ixatom < 0) continue;
 				std::cerr << "\t\t [id x y z] "<< ix << "\t" << ixatom << "\t" << atom_array[ixatom].x << "\t" << atom_array[ixatom].y << "\t" << atom_array[ixatom].z << std::endl;
 			}
 			terminaltextcolor(WHITE);
@@ -235,147 +187,130 @@ void list_t::generate( std::vector<cs::catom_t>& atom_array,    // array of atom
    // Inform user of progress
    zlog << zTs() << "\tPopulating supercell array completed"<< std::endl;
 
-   // calculate total number of neighbours and inform user of memory needed
-   num_neighbours = double(num_cells)*double(exchange.interaction.size());
-   #ifdef MPICF
-      // calculate total interactions for entire system
-      total_neighbours = 0.0;
-      MPI_Allreduce(&total_neighbours, &num_neighbours, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-      if(vmpi::master){
-         zlog << zTs() << "Memory required for neighbour list (each cpu):" <<
-         8.0*total_neighbours/(vmpi::num_processors * 1.0e6) << " MB" << std::endl;
-         zlog << zTs() << "Memory required for neighbour list (all cpus):" <<
-         8.0*total_neighbours/1.0e6 << " MB" << std::endl;
-      }
-   #else
-      zlog << zTs() << "Memory required for neighbour list:" <<
-      8.0*num_neighbours/1.0e6 << " MB" << std::endl;
-   #endif
-
 	// Generate neighbour list and inform user
 	std::cout <<"Generating neighbour list"<< std::flush;
    zlog << zTs() << "Generating neighbour list..."<< std::endl;
 
-   // temporary neighour to simplify memory management
-	neighbour_t tmp_nt;
-
    // copy number of interactions to temporary constant
-   const unsigned int num_interactions = exchange.interaction.size();
-
-	// Loop over all cells
-	for(uint64_t cell = 0; cell < num_cells; cell++){
+   const int64_t num_interactions = exchange.interaction.size();
 
-      // Print out progress indicator to user
-		if( cell % ( num_cells / 10 + 1 ) == 0 ){
-			std::cout << "." << std::flush;
-		}
+   //-------------------------------------------------------------------------------
+   // Function to find neighbour atom for interaction i of atom in cell (or -1),
+   // calculating the vector between atoms allowing for periodic boundaries
+   //-------------------------------------------------------------------------------
+   auto find_neighbour = [&](const int64_t cell, const int64_t i, const int atomi, double& vx, double& vy, double& vz){
 
       // get supercell coordinates of cell
-		int scc[3]={ cell_coord_array[cell][0],
-                   cell_coord_array[cell][1],
-                   cell_coord_array[cell][2]};
-
-		// Loop over all interactions in exchange template
-		for(unsigned int i = 0; i < num_interactions; i++){
-
-			const int atom  = exchange.interaction[i].i;
-			const int natom = exchange.interaction[i].j;
-
-			int nx = exchange.interaction[i].dx + scc[0];
-			int ny = exchange.interaction[i].dy + scc[1];
-			int nz = exchange.interaction[i].dz + scc[2];
-
-         // vector from i->j
-         double vx=0.0;
-         double vy=0.0;
-         double vz=0.0;
-
-         #ifdef MPICF
-           // Parallel periodic boundaries are handled explicitly during the
-           // halo region setup
-         #else
-         // Wrap around for periodic boundaries
-         // Consider virtual atom position for position vector
-         if(cs::pbc[0]==true){
-            if(nx>=int(d[0])){
-               nx=nx-d[0];
-               vx=vx+d[0]*ucdx;
-            }
-            else if(nx<0){
-               nx=nx+d[0];
-               vx=vx-d[0]*ucdx;
-            }
+      const int64_t scc[3] = { cell / (d[1]*d[2]), (cell / d[2]) % d[1], cell % d[2] };
+
+      const int natom = exchange.interaction[i].j;
+
+      int64_t nx = exchange.interaction[i].dx + scc[0];
+      int64_t ny = exchange.interaction[i].dy + scc[1];
+      int64_t nz = exchange.interaction[i].dz + scc[2];
+
+      // vector from i->j
+      vx=0.0;
+      vy=0.0;
+      vz=0.0;
+
+      #ifdef MPICF
+        // Parallel periodic boundaries are handled explicitly during the
+        // halo region setup
+      #else
+      // Wrap around for periodic boundaries
+      // Consider virtual atom position for position vector
+      if(cs::pbc[0]==true){
+         if(nx>=d[0]){
+            nx=nx-d[0];
+            vx=vx+d[0]*ucdx;
          }
-         if(cs::pbc[1]==true){
-            if(ny>=int(d[1])){
-               ny=ny-d[1];
-               vy=vy+d[1]*ucdy;
-            }
-            else if(ny<0){
-               ny=ny+d[1];
-               vy=vy-d[1]*ucdy;
-            }
+         else if(nx<0){
+            nx=nx+d[0];
+            vx=vx-d[0]*ucdx;
          }
-         if(cs::pbc[2]==true){
-            if(nz>=int(d[2])){
-               nz=nz-d[2];
-               vz=vz+d[2]*ucdz;
-            }
-            else if(nz<0){
-               nz=nz+d[2];
-               vz=vz-d[2]*ucdz;
-            }
+      }
+      if(cs::pbc[1]==true){
+         if(ny>=d[1]){
+            ny=ny-d[1];
+            vy=vy+d[1]*ucdy;
          }
-         #endif
-         // check for out-of-bounds access
-         if( (nx >= 0 && static_cast<int64_t>(nx) < d[0] ) &&
-             (ny >= 0 && static_cast<int64_t>(ny) < d[1] ) &&
-             (nz >= 0 && static_cast<int64_t>(nz) < d[2] ) ){
-            // check for missing atoms
-            if((supercell_array[scc[0]][scc[1]][scc[2]][atom]!=-1) && (supercell_array[nx][ny][nz][natom]!=-1)){
-
-               // need actual atom numbers...
-               int atomi = supercell_array[scc[0]][scc[1]][scc[2]][atom];
-               int atomj = supercell_array[nx][ny][nz][natom];
-
-               //std::cout << "int_id: " << i << "\tatom i: " << atomi << "\tatom j: " << atomj << "\tuc_i: " << atom << "\tuc_j: " << natom << std::endl;
-
-               // Load atom positions
-               double ix = atom_array[atomi].x; // Already in A
-               double iy = atom_array[atomi].y;
-               double iz = atom_array[atomi].z;
-               double jx = atom_array[atomj].x;
-               double jy = atom_array[atomj].y;
-               double jz = atom_array[atomj].z;
-
-               //std::cout << "\tpi:    " << ix << "\t" << iy << "\t" << iz << std::endl;
-               //std::cout << "\tpj:    " << jx << "\t" << jy << "\t" << jz << std::endl;
-               //std::cout << "\tv_uc:  " << vx << "\t" << vy << "\t" << vz << std::endl;
-
-               vx += jx-ix;
-               vy += jy-iy;
-               vz += jz-iz;
-
-               //std::cout << "\tv:     " << jx-ix << "\t" << jy-iy << "\t" << jz-iz << std::endl;
-               //std::cout << "\tv_eff: " << vx << "\t" << vy << "\t" << vz << std::endl;
-
-               // get current index
-               // int index = list[supercell_array[scc[0]][scc[1]][scc[2]][atom]].size(); // unused variable
-
-               // set neighbour data
-               tmp_nt.nn = supercell_array[nx][ny][nz][natom]; // atom ID of neighbour
-               tmp_nt.i = i;                                   // interaction type
-               tmp_nt.vx = vx;                                 // position vector i->j
-               tmp_nt.vy = vy;
-               tmp_nt.vz = vz;
-
-               // push back array of class
-               list[supercell_array[scc[0]][scc[1]][scc[2]][atom]].push_back(tmp_nt);
-
-            }
-			}
+         else if(ny<0){
+            ny=ny+d[1];
+            vy=vy-d[1]*ucdy;
+         }
+      }
+      if(cs::pbc[2]==true){
+         if(nz>=d[2]){
+            nz=nz-d[2];
+            vz=vz+d[2]*ucdz;
+         }
+         else if(nz<0){
+            nz=nz+d[2];
+            vz=vz-d[2]*ucdz;
+         }
+      }
+      #endif
+
+      // check for out-of-bounds access
+      if( nx < 0 || nx >= d[0] || ny < 0 || ny >= d[1] || nz < 0 || nz >= d[2] ) return -1;
+
+      // check for missing atoms
+      const int atomj = supercell_array[((nx*d[1] + ny)*d[2] + nz)*ns + natom];
+      if(atomj == -1) return -1;
+
+      // Load atom positions (already in A)
+      vx += atom_array[atomj].x - atom_array[atomi].x;
+      vy += atom_array[atomj].y - atom_array[atomi].y;
+      vz += atom_array[atomj].z - atom_array[atomi].z;
+
+      return atomj;
+
+   };
+
+   //-------------------------------------------------------------------------------
+   // First pass: count number of neighbours of each atom
+   //-------------------------------------------------------------------------------
+   start_index.assign(num_atoms+1, 0);
+
+   #pragma omp parallel for schedule(dynamic, 256) num_threads(sim::num_threads)
+	for(int64_t cell = 0; cell < num_cells; cell++){
+		for(int64_t i = 0; i < num_interactions; i++){
+			const int atomi = supercell_array[cell*ns + exchange.interaction[i].i];
+         if(atomi == -1) continue;
+         double vx, vy, vz;
+         if(find_neighbour(cell, i, atomi, vx, vy, vz) != -1) start_index[atomi+1]++;
+		}
+	}
+   std::cout << "." << std::flush;
+
+   // convert counts to start index of each atom
+   for(int atom = 0; atom < num_atoms; atom++) start_index[atom+1] += start_index[atom];
+
+   //-------------------------------------------------------------------------------
+   // Second pass: fill list of neighbours
+   //-------------------------------------------------------------------------------
+   list.resize(start_index[num_atoms]);
+
+   #pragma omp parallel for schedule(dynamic, 256) num_threads(sim::num_threads)
+	for(int64_t cell = 0; cell < num_cells; cell++){
+		for(int64_t i = 0; i < num_interactions; i++){
+			const int atomi = supercell_array[cell*ns + exchange.interaction[i].i];
+         if(atomi == -1) continue;
+         neighbour_t tmp_nt;
+         tmp_nt.nn = find_neighbour(cell, i, atomi, tmp_nt.vx, tmp_nt.vy, tmp_nt.vz); // atom ID of neighbour
+         if(tmp_nt.nn == -1) continue;
+         tmp_nt.i = i; // interaction type
+         // atoms are only in one cell, so use start index as counter for atom
+         list[start_index[atomi]] = tmp_nt;
+         start_index[atomi]++;
 		}
 	}
+   std::cout << "." << std::flush;
+
+   // restore start index of each atom
+   for(int atom = num_atoms; atom > 0; atom--) start_index[atom] = start_index[atom-1];
+   start_index[0] = 0;
 
    // Inform user neighbour list calculation is complete
 	if(vmpi::my_rank == 0){
@@ -385,19 +320,15 @@ void list_t::generate( std::vector<cs::catom_t>& atom_array,    // array of atom
 	}
    zlog << zTs() << "\tNeighbour list calculation complete"<< std::endl;
 
+   // inform user of peak memory used in neighbour list calculation
+   const double supercell_memory = double(supercell_array.size())*double(sizeof(int));
+   const double list_memory = double(start_index.size())*double(sizeof(uint64_t)) + double(list.size())*double(sizeof(neighbour_t));
+   zlog << zTs() << "\tNeighbour list with " << list.size() << " interactions requires " << list_memory*1.0e-6 << " MB RAM on rank " << vmpi::my_rank
+        << " (peak " << (supercell_memory + list_memory)*1.0e-6 << " MB during generation)" << std::endl;
+
 	// Deallocate supercell array
    zlog << zTs() << "Deallocating supercell array for neighbour list calculation" << std::endl;
-	for(unsigned int i=0; i<d[0] ; i++){
-		for(unsigned int j=0; j<d[1] ;j++){
-			for(unsigned int k=0; k<d[2] ;k++){
-				supercell_array[i][j][k].resize(0);
-				}
-				supercell_array[i][j].resize(0);
-			}
-			supercell_array[i].resize(0);
-		}
-	supercell_array.resize(0);
-
+   std::vector<int>().swap(supercell_array);
    zlog << zTs() << "\tSupercell array deallocated" << std::endl;
 
 	return;
@@ -0,0 +1,129 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2024. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// Vampire headers
+#include "random.hpp"
+
+namespace mtrandom{
+
+   bool counter_based_noise = false; // use counter based generator for thermal noise
+   uint64_t noise_counter = 0; // number of time steps for counter based noise
+
+   //---------------------------------------------------------------------------
+   // Philox4x32-10 counter based random number generator
+   // (J. K. Salmon et al, Proc. SC11, 16 (2011))
+   //
+   // Maps a 128 bit counter and 64 bit key to 128 random bits with no state,
+   // so that any element of the sequence can be generated independently.
+   //---------------------------------------------------------------------------
+   static inline void philox4x32_10(const uint32_t counter[4], const uint32_t key[2], uint32_t bits[4]){
+
+      uint32_t c[4] = {counter[0], counter[1], counter[2], counter[3]};
+      uint32_t k0 = key[0];
+      uint32_t k1 = key[1];
+
+      for(int round = 0; round < 10; round++){
+         const uint64_t p0 = uint64_t(0xD2511F53u) * c[0];
+         const uint64_t p1 = uint64_t(0xCD9E8D57u) * c[2];
+         c[0] = uint32_t(p1 >> 32) ^ c[1] ^ k0;
+         c[1] = uint32_t(p1);
+         c[2] = uint32_t(p0 >> 32) ^ c[3] ^ k1;
+         c[3] = uint32_t(p0);
+         k0 += 0x9E3779B9u; // bump key (golden ratio and sqrt(3)-1)
+         k1 += 0xBB67AE85u;
+      }
+
+      bits[0] = c[0];
+      bits[1] = c[1];
+      bits[2] = c[2];
+      bits[3] = c[3];
+
+      return;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Constructor for stream of random numbers for object id (atom or cell) in
+   // time step. Numbers are keyed by (integrator seed, stream, id, step) and so
+   // do not depend on the order in which objects are visited, the number of
+   // threads or the MPI decomposition. The top 8 bits of the counter number
+   // successive blocks of 4 numbers within the stream.
+   //---------------------------------------------------------------------------
+   philox_stream::philox_stream(const uint32_t stream, const uint64_t id, const uint64_t step){
+
+      counter[0] = uint32_t(id);
+      counter[1] = uint32_t(id >> 32);
+      counter[2] = uint32_t(step);
+      counter[3] = uint32_t(step >> 32) & 0x00FFFFFFu;
+      key[0] = uint32_t(integration_seed);
+      key[1] = stream;
+
+      generate();
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to generate next block of 4 random numbers in stream
+   //---------------------------------------------------------------------------
+   void philox_stream::generate(){
+
+      philox4x32_10(counter, key, bits);
+      counter[3] += 0x01000000u;
+      index = 0;
+
+      return;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to generate 3 gaussian random numbers for object id in the
+   // current time step
+   //---------------------------------------------------------------------------
+   void counter_gaussian(const uint32_t stream, const uint64_t id, double gaussian[3]){
+
+      philox_stream grnd(stream, id, noise_counter);
+      gaussian[0] = gaussianc(grnd);
+      gaussian[1] = gaussianc(grnd);
+      gaussian[2] = gaussianc(grnd);
+
+      return;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to fill arrays x, y, z between start and end index with gaussian
+   // random numbers for objects with ids given in id array in the current time
+   // step. Each element is independent, so ranges may be filled by different
+   // threads or processors in any order with the same result.
+   //---------------------------------------------------------------------------
+   void counter_gaussian_fill(const uint32_t stream,
+                              const int start_index,
+                              const int end_index,
+                              const std::vector<uint64_t>& id,
+                              std::vector<double>& x,
+                              std::vector<double>& y,
+                              std::vector<double>& z){
+
+      const uint64_t step = noise_counter;
+
+      for(int i = start_index; i < end_index; i++){
+         philox_stream grnd(stream, id[i], step);
+         x[i] = gaussianc(grnd);
+         y[i] = gaussianc(grnd);
+         z[i] = gaussianc(grnd);
+      }
+
+      return;
+
+   }
+
+} // end of namespace mtrandom
@@ -42,6 +42,7 @@ namespace mtrandom
 	double number2;
 	bool logic=false;
 	MTRand grnd; // single sequence of random numbers
+	std::vector<std::mt19937> thread_grnd; // independent sequences for each thread
 
 
 double gaussian_old(){
@@ -216,12 +217,26 @@ static const double wtab[128] = {
   1.83813550477e-07, 1.92166040885e-07, 2.05295471952e-07, 2.22600839893e-07
 };
 
-double gaussian(){
+//------------------------------------------------------------------------------
+// Helper functions giving 32 random bits and a uniform random number in the
+// half-open interval [0, 1) for each generator type
+//------------------------------------------------------------------------------
+static inline uint32_t random_bits(MTRand& grnd){ return grnd.i32(); }
+static inline double random_uniform(MTRand& grnd){ return grnd(); }
+
+template <typename generator_t>
+static inline uint32_t random_bits(generator_t& grnd){ return grnd(); }
+template <typename generator_t>
+static inline double random_uniform(generator_t& grnd){ return uniformc(grnd); }
+
+/// Gaussian random number (ziggurat method) from a custom random generator
+template <typename generator_t>
+double gaussianc(generator_t& grnd){
   unsigned long  U, sign, i, j;
   double  x, y;
 
   while (1) {
-    U = mtrandom::grnd.i32();
+    U = random_bits(grnd);
     i = U & 0x0000007F;		/* 7 bit to choose the step */
     sign = U & 0x00000080;	/* 1 bit for the sign */
     j = U>>8;			/* 24 bit for the x-value */
@@ -233,42 +248,56 @@ double gaussian(){
       double  y0, y1;
       y0 = ytab[i];
       y1 = ytab[i+1];
-      y = y1+(y0-y1)*mtrandom::grnd();
+      y = y1+(y0-y1)*random_uniform(grnd);
     } else {
-      x = PARAM_R - log(1.0-mtrandom::grnd())/PARAM_R;
-      y = exp(-PARAM_R*(x-0.5*PARAM_R))*mtrandom::grnd();
+      x = PARAM_R - log(1.0-random_uniform(grnd))/PARAM_R;
+      y = exp(-PARAM_R*(x-0.5*PARAM_R))*random_uniform(grnd);
     }
     if (y < exp(-0.5*x*x))  break;
   }
   return  sign ? x : -x;
 }
 
-/// Overloaded gaussian function taking custom random generator
-double gaussianc(MTRand& grnd){
-  unsigned long  U, sign, i, j;
-  double  x, y;
+/// Uniform random number in the half-open interval [0, 1) from a generator of 32 bit integers
+template <typename generator_t>
+double uniformc(generator_t& grnd){
+  return static_cast<double>(grnd()) * (1. / 4294967296.); // divided by 2^32
+}
 
-  while (1) {
-    U = grnd.i32();
-    i = U & 0x0000007F;		/* 7 bit to choose the step */
-    sign = U & 0x00000080;	/* 1 bit for the sign */
-    j = U>>8;			/* 24 bit for the x-value */
+/// Uniform random number from the global sequence, identical to grnd()
+template <>
+double uniformc<MTRand>(MTRand& grnd){
+  return grnd();
+}
 
-    x = j*wtab[i];
-    if (j < ktab[i])  break;
+// instantiate for the global, thread and counter based generators
+template double gaussianc<MTRand>(MTRand&);
+template double gaussianc<std::mt19937>(std::mt19937&);
+template double gaussianc<philox_stream>(philox_stream&);
+template double uniformc<std::mt19937>(std::mt19937&);
+template double uniformc<philox_stream>(philox_stream&);
 
-    if (i<127) {
-      double  y0, y1;
-      y0 = ytab[i];
-      y1 = ytab[i+1];
-      y = y1+(y0-y1)*grnd();
-    } else {
-      x = PARAM_R - log(1.0-grnd())/PARAM_R;
-      y = exp(-PARAM_R*(x-0.5*PARAM_R))*grnd();
-    }
-    if (y < exp(-0.5*x*x))  break;
+/// Gaussian random number from the single global sequence
+double gaussian(){
+  return gaussianc(mtrandom::grnd);
+}
+
+//------------------------------------------------------------------------------
+// Function to seed one independent generator per thread. Thread seeds are
+// scrambled with seed_seq so that consecutive thread ids give uncorrelated
+// sequences.
+//------------------------------------------------------------------------------
+void initialise_thread_generators(const int num_threads, const uint32_t seed){
+
+  thread_grnd.resize(num_threads);
+
+  for(int t = 0; t < num_threads; t++){
+    std::seed_seq sequence = {seed, static_cast<uint32_t>(t)};
+    thread_grnd[t].seed(sequence);
   }
-  return  sign ? x : -x;
+
+  return;
+
 }
 
 } // end of namespace random
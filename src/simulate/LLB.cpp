@@ -34,6 +34,7 @@
 /// \file LLG.cpp
 /// Contains LLG namespace and serial version of the integrator
 #include "atoms.hpp"
+#include "create.hpp"
 #include "material.hpp"
 #include "sim.hpp"
 #include "errors.hpp"
@@ -182,12 +183,19 @@ int LLB_serial_heun(const int num_steps){
 	std::vector <double> Htz_para(atoms::x_spin_array.size());
 
 	// precalculate thermal fields
-	generate (Htx_perp.begin(),Htx_perp.end(), mtrandom::gaussian);
-	generate (Hty_perp.begin(),Hty_perp.end(), mtrandom::gaussian);
-	generate (Htz_perp.begin(),Htz_perp.end(), mtrandom::gaussian);
-	generate (Htx_para.begin(),Htx_para.end(), mtrandom::gaussian);
-	generate (Hty_para.begin(),Hty_para.end(), mtrandom::gaussian);
-	generate (Htz_para.begin(),Htz_para.end(), mtrandom::gaussian);
+	if(mtrandom::counter_based_noise){
+		const int num_atoms = atoms::x_spin_array.size();
+		mtrandom::counter_gaussian_fill(mtrandom::llb_perpendicular_stream, 0, num_atoms, create::global_atom_id, Htx_perp, Hty_perp, Htz_perp);
+		mtrandom::counter_gaussian_fill(mtrandom::llb_parallel_stream, 0, num_atoms, create::global_atom_id, Htx_para, Hty_para, Htz_para);
+	}
+	else{
+		generate (Htx_perp.begin(),Htx_perp.end(), mtrandom::gaussian);
+		generate (Hty_perp.begin(),Hty_perp.end(), mtrandom::gaussian);
+		generate (Htz_perp.begin(),Htz_perp.end(), mtrandom::gaussian);
+		generate (Htx_para.begin(),Htx_para.end(), mtrandom::gaussian);
+		generate (Hty_para.begin(),Hty_para.end(), mtrandom::gaussian);
+		generate (Htz_para.begin(),Htz_para.end(), mtrandom::gaussian);
+	}
 
 	for(unsigned int atom=0;atom<atoms::x_spin_array.size();atom++){
 		Htx_perp[atom] *= sigma_perp;
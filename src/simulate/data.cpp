@@ -20,6 +20,7 @@ namespace sim{
    // Shared variables used with main vampire code
    //---------------------------------------------------------------------------
    integrator_t integrator = llg_heun; // variable to specify integrator
+   int num_threads = 1; // number of shared memory threads used by CPU solvers
 
 
    std::vector < double > track_field_x;
@@ -177,8 +177,7 @@ double calculate_spin_energy(const int atom){
 	double energy=0.0;
 
 	// Calculate total spin energy
-   energy += exchange::single_spin_energy(atom, Sx, Sy, Sz);
-   energy += exchange::single_spin_biquadratic_energy(atom, Sx, Sy, Sz);
+   energy += exchange::single_spin_bilinear_biquadratic_energy(atom, Sx, Sy, Sz);
    energy += exchange::single_spin_four_spin_energy(atom, Sx, Sy, Sz);
 
    // calculate anisotropy energy for atom
@@ -197,4 +196,53 @@ double calculate_spin_energy(const int atom){
 	return energy; // Tesla
 }
 
+//------------------------------------------------------------------------------
+// Calculates the change in energy of a spin for a trial move from old_spin to
+// new_spin (Tesla). All terms linear in the spin (bilinear exchange, applied
+// and magnetostatic fields) are calculated from the local field as
+// -(S_new - S_old).H, so that the neighbour list is only traversed once, and
+// only the nonlinear terms are evaluated for both spin directions. Must be
+// called before the trial spin is written to the spin arrays.
+//------------------------------------------------------------------------------
+double calculate_spin_delta_energy(const int atom, const double old_spin[3], const double new_spin[3]){
+
+	// check calling of routine if error checking is activated
+	if(err::check==true) std::cout << "calculate_spin_delta_energy has been called" << std::endl;
+
+	// Determine neighbour material
+	const int imaterial=atoms::type_array[atom];
+
+	// local field from terms linear in spin
+	double hx = sim::H_applied*sim::H_vec[0] + dipole::atom_mu0demag_field_array_x[atom];
+	double hy = sim::H_applied*sim::H_vec[1] + dipole::atom_mu0demag_field_array_y[atom];
+	double hz = sim::H_applied*sim::H_vec[2] + dipole::atom_mu0demag_field_array_z[atom];
+
+	const double bq_delta_energy = exchange::single_spin_field_and_biquadratic_delta_energy(atom, old_spin, new_spin, hx, hy, hz);
+
+	// local applied fields
+	if(sim::local_applied_field){
+		const double B = mp::material[imaterial].applied_field_strength;
+		hx += B * mp::material[imaterial].applied_field_unit_vector[0];
+		hy += B * mp::material[imaterial].applied_field_unit_vector[1];
+		hz += B * mp::material[imaterial].applied_field_unit_vector[2];
+	}
+
+	const double dS[3] = {new_spin[0]-old_spin[0], new_spin[1]-old_spin[1], new_spin[2]-old_spin[2]};
+
+	double delta_energy = -(dS[0]*hx + dS[1]*hy + dS[2]*hz);
+
+	// nonlinear terms
+	delta_energy += bq_delta_energy;
+	delta_energy += exchange::single_spin_four_spin_energy(atom, new_spin[0], new_spin[1], new_spin[2])
+	              - exchange::single_spin_four_spin_energy(atom, old_spin[0], old_spin[1], old_spin[2]);
+	delta_energy += anisotropy::single_spin_energy(atom, imaterial, new_spin[0], new_spin[1], new_spin[2], sim::temperature)
+	              - anisotropy::single_spin_energy(atom, imaterial, old_spin[0], old_spin[1], old_spin[2], sim::temperature);
+
+	// vcma energy
+	const double vcma = program::fractional_electric_field_strength * spin_transport::get_voltage() * sim::internal::vcmak[imaterial];
+	delta_energy -= vcma * (new_spin[2]*new_spin[2] - old_spin[2]*old_spin[2]);
+
+	return delta_energy; // Tesla
+}
+
 } // end of namespace sim
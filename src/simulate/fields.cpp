@@ -33,6 +33,7 @@
 //====================================================================================================
 #include "anisotropy.hpp"
 #include "atoms.hpp"
+#include "create.hpp"
 #include "material.hpp"
 #include "errors.hpp"
 #include "exchange.hpp"
@@ -47,6 +48,7 @@
 #include "spintransport.hpp"
 #include "stats.hpp"
 #include "vmpi.hpp"
+#include "vutil.hpp"
 #include "../micromagnetic/internal.hpp"
 
 // sim module header
@@ -95,10 +97,6 @@ void calculate_spin_fields(const int start_index,const int end_index){
                     atoms::neighbour_list_end_index,
                     atoms::type_array, // type for atom
                     atoms::neighbour_list_array, // list of interactions between atoms
-                    atoms::neighbour_interaction_type_array, // list of interaction type for each pair of atoms with value given in exchange list
-                    atoms::i_exchange_list, // list of isotropic exchange constants
-                    atoms::v_exchange_list, // list of vectorial exchange constants
-                    atoms::t_exchange_list, // list of tensorial exchange constants
                     atoms::x_spin_array,
                     atoms::y_spin_array,
                     atoms::z_spin_array,
@@ -316,9 +314,28 @@ int calculate_thermal_fields(const int start_index,const int end_index){
       sigma_prefactor.push_back(sqrt_T*mp::material[mat].H_th_sigma);
    }
 
-   generate (atoms::x_total_external_field_array.begin()+start_index,atoms::x_total_external_field_array.begin()+end_index, mtrandom::gaussian);
-   generate (atoms::y_total_external_field_array.begin()+start_index,atoms::y_total_external_field_array.begin()+end_index, mtrandom::gaussian);
-   generate (atoms::z_total_external_field_array.begin()+start_index,atoms::z_total_external_field_array.begin()+end_index, mtrandom::gaussian);
+   // counter based noise is independent of threads and MPI decomposition
+   if(mtrandom::counter_based_noise){
+      mtrandom::counter_gaussian_fill(mtrandom::thermal_stream, start_index, end_index, create::global_atom_id,
+                                      atoms::x_total_external_field_array,
+                                      atoms::y_total_external_field_array,
+                                      atoms::z_total_external_field_array);
+   }
+   // when called from inside the threaded integrator draw noise from the
+   // independent generator of the calling thread
+   else if(vutil::in_parallel()){
+      std::mt19937& tgrnd = mtrandom::thread_grnd[vutil::thread_id()];
+      for(int atom=start_index;atom<end_index;atom++){
+         atoms::x_total_external_field_array[atom] = mtrandom::gaussianc(tgrnd);
+         atoms::y_total_external_field_array[atom] = mtrandom::gaussianc(tgrnd);
+         atoms::z_total_external_field_array[atom] = mtrandom::gaussianc(tgrnd);
+      }
+   }
+   else{
+      generate (atoms::x_total_external_field_array.begin()+start_index,atoms::x_total_external_field_array.begin()+end_index, mtrandom::gaussian);
+      generate (atoms::y_total_external_field_array.begin()+start_index,atoms::y_total_external_field_array.begin()+end_index, mtrandom::gaussian);
+      generate (atoms::z_total_external_field_array.begin()+start_index,atoms::z_total_external_field_array.begin()+end_index, mtrandom::gaussian);
+   }
 
    for(int atom=start_index;atom<end_index;atom++){
 
@@ -375,7 +392,8 @@ void calculate_fmr_fields(const int start_index,const int end_index){
 	const double Hy = Hfmry * Hsinwt;
 	const double Hz = Hfmrz * Hsinwt;
 
-	// Save fmr field strength for possible output
+	// Save fmr field strength for possible output (only once when called from multiple threads)
+	#pragma omp master
 	sim::fmr_field = Hsinwt;
 
 	if(sim::local_fmr_field==true){
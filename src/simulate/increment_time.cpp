@@ -14,7 +14,9 @@
 
 // Vampire headers
 #include "atoms.hpp"
+#include "cells.hpp"
 #include "dipole.hpp"
+#include "random.hpp"
 #include "sim.hpp"
 #include "spintorque.hpp"
 #include "spintransport.hpp"
@@ -37,6 +39,10 @@ void increment_time(){
    sim::checkpoint_loaded_flag=false;
 
 	sim::time++;
+	mtrandom::noise_counter++;
+
+   // spins have been updated so cell magnetisation must be recalculated
+   cells::magnetisation_dirty = true;
 	// sim::head_position[0]+=sim::head_speed*mp::dt_SI*1.0e10;
 
    // Update dipole fields
@@ -67,6 +67,15 @@ namespace sim{
          return true;
       }
       //-------------------------------------------------------------------
+      test="num-threads";
+      if(word==test){
+         int n = atoi(value.c_str());
+         // Test for valid range
+         vin::check_for_valid_int(n, word, line, prefix, 1, 1024,"input","1 - 1,024");
+         sim::num_threads = n;
+         return true;
+      }
+      //-------------------------------------------------------------------
       test="time-step";
       if(word==test){
          double dt = atof(value.c_str());
@@ -115,12 +124,24 @@ namespace sim{
             return true;
          }
          //--------------------------------------------------------------------
+         test="llg-heun-fused";
+         if( value == test ){
+            sim::integrator = sim::llg_heun_fused;
+            return true;
+         }
+         //--------------------------------------------------------------------
          test="monte-carlo";
          if( value == test ){
             sim::integrator = sim::monte_carlo;
             return true;
          }
          //--------------------------------------------------------------------
+         test="monte-carlo-coloured";
+         if( value == test ){
+            sim::integrator = sim::monte_carlo_coloured;
+            return true;
+         }
+         //--------------------------------------------------------------------
          test="llg-midpoint";
          if( value == test ){
             sim::integrator = sim::llg_midpoint;
@@ -149,9 +170,11 @@ namespace sim{
             terminaltextcolor(RED);
                std::cerr << "Error - value for \'sim:" << word << "\' must be one of:" << std::endl;
                std::cerr << "\t\"llg-heun\"" << std::endl;
+               std::cerr << "\t\"llg-heun-fused\"" << std::endl;
                std::cerr << "\t\"llg-midpoint\"" << std::endl;
                std::cerr << "\t\"llg-quantum\"" << std::endl;
                std::cerr << "\t\"monte-carlo\"" << std::endl;
+               std::cerr << "\t\"monte-carlo-coloured\"" << std::endl;
                std::cerr << "\t\"constrained-monte-carlo\"" << std::endl;
             terminaltextcolor(WHITE);
             err::vexit();
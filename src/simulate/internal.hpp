@@ -79,6 +79,11 @@ namespace sim{
 
       // shared Functions
       void llg_quantum_step();
+      void llg_heun_threaded_step();
+      void llg_heun_fused_step();
+      void llg_heun_fused_init();
+      void llg_heun_predictor(const int start_index, const int end_index);
+      void llg_heun_corrector(const int start_index, const int end_index);
 
       //-------------------------------------------------------------------------
       // Internal function declarations
@@ -0,0 +1,196 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2024. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// Standard Libraries
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// Vampire Header files
+#include "atoms.hpp"
+#include "errors.hpp"
+#include "LLG.hpp"
+#include "material.hpp"
+#include "sim.hpp"
+
+// sim module header
+#include "internal.hpp"
+
+namespace sim{
+
+namespace internal{
+
+namespace heun{
+
+   //---------------------------------------------------------------------------
+   // Minimal scratch state for fused Heun integration, stored interleaved
+   // (x,y,z per atom) so that each sweep streams a single array per quantity
+   //---------------------------------------------------------------------------
+   std::vector <double> initial_spin; // spin at start of time step
+   std::vector <double> euler_dS;     // predictor (Euler) gradient
+
+}
+
+//------------------------------------------------------------------------------
+// Function to allocate scratch arrays for fused Heun integration
+//------------------------------------------------------------------------------
+void llg_heun_fused_init(){
+
+   const size_t num_elements = 3*static_cast<size_t>(atoms::num_atoms);
+
+   if(heun::initial_spin.size() != num_elements){
+      heun::initial_spin.resize(num_elements, 0.0);
+      heun::euler_dS.resize(num_elements, 0.0);
+   }
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Fused predictor step for atoms in range start_index - end_index. The
+// initial spin and Euler gradient are stored and the normalised predicted
+// spin written directly to the spin arrays. The spin dependent fields must
+// have been calculated for all atoms before calling.
+//------------------------------------------------------------------------------
+void llg_heun_predictor(const int start_index, const int end_index){
+
+   for(int atom=start_index;atom<end_index;atom++){
+
+      const int imaterial=atoms::type_array[atom];
+      const double one_oneplusalpha_sq = mp::material[imaterial].one_oneplusalpha_sq; // material specific alpha and gamma
+      const double alpha_oneplusalpha_sq = mp::material[imaterial].alpha_oneplusalpha_sq;
+
+      // Store local spin in S and local field in H
+      const double S[3] = {atoms::x_spin_array[atom],atoms::y_spin_array[atom],atoms::z_spin_array[atom]};
+      const double H[3] = {atoms::x_total_spin_field_array[atom]+atoms::x_total_external_field_array[atom],
+                           atoms::y_total_spin_field_array[atom]+atoms::y_total_external_field_array[atom],
+                           atoms::z_total_spin_field_array[atom]+atoms::z_total_external_field_array[atom]};
+
+      // Calculate Delta S
+      double xyz[3];
+      xyz[0]=(one_oneplusalpha_sq)*(S[1]*H[2]-S[2]*H[1]) + (alpha_oneplusalpha_sq)*(S[1]*(S[0]*H[1]-S[1]*H[0])-S[2]*(S[2]*H[0]-S[0]*H[2]));
+      xyz[1]=(one_oneplusalpha_sq)*(S[2]*H[0]-S[0]*H[2]) + (alpha_oneplusalpha_sq)*(S[2]*(S[1]*H[2]-S[2]*H[1])-S[0]*(S[0]*H[1]-S[1]*H[0]));
+      xyz[2]=(one_oneplusalpha_sq)*(S[0]*H[1]-S[1]*H[0]) + (alpha_oneplusalpha_sq)*(S[0]*(S[2]*H[0]-S[0]*H[2])-S[1]*(S[1]*H[2]-S[2]*H[1]));
+
+      // Store initial spin and dS for corrector step
+      const size_t index = 3*static_cast<size_t>(atom);
+      heun::initial_spin[index+0] = S[0];
+      heun::initial_spin[index+1] = S[1];
+      heun::initial_spin[index+2] = S[2];
+
+      heun::euler_dS[index+0] = xyz[0];
+      heun::euler_dS[index+1] = xyz[1];
+      heun::euler_dS[index+2] = xyz[2];
+
+      // Calculate Euler Step
+      double S_new[3] = {S[0]+xyz[0]*mp::dt, S[1]+xyz[1]*mp::dt, S[2]+xyz[2]*mp::dt};
+
+      // Normalise Spin Length
+      const double mod_S = 1.0/sqrt(S_new[0]*S_new[0] + S_new[1]*S_new[1] + S_new[2]*S_new[2]);
+
+      // Write predicted spin
+      atoms::x_spin_array[atom]=S_new[0]*mod_S;
+      atoms::y_spin_array[atom]=S_new[1]*mod_S;
+      atoms::z_spin_array[atom]=S_new[2]*mod_S;
+
+   }
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Fused corrector step for atoms in range start_index - end_index. The Heun
+// gradient is calculated from the predicted spins and fields and combined
+// with the stored Euler gradient to give the final spin direction.
+//------------------------------------------------------------------------------
+void llg_heun_corrector(const int start_index, const int end_index){
+
+   for(int atom=start_index;atom<end_index;atom++){
+
+      const int imaterial=atoms::type_array[atom];
+      const double one_oneplusalpha_sq = mp::material[imaterial].one_oneplusalpha_sq;
+      const double alpha_oneplusalpha_sq = mp::material[imaterial].alpha_oneplusalpha_sq;
+
+      // Store local spin in S and local field in H
+      const double S[3] = {atoms::x_spin_array[atom],atoms::y_spin_array[atom],atoms::z_spin_array[atom]};
+      const double H[3] = {atoms::x_total_spin_field_array[atom]+atoms::x_total_external_field_array[atom],
+                           atoms::y_total_spin_field_array[atom]+atoms::y_total_external_field_array[atom],
+                           atoms::z_total_spin_field_array[atom]+atoms::z_total_external_field_array[atom]};
+
+      // Calculate Delta S
+      double xyz[3];
+      xyz[0]=(one_oneplusalpha_sq)*(S[1]*H[2]-S[2]*H[1]) + (alpha_oneplusalpha_sq)*(S[1]*(S[0]*H[1]-S[1]*H[0])-S[2]*(S[2]*H[0]-S[0]*H[2]));
+      xyz[1]=(one_oneplusalpha_sq)*(S[2]*H[0]-S[0]*H[2]) + (alpha_oneplusalpha_sq)*(S[2]*(S[1]*H[2]-S[2]*H[1])-S[0]*(S[0]*H[1]-S[1]*H[0]));
+      xyz[2]=(one_oneplusalpha_sq)*(S[0]*H[1]-S[1]*H[0]) + (alpha_oneplusalpha_sq)*(S[0]*(S[2]*H[0]-S[0]*H[2])-S[1]*(S[1]*H[2]-S[2]*H[1]));
+
+      // Calculate Heun Step
+      const size_t index = 3*static_cast<size_t>(atom);
+      double S_new[3];
+      S_new[0]=heun::initial_spin[index+0]+mp::half_dt*(heun::euler_dS[index+0]+xyz[0]);
+      S_new[1]=heun::initial_spin[index+1]+mp::half_dt*(heun::euler_dS[index+1]+xyz[1]);
+      S_new[2]=heun::initial_spin[index+2]+mp::half_dt*(heun::euler_dS[index+2]+xyz[2]);
+
+      // Normalise Spin Length
+      const double mod_S = 1.0/sqrt(S_new[0]*S_new[0] + S_new[1]*S_new[1] + S_new[2]*S_new[2]);
+
+      // Copy new spins to spin array
+      atoms::x_spin_array[atom]=S_new[0]*mod_S;
+      atoms::y_spin_array[atom]=S_new[1]*mod_S;
+      atoms::z_spin_array[atom]=S_new[2]*mod_S;
+
+   }
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Fused version of the LLG Heun integrator
+//
+// Performs the same arithmetic as sim::LLG_Heun() in the same order, giving
+// bitwise identical trajectories, but with a single sweep over the atoms for
+// each of the predictor and corrector steps. Only the initial spin and Euler
+// gradient are stored between steps (6 doubles per atom instead of 12).
+//------------------------------------------------------------------------------
+void llg_heun_fused_step(){
+
+   // check calling of routine if error checking is activated
+   if(err::check==true){std::cout << "sim::llg_heun_fused_step has been called" << std::endl;}
+
+   // Check for initialisation of scratch arrays
+   llg_heun_fused_init();
+
+   const int num_atoms=atoms::num_atoms;
+
+   // Calculate fields
+   calculate_spin_fields(0,num_atoms);
+   calculate_external_fields(0,num_atoms);
+
+   // Predictor step
+   llg_heun_predictor(0,num_atoms);
+
+   // Recalculate spin dependent fields
+   calculate_spin_fields(0,num_atoms);
+
+   // Corrector step
+   llg_heun_corrector(0,num_atoms);
+
+   return;
+
+}
+
+} // end of internal namespace
+
+} // end of sim namespace
@@ -0,0 +1,95 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2024. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// Standard Libraries
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+// Vampire Header files
+#include "atoms.hpp"
+#include "errors.hpp"
+#include "program.hpp"
+#include "sim.hpp"
+#include "vutil.hpp"
+
+// sim module header
+#include "internal.hpp"
+
+namespace sim{
+
+namespace internal{
+
+//------------------------------------------------------------------------------
+// Shared memory parallel version of the LLG Heun integrator
+//
+// The atom range is split into contiguous blocks, one per thread, and each
+// thread calculates the fields and fused predictor/corrector steps for its own
+// block. Barriers separate the phases where spins of other threads are read
+// (field calculation) from those where spins are written. Thermal noise is
+// drawn from an independent generator for each thread, and so trajectories are
+// statistically (but not bitwise) equivalent to the serial integrator.
+//------------------------------------------------------------------------------
+void llg_heun_threaded_step(){
+
+	// check calling of routine if error checking is activated
+	if(err::check==true){std::cout << "sim::llg_heun_threaded_step has been called" << std::endl;}
+
+	// Check for initialisation of scratch arrays
+	llg_heun_fused_init();
+
+	const int num_atoms=atoms::num_atoms;
+
+	// hamr and localised temperature thermal fields use the global random
+	// number generator, so calculate these external fields in serial
+	const bool serial_external_fields = (program::program == 7 || program::program == 13);
+	if(serial_external_fields) calculate_external_fields(0,num_atoms);
+
+	#pragma omp parallel num_threads(sim::num_threads)
+	{
+
+		// determine range of atoms integrated by this thread
+		int start_index = 0;
+		int end_index = 0;
+		vutil::thread_range(num_atoms, start_index, end_index);
+
+		// Calculate fields
+		calculate_spin_fields(start_index,end_index);
+		if(!serial_external_fields) calculate_external_fields(start_index,end_index);
+
+		// wait for all threads to finish reading initial spins
+		#pragma omp barrier
+
+		// Predictor step
+		llg_heun_predictor(start_index,end_index);
+
+		// wait for all predicted spins to be written
+		#pragma omp barrier
+
+		// Recalculate spin dependent fields
+		calculate_spin_fields(start_index,end_index);
+
+		// wait for all threads to finish reading predicted spins
+		#pragma omp barrier
+
+		// Corrector step
+		llg_heun_corrector(start_index,end_index);
+
+	} // end of parallel region
+
+	return;
+
+}
+
+} // end of internal namespace
+
+} // end of sim namespace
@@ -52,6 +52,7 @@
 #include "../micromagnetic/internal.hpp"
 #include "dipole.hpp"
 #include "errors.hpp"
+#include "exchange.hpp"
 #include "gpu.hpp"
 #include "grains.hpp"
 #include "environment.hpp"
@@ -212,7 +213,17 @@ int run(){
    anisotropy::initialize(atoms::num_atoms, atoms::type_array, mp::mu_s_array);
 
    // now seed generator
-	mtrandom::grnd.seed(vmpi::parallel_rng_seed(mtrandom::integration_seed));
+   const uint32_t integration_seed = vmpi::parallel_rng_seed(mtrandom::integration_seed);
+	mtrandom::grnd.seed(integration_seed);
+
+   // seed independent generators for shared memory threads
+   mtrandom::initialise_thread_generators(sim::num_threads, integration_seed);
+   if(sim::num_threads > 1){
+      zlog << zTs() << "Using " << sim::num_threads << " shared memory threads for CPU solvers" << std::endl;
+      #ifndef _OPENMP
+         zlog << zTs() << "Warning - code compiled without OpenMP support, so threaded solvers will run on a single thread" << std::endl;
+      #endif
+   }
 
    {
       // Set up statistical data sets
@@ -265,6 +276,9 @@ int run(){
 									  cs::system_dimensions[2],
 									  cells::local_cell_array);
 
+   // exchange interaction types are no longer needed with inline exchange constants
+   exchange::release_interaction_types();
+
    // initialise dipole field calculation
    dipole::initialize(cells::num_atoms_in_unit_cell,
                      cells::num_cells,
@@ -552,7 +566,7 @@ int run(){
    //------------------------------------------------
    // Output Monte Carlo statistics if applicable
    //------------------------------------------------
-   if(sim::integrator == sim::monte_carlo){
+   if(sim::integrator == sim::monte_carlo || sim::integrator == sim::monte_carlo_coloured){
       std::cout << "Monte Carlo statistics:" << std::endl;
       std::cout << "\tTotal moves: " << long(sim::mc_statistics_moves) << std::endl;
       std::cout << "\t" << ((sim::mc_statistics_moves - sim::mc_statistics_reject)/sim::mc_statistics_moves)*100.0 << "% Accepted" << std::endl;
@@ -575,6 +589,9 @@ int run(){
       zlog << zTs() << "\t" << (montecarlo::cmc::sphere_reject/montecarlo::cmc::mc_total)*100.0 << "% Rejected (Sphere)" << std::endl;
    }
 
+   // Output number of dipole field updates if applicable
+   dipole::output_update_statistics();
+
 	//program::LLB_Boltzmann();
 
    // De-initialize GPU
@@ -665,7 +682,8 @@ void integrate_serial(uint64_t n_steps){
          for(uint64_t ti=0;ti<n_steps;ti++){
             // Optionally select GPU accelerated version
             if(gpu::acceleration) gpu::llg_heun();
-            // Otherwise use CPU version
+            // Otherwise use CPU version (optionally multithreaded)
+            else if(sim::num_threads > 1) sim::internal::llg_heun_threaded_step();
             else sim::LLG_Heun();
 				if (environment::enabled && (sim::time)%environment::num_atomic_steps_env ==0){
 					environment::LLB(sim::temperature, sim::H_applied,sim::H_vec[0],sim::H_vec[1],sim::H_vec[2],mp::dt);
@@ -673,6 +691,21 @@ void integrate_serial(uint64_t n_steps){
             // Increment time
             sim::internal::increment_time();
          }
+         break;
+
+      case sim::llg_heun_fused: // LLG Heun (fused predictor/corrector)
+         for(uint64_t ti=0;ti<n_steps;ti++){
+            // Optionally select GPU accelerated version
+            if(gpu::acceleration) gpu::llg_heun();
+            // Otherwise use CPU version (optionally multithreaded)
+            else if(sim::num_threads > 1) sim::internal::llg_heun_threaded_step();
+            else sim::internal::llg_heun_fused_step();
+				if (environment::enabled && (sim::time)%environment::num_atomic_steps_env ==0){
+					environment::LLB(sim::temperature, sim::H_applied,sim::H_vec[0],sim::H_vec[1],sim::H_vec[2],mp::dt);
+				}
+            // Increment time
+            sim::internal::increment_time();
+         }
          break;
 
 		case 1: // Montecarlo
@@ -688,6 +721,19 @@ void integrate_serial(uint64_t n_steps){
 			}
 			break;
 
+		case sim::monte_carlo_coloured: // Montecarlo (coloured sets of atoms, optionally multithreaded)
+			for(uint64_t ti=0;ti<n_steps;ti++){
+
+				// Optionally select GPU accelerated version
+				if(gpu::acceleration) gpu::mc_step();
+
+				else montecarlo::mc_step_coloured(atoms::x_spin_array, atoms::y_spin_array, atoms::z_spin_array, atoms::type_array);
+
+				// increment time
+				sim::internal::increment_time();
+			}
+			break;
+
       case 2: // LLG Midpoint
          for(uint64_t ti=0;ti<n_steps;ti++){
             sim::LLG_Midpoint();
@@ -767,6 +813,7 @@ int integrate_mpi(uint64_t n_steps){
 	// Case statement to call integrator
 	switch(sim::integrator){
 		case 0: // LLG Heun
+		case sim::llg_heun_fused: // fused version not available with MPI, use standard
 			for(uint64_t ti=0;ti<n_steps;ti++){
 			#ifdef MPICF
 				// Select CUDA version if supported
@@ -789,6 +836,7 @@ int integrate_mpi(uint64_t n_steps){
 			}
 			break;
 
+		case sim::monte_carlo_coloured: // coloured version not available with MPI, use spatial decomposition
 		case 1: // Montecarlo
 
 			for(uint64_t ti=0;ti<n_steps;ti++){
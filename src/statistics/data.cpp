@@ -12,9 +12,13 @@
 // Vampire headers
 #include "stats.hpp"
 
+// Internal header
+#include "internal.hpp"
+
 namespace stats{
 
    int num_atoms; // Number of atoms for statistic purposes
+   bool energy_from_fields = false; // calculate bilinear exchange energy from exchange fields
 
    bool calculate_system_energy                 = false;
    bool calculate_grain_energy                  = false;
@@ -87,5 +91,17 @@ namespace stats{
    //-----------------------------------------------------------------------------
    namespace internal{
 
+      bool fused_initialized = false; // flag to set up fused statistics after masks are set
+      std::vector<magnetization_statistic_t*> fused_magnetization_list; // active magnetization statistics
+      std::vector<energy_statistic_t*> fused_energy_list; // active energy statistics
+      std::vector<int> fused_start; // start of sums for each statistic in packed array
+      std::vector<int> fused_offset; // offset of sums in packed array [atom*num_statistics + statistic]
+      std::vector<double> fused_sums; // packed sums for all statistics (reduced together)
+      std::vector<int> fused_cell_offset; // offset of cell magnetisation sums in packed array for each atom
+      int fused_cells_start = 0; // start of cell magnetisation sums in packed array
+      std::vector<double> fused_exchange_field_x; // bilinear exchange fields for field based energies
+      std::vector<double> fused_exchange_field_y;
+      std::vector<double> fused_exchange_field_z;
+
    } // end of internal namespace
 } // end of stats namespace
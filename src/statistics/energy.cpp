@@ -173,11 +173,6 @@ void energy_statistic_t::calculate(const std::vector<double>& sx,  // spin unit
 
    }
 
-   // save total energy accounting for factor 1/2 in double summation
-   for( int mask_id = 0; mask_id < mask_size; ++mask_id ){
-      exchange_energy[mask_id] = 0.5 * exchange_energy[mask_id];
-   }
-
    //---------------------------------------------------------------------------
    // Calculate anisotropy energy (in Tesla)
    //---------------------------------------------------------------------------
@@ -202,8 +197,53 @@ void energy_statistic_t::calculate(const std::vector<double>& sx,  // spin unit
       magnetostatic_energy[mask_id] += dipole::spin_magnetostatic_energy(atom, sx[atom], sy[atom], sz[atom]) * mm[atom];
    }
 
+   //---------------------------------------------------------------------------
+   // Reduce on all CPUS
+   //---------------------------------------------------------------------------
+   #ifdef MPICF
+      MPI_Allreduce(MPI_IN_PLACE,      &exchange_energy[0], mask_size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+      MPI_Allreduce(MPI_IN_PLACE,    &anisotropy_energy[0], mask_size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+      MPI_Allreduce(MPI_IN_PLACE, &applied_field_energy[0], mask_size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+      MPI_Allreduce(MPI_IN_PLACE, &magnetostatic_energy[0], mask_size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+   #endif
+
+   // calculate total energy and add to mean
+   normalize_energy();
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------------------------------
+// Function to set energies from summed energies (exchange, anisotropy, applied field and
+// magnetostatic for each mask id) calculated and reduced for all CPUs externally by the fused
+// statistics update
+//------------------------------------------------------------------------------------------------------
+void energy_statistic_t::set_energy_sums(const double* sums){
+
+   const int size = total_energy.size();
+   for( int mask_id = 0; mask_id < size; ++mask_id ){
+      exchange_energy[mask_id]      = sums[4*mask_id + 0];
+      anisotropy_energy[mask_id]    = sums[4*mask_id + 1];
+      applied_field_energy[mask_id] = sums[4*mask_id + 2];
+      magnetostatic_energy[mask_id] = sums[4*mask_id + 3];
+   }
+
+   // calculate total energy and add to mean
+   normalize_energy();
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------------------------------
+// Function to calculate total energy from summed energies and add energies to mean
+//------------------------------------------------------------------------------------------------------
+void energy_statistic_t::normalize_energy(){
+
    // save energy accounting for factor 1/2 in double summation
    for( int mask_id = 0; mask_id < mask_size; ++mask_id ){
+      exchange_energy[mask_id] = 0.5 * exchange_energy[mask_id];
       magnetostatic_energy[mask_id] = 0.5 * magnetostatic_energy[mask_id];
    }
 
@@ -217,17 +257,6 @@ void energy_statistic_t::calculate(const std::vector<double>& sx,  // spin unit
                               magnetostatic_energy[mask_id];
    }
 
-   //---------------------------------------------------------------------------
-   // Reduce on all CPUS
-   //---------------------------------------------------------------------------
-   #ifdef MPICF
-      MPI_Allreduce(MPI_IN_PLACE,      &exchange_energy[0], mask_size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE,    &anisotropy_energy[0], mask_size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, &applied_field_energy[0], mask_size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, &magnetostatic_energy[0], mask_size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE,         &total_energy[0], mask_size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-   #endif
-
    //---------------------------------------------------------------------------
    // Add energies to mean energies
    //---------------------------------------------------------------------------
@@ -14,6 +14,9 @@
 #include "vio.hpp"
 #include "vmpi.hpp"
 
+// Internal header
+#include "internal.hpp"
+
 namespace stats{
 
    void initialize(const int num_atoms,
@@ -32,6 +35,9 @@ namespace stats{
       //--------------------------------------------------------------
       stats::num_atoms = num_atoms;
 
+      // set up fused statistics on next update
+      stats::internal::fused_initialized = false;
+
       // define vector mask
       std::vector<int> mask(stats::num_atoms,0);
 
@@ -0,0 +1,58 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2024. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+#ifndef STATS_INTERNAL_H_
+#define STATS_INTERNAL_H_
+
+//---------------------------------------------------------------------
+// Defines shared internal data structures and functions for the
+// statistics implementation. These functions should
+// not be accessed outside of the statistics module.
+//---------------------------------------------------------------------
+
+// C++ standard library headers
+#include <vector>
+
+// Vampire headers
+#include "stats.hpp"
+
+namespace stats{
+
+namespace internal{
+
+   //-------------------------------------------------------------------------
+   // Internal data for fused statistics update
+   //-------------------------------------------------------------------------
+   extern bool fused_initialized; // flag to set up fused statistics after masks are set
+   extern std::vector<magnetization_statistic_t*> fused_magnetization_list; // active magnetization statistics
+   extern std::vector<energy_statistic_t*> fused_energy_list; // active energy statistics
+   extern std::vector<int> fused_start; // start of sums for each statistic in packed array
+   extern std::vector<int> fused_offset; // offset of sums in packed array [atom*num_statistics + statistic]
+   extern std::vector<double> fused_sums; // packed sums for all statistics (reduced together)
+   extern std::vector<int> fused_cell_offset; // offset of cell magnetisation sums in packed array for each atom
+   extern int fused_cells_start; // start of cell magnetisation sums in packed array
+   extern std::vector<double> fused_exchange_field_x; // bilinear exchange fields for field based energies
+   extern std::vector<double> fused_exchange_field_y;
+   extern std::vector<double> fused_exchange_field_z;
+
+   //-------------------------------------------------------------------------
+   // Internal function declarations
+   //-------------------------------------------------------------------------
+   void initialize_fused_statistics();
+   void update_fused_statistics(const std::vector<double>& sx, const std::vector<double>& sy, const std::vector<double>& sz,
+                                const std::vector<double>& mm, const std::vector<int>& mat, const double temperature);
+
+} // end of internal namespace
+
+} // end of stats namespace
+
+#endif //STATS_INTERNAL_H_
@@ -172,6 +172,34 @@ void magnetization_statistic_t::calculate_magnetization(const std::vector<double
       MPI_Allreduce(MPI_IN_PLACE, &magnetization[0], 4*mask_size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
    #endif
 
+   // normalise and add to mean
+   normalize_magnetization();
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------------------------------
+// Function to set magnetization from summed moments (mx, my, mz, m for each mask id) calculated
+// and reduced for all CPUs externally by the fused statistics update
+//------------------------------------------------------------------------------------------------------
+void magnetization_statistic_t::set_magnetization_sums(const double* sums){
+
+   const int msize = magnetization.size();
+   for(int idx=0; idx<msize; ++idx) magnetization[idx] = sums[idx];
+
+   // normalise and add to mean
+   normalize_magnetization();
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------------------------------
+// Function to normalise summed moments and add magnetization to mean
+//------------------------------------------------------------------------------------------------------
+void magnetization_statistic_t::normalize_magnetization(){
+
    // Calculate magnetisation length and normalize
    for(int mask_id=0; mask_id<mask_size; ++mask_id){
       double msat = magnetization[4*mask_id + 3];
@@ -120,7 +120,7 @@ void torque_statistic_t::calculate_torque(const std::vector<double>& sx, // spin
    std::fill(torque.begin(),torque.end(),0.0);
 
    // check for Monte Carlo solvers and recalculate fields
-   if(sim::integrator == sim::monte_carlo || sim::integrator == sim::cmc || sim::integrator == sim::hybrid_cmc){
+   if(sim::integrator == sim::monte_carlo || sim::integrator == sim::monte_carlo_coloured || sim::integrator == sim::cmc || sim::integrator == sim::hybrid_cmc){
       const int64_t num_atoms = sx.size();
       sim::calculate_spin_fields(0, num_atoms);
       sim::calculate_external_fields(0, num_atoms);
@@ -11,12 +11,25 @@
 //
 
 // C++ standard library headers
+#include <algorithm>
 
 // Vampire headers
+#include "anisotropy.hpp"
 #include "atoms.hpp"
+#include "cells.hpp"
+#include "dipole.hpp"
+#include "exchange.hpp"
 #include "gpu.hpp"
+#include "material.hpp"
+#include "micromagnetic.hpp"
 #include "sim.hpp"
 #include "stats.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+#include "vutil.hpp"
+
+// Internal header
+#include "internal.hpp"
 
 namespace stats{
 
@@ -25,6 +38,189 @@ namespace stats{
    //-----------------------------------------------------------------------------
    namespace internal{
 
+      //------------------------------------------------------------------------------------------------------
+      // Function to set up fused update of magnetization and energy statistics
+      //
+      // Sums for all active statistics are packed into a single array, with the offset of the sums
+      // for each atom in each statistic precomputed so that all statistics are accumulated in a
+      // single sweep over atoms and reduced on all CPUs with a single collective operation.
+      //------------------------------------------------------------------------------------------------------
+      void initialize_fused_statistics(){
+
+         fused_magnetization_list.clear();
+         fused_energy_list.clear();
+
+         // determine active statistics (in same order as separate update)
+         if(stats::calculate_system_magnetization)          fused_magnetization_list.push_back(&stats::system_magnetization);
+         if(stats::calculate_grain_magnetization)           fused_magnetization_list.push_back(&stats::grain_magnetization);
+         if(stats::calculate_material_magnetization)        fused_magnetization_list.push_back(&stats::material_magnetization);
+         if(stats::calculate_material_grain_magnetization)  fused_magnetization_list.push_back(&stats::material_grain_magnetization);
+         if(stats::calculate_height_magnetization)          fused_magnetization_list.push_back(&stats::height_magnetization);
+         if(stats::calculate_material_height_magnetization) fused_magnetization_list.push_back(&stats::material_height_magnetization);
+         if(stats::calculate_material_grain_height_magnetization) fused_magnetization_list.push_back(&stats::material_grain_height_magnetization);
+
+         if(stats::calculate_system_energy)                 fused_energy_list.push_back(&stats::system_energy);
+         if(stats::calculate_grain_energy)                  fused_energy_list.push_back(&stats::grain_energy);
+         if(stats::calculate_material_energy)               fused_energy_list.push_back(&stats::material_energy);
+
+         const int num_mag = fused_magnetization_list.size();
+         const int num_stats = num_mag + fused_energy_list.size();
+
+         fused_start.resize(num_stats+1);
+         fused_offset.resize(int64_t(stats::num_atoms)*int64_t(num_stats));
+         fused_start[0] = 0;
+
+         std::vector<int> mask;
+         std::vector<double> normalisation;
+
+         // 4 sums for each mask (mx, my, mz, m or exchange, anisotropy, applied, magnetostatic energy)
+         for(int s = 0; s < num_stats; s++){
+            if(s < num_mag) fused_magnetization_list[s]->get_mask(mask, normalisation);
+            else fused_energy_list[s-num_mag]->get_mask(mask, normalisation);
+            fused_start[s+1] = fused_start[s] + 4*normalisation.size();
+            for(int atom = 0; atom < stats::num_atoms; atom++){
+               fused_offset[int64_t(atom)*num_stats + s] = fused_start[s] + 4*mask[atom];
+            }
+         }
+
+         // optionally accumulate cell magnetisation in same sweep, with
+         // non-magnetic atoms added to a spare cell at the end
+         fused_cell_offset.clear();
+         fused_cells_start = fused_start[num_stats];
+         int num_cell_sums = 0;
+         if(cells::magnetisation_in_statistics && cells::num_cells > 0 && micromagnetic::discretisation_type != 1){
+            num_cell_sums = 3*(cells::num_cells + 1);
+            fused_cell_offset.resize(stats::num_atoms);
+            for(int atom = 0; atom < stats::num_atoms; atom++){
+               const int cell = mp::material[atoms::type_array[atom]].non_magnetic == 0 ? cells::atom_cell_id_array[atom] : cells::num_cells;
+               fused_cell_offset[atom] = fused_cells_start + 3*cell;
+            }
+            zlog << zTs() << "Cell magnetisation calculated in statistics sweep for later use in the same time step. "
+                 << "Dipole fields are updated before the statistics and still recalculate it." << std::endl;
+         }
+
+         fused_sums.resize(fused_start[num_stats] + num_cell_sums);
+
+         // allocate bilinear exchange fields for field based energies once
+         const bool field_energy = stats::energy_from_fields && num_stats > num_mag;
+         const int num_field_atoms = field_energy ? stats::num_atoms : 0;
+         std::vector<double>(num_field_atoms).swap(fused_exchange_field_x);
+         std::vector<double>(num_field_atoms).swap(fused_exchange_field_y);
+         std::vector<double>(num_field_atoms).swap(fused_exchange_field_z);
+
+         fused_initialized = true;
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------------------------------------
+      // Function to update magnetization and energy statistics in a single sweep over atoms
+      //------------------------------------------------------------------------------------------------------
+      void update_fused_statistics(const std::vector<double>& sx, // spin unit vector
+                                   const std::vector<double>& sy,
+                                   const std::vector<double>& sz,
+                                   const std::vector<double>& mm,
+                                   const std::vector<int>& mat,
+                                   const double temperature){
+
+         if(!fused_initialized) initialize_fused_statistics();
+
+         const int num_mag = fused_magnetization_list.size();
+         const int num_stats = num_mag + fused_energy_list.size();
+
+         if(num_stats == 0) return;
+
+         std::fill(fused_sums.begin(), fused_sums.end(), 0.0);
+
+         double* sums = fused_sums.data();
+
+         const bool fuse_cells = !fused_cell_offset.empty();
+
+         // calculate bilinear exchange fields for all atoms with the (vectorised)
+         // field kernel in parallel, so that exchange energies are given by -S.H
+         const bool field_energy = stats::energy_from_fields && num_stats > num_mag;
+         if(field_energy){
+
+            #pragma omp parallel num_threads(sim::num_threads)
+            {
+               int start_index = 0;
+               int end_index = 0;
+               vutil::thread_range(stats::num_atoms, start_index, end_index);
+               // zero fields in place for atoms of this thread
+               std::fill(fused_exchange_field_x.begin() + start_index, fused_exchange_field_x.begin() + end_index, 0.0);
+               std::fill(fused_exchange_field_y.begin() + start_index, fused_exchange_field_y.begin() + end_index, 0.0);
+               std::fill(fused_exchange_field_z.begin() + start_index, fused_exchange_field_z.begin() + end_index, 0.0);
+               exchange::bilinear_fields(start_index, end_index, sx, sy, sz,
+                                         fused_exchange_field_x, fused_exchange_field_y, fused_exchange_field_z);
+            }
+
+         }
+
+         for(int atom = 0; atom < stats::num_atoms; atom++){
+
+            const int* offset = &fused_offset[int64_t(atom)*num_stats];
+
+            const double m = mm[atom];
+            const double mx = sx[atom]*m;
+            const double my = sy[atom]*m;
+            const double mz = sz[atom]*m;
+
+            // add moment to all magnetization statistics
+            for(int s = 0; s < num_mag; s++){
+               double* sum = sums + offset[s];
+               sum[0] += mx;
+               sum[1] += my;
+               sum[2] += mz;
+               sum[3] += m;
+            }
+
+            // add moment to cell magnetisation
+            if(fuse_cells){
+               double* sum = sums + fused_cell_offset[atom];
+               sum[0] += mx;
+               sum[1] += my;
+               sum[2] += mz;
+            }
+
+            // calculate energies (in Tesla) once and add to all energy statistics
+            if(num_stats > num_mag){
+
+               double exchange_energy = 0.0;
+               if(field_energy) exchange_energy = -(sx[atom]*fused_exchange_field_x[atom] + sy[atom]*fused_exchange_field_y[atom] + sz[atom]*fused_exchange_field_z[atom]);
+               else exchange_energy = exchange::single_spin_energy(atom, sx[atom], sy[atom], sz[atom]);
+               if(exchange::biquadratic) exchange_energy += exchange::single_spin_biquadratic_energy(atom, sx[atom], sy[atom], sz[atom]);
+               const double ex = exchange_energy * m;
+               const double an = anisotropy::single_spin_energy(atom, mat[atom], sx[atom], sy[atom], sz[atom], temperature) * m;
+               const double ap = sim::spin_applied_field_energy(sx[atom], sy[atom], sz[atom]) * m;
+               const double ms = dipole::spin_magnetostatic_energy(atom, sx[atom], sy[atom], sz[atom]) * m;
+
+               for(int s = num_mag; s < num_stats; s++){
+                  double* sum = sums + offset[s];
+                  sum[0] += ex;
+                  sum[1] += an;
+                  sum[2] += ap;
+                  sum[3] += ms;
+               }
+
+            }
+
+         }
+
+         // Reduce all statistics on all CPUS
+         #ifdef MPICF
+            MPI_Allreduce(MPI_IN_PLACE, sums, fused_sums.size(), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+         #endif
+
+         // normalise statistics and add to mean
+         for(int s = 0; s < num_mag; s++) fused_magnetization_list[s]->set_magnetization_sums(sums + fused_start[s]);
+         for(int s = num_mag; s < num_stats; s++) fused_energy_list[s-num_mag]->set_energy_sums(sums + fused_start[s]);
+         if(fuse_cells) cells::set_magnetisation_from_statistics(sums + fused_cells_start);
+
+         return;
+
+      }
+
       //------------------------------------------------------------------------------------------------------
       // Function to update required statistics classes
       //------------------------------------------------------------------------------------------------------
@@ -47,19 +243,8 @@ namespace stats{
             gpu::stats::update();
          }
          else{
-            // update energy statistics
-            if(stats::calculate_system_energy)                 stats::system_energy.calculate(sx, sy, sz, mm, mat, temperature);
-            if(stats::calculate_grain_energy)                  stats::grain_energy.calculate(sx, sy, sz, mm, mat, temperature);
-            if(stats::calculate_material_energy)               stats::material_energy.calculate(sx, sy, sz, mm, mat, temperature);
-
-            // update magnetization statistics
-            if(stats::calculate_system_magnetization)          stats::system_magnetization.calculate_magnetization(sx,sy,sz,mm);
-            if(stats::calculate_grain_magnetization)           stats::grain_magnetization.calculate_magnetization(sx,sy,sz,mm);
-            if(stats::calculate_material_magnetization)        stats::material_magnetization.calculate_magnetization(sx,sy,sz,mm);
-            if(stats::calculate_material_grain_magnetization)  stats::material_grain_magnetization.calculate_magnetization(sx,sy,sz,mm);
-            if(stats::calculate_height_magnetization)          stats::height_magnetization.calculate_magnetization(sx,sy,sz,mm);
-            if(stats::calculate_material_height_magnetization) stats::material_height_magnetization.calculate_magnetization(sx,sy,sz,mm);
-            if(stats::calculate_material_grain_height_magnetization) stats::material_grain_height_magnetization.calculate_magnetization(sx,sy,sz,mm);
+            // update energy and magnetization statistics in a single pass
+            stats::internal::update_fused_statistics(sx, sy, sz, mm, mat, temperature);
 
             // update torque statistics
             if(stats::calculate_system_torque)          stats::system_torque.calculate_torque(sx,sy,sz,bxs,bys,bzs,bxe,bye,bze,mm);
@@ -22,6 +22,16 @@
 #include "vio.hpp"
 #include "program.hpp"
 
+//-----------------------------------------------------------------------------
+// Checkpoint files written before versioning start directly with the number of
+// atoms (version 0). Later files start with a marker which can never be a
+// number of atoms, followed by the format version:
+//
+//    version 1 : adds counter based noise time step after rng state
+//-----------------------------------------------------------------------------
+const uint64_t checkpoint_marker = 0xFFFFFFFF56414D50; // "VAMP"
+const int64_t checkpoint_version = 1;
+
 //-----------------------------------------------------------------------------
 // Function to save checkpoint file
 //-----------------------------------------------------------------------------
@@ -65,6 +75,10 @@ void save_checkpoint(){
    int32_t mt_p=0; // position in rng state
    mt_p=mtrandom::grnd.get_state(mt_state);
 
+   // write checkpoint format marker and version
+   chkfile.write(reinterpret_cast<const char*>(&checkpoint_marker),sizeof(uint64_t));
+   chkfile.write(reinterpret_cast<const char*>(&checkpoint_version),sizeof(int64_t));
+
    // write checkpoint variables to file
    chkfile.write(reinterpret_cast<const char*>(&natoms64),sizeof(uint64_t));
    chkfile.write(reinterpret_cast<const char*>(&time64),sizeof(int64_t));
@@ -81,6 +95,7 @@ void save_checkpoint(){
    chkfile.write(reinterpret_cast<const char*>(&output_rate_counter64),sizeof(int64_t));
    chkfile.write(reinterpret_cast<const char*>(&mt_p),sizeof(int32_t));
    chkfile.write(reinterpret_cast<const char*>(&mt_state[0]),sizeof(uint32_t)*mt_state.size());
+   chkfile.write(reinterpret_cast<const char*>(&mtrandom::noise_counter),sizeof(uint64_t));
 
    // write spin array to file
    chkfile.write(reinterpret_cast<const char*>(&atoms::x_spin_array[0]),sizeof(double)*natoms64);
@@ -162,8 +177,25 @@ void load_checkpoint(){
    sim::checkpoint_loaded_flag=true;
    zlog << zTs() << "Flag:checkpoint_loaded_flag = " << sim::checkpoint_loaded_flag <<std::endl;
 
-   // read checkpoint variables from file
+   // read checkpoint format version (files without marker are version 0)
+   int64_t version64 = 0;
    chkfile.read((char*)&natoms64,sizeof(uint64_t));
+   if(natoms64 == checkpoint_marker){
+      chkfile.read((char*)&version64,sizeof(int64_t));
+      chkfile.read((char*)&natoms64,sizeof(uint64_t));
+   }
+   zlog << zTs() << "Checkpoint file format version " << version64 << std::endl;
+
+   // check for checkpoint written by a newer code version
+   if(version64 > checkpoint_version){
+      terminaltextcolor(RED);
+      std::cerr << "Error: Checkpoint file " << chkfilename << " has format version " << version64 << " which is newer than the supported version " << checkpoint_version << ". Exiting." << std::endl;
+      terminaltextcolor(WHITE);
+      zlog << zTs() << "Error: Checkpoint file " << chkfilename << " has format version " << version64 << " which is newer than the supported version " << checkpoint_version << ". Exiting." << std::endl;
+      err::vexit();
+   }
+
+   // read checkpoint variables from file
    chkfile.read((char*)&time64,sizeof(int64_t));
    chkfile.read((char*)&eqtime64,sizeof(int64_t));
    chkfile.read((char*)&parity64,sizeof(int64_t));
@@ -178,10 +210,16 @@ void load_checkpoint(){
    chkfile.read((char*)&output_rate_counter64,sizeof(int64_t));
    chkfile.read((char*)&mt_p,sizeof(int32_t));
    chkfile.read((char*)&mt_state[0],sizeof(uint32_t)*mt_state.size());
+   // counter based noise time step (starts from zero for older files)
+   uint64_t noise_counter64 = 0;
+   if(version64 >= 1) chkfile.read((char*)&noise_counter64,sizeof(uint64_t));
 
    //std::cout << "random generator state loaded = " << mt_p << std::endl;
    // if continuing set state of rng
-   if(sim::load_checkpoint_continue_flag) mtrandom::grnd.set_state(mt_state, mt_p);
+   if(sim::load_checkpoint_continue_flag){
+      mtrandom::grnd.set_state(mt_state, mt_p);
+      mtrandom::noise_counter = noise_counter64;
+   }
 
    // check for rational number of atoms
    if(static_cast<uint64_t>(atoms::num_atoms-vmpi::num_halo_atoms) != natoms64){
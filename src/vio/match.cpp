@@ -682,6 +682,50 @@ namespace vin{
             mtrandom::integration_seed=is;
             return EXIT_SUCCESS;
         }
+        //--------------------------------------------------------------------
+        test="thermal-noise-generator";
+        if(word==test){
+            test="mersenne-twister";
+            if(value==test){
+                mtrandom::counter_based_noise=false;
+                return EXIT_SUCCESS;
+            }
+            test="philox";
+            if(value==test){
+                mtrandom::counter_based_noise=true;
+                return EXIT_SUCCESS;
+            }
+            else{
+            terminaltextcolor(RED);
+                std::cerr << "Error - value for \'sim:" << word << "\' must be one of:" << std::endl;
+                std::cerr << "\t\"mersenne-twister\"" << std::endl;
+                std::cerr << "\t\"philox\"" << std::endl;
+            terminaltextcolor(WHITE);
+                err::vexit();
+            }
+        }
+        //--------------------------------------------------------------------
+        test="energy-statistics-method";
+        if(word==test){
+            test="direct";
+            if(value==test){
+                stats::energy_from_fields=false;
+                return EXIT_SUCCESS;
+            }
+            test="fields";
+            if(value==test){
+                stats::energy_from_fields=true;
+                return EXIT_SUCCESS;
+            }
+            else{
+            terminaltextcolor(RED);
+                std::cerr << "Error - value for \'sim:" << word << "\' must be one of:" << std::endl;
+                std::cerr << "\t\"direct\"" << std::endl;
+                std::cerr << "\t\"fields\"" << std::endl;
+            terminaltextcolor(WHITE);
+                err::vexit();
+            }
+        }
         test="track-Ms";
      if(word==test){
         double m=atof(value.c_str());
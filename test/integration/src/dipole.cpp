@@ -0,0 +1,128 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2024. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cmath>
+
+// module headers
+#include "internal.hpp"
+
+//------------------------------------------------------------------------------
+// Function to run vampire in directory and read magnetisation (and optionally
+// magnetostatic energy in the column after the magnetisation) at last step
+//------------------------------------------------------------------------------
+bool run_and_read_magnetisation(const std::string dir, const std::string executable, double m[3], double* energy = nullptr){
+
+   // get root directory
+   std::string path = std::filesystem::current_path();
+
+   // change directory
+   if( !vt::chdir(path+"/data/"+dir) ) return false;
+
+   // run vampire
+   int vmp = vt::system(executable);
+   if( vmp != 0){
+      std::cerr << "Error running vampire. Returning as failed test." << std::endl;
+      vt::chdir(path);
+      return false;
+   }
+
+   std::string line;
+   std::string last_line;
+
+   // read last line of output file
+   std::ifstream ifile;
+   ifile.open("output");
+   while( getline(ifile, line) ){
+      if(line.size() > 0 && line[0] != '#') last_line = line;
+   }
+   ifile.close();
+
+   double time = 0.0;
+   double mm = 0.0; // length of magnetisation (not used)
+   std::stringstream liness(last_line);
+   liness >> time >> m[0] >> m[1] >> m[2] >> mm;
+   if(energy != nullptr) liness >> *energy;
+
+   // cleanup
+   vt::system("rm output log dipole-field");
+
+   // return to parent directory
+   return vt::chdir(path);
+
+}
+
+//------------------------------------------------------------------------------
+// Test to verify that a dipole solver gives the same magnetisation dynamics
+// as a reference solver to within a given tolerance
+//------------------------------------------------------------------------------
+bool dipole_solver_test(const std::string dir, const std::string reference_dir, const double tolerance, const std::string executable){
+
+   // fixed-width output for prettiness
+   std::stringstream test_name;
+   test_name << "Testing dipole solver for " << dir;
+   std::cout << std::setw(60) << std::left << test_name.str() << " : " << std::flush;
+
+   double m[3] = { 0.0, 0.0, 0.0 };
+   double ref[3] = { 0.0, 0.0, 0.0 };
+
+   if( !run_and_read_magnetisation(reference_dir, executable, ref) ) return false;
+   if( !run_and_read_magnetisation(dir, executable, m) ) return false;
+
+   // now test value obtained from code
+   if( fabs(m[0]-ref[0]) < tolerance && fabs(m[1]-ref[1]) < tolerance && fabs(m[2]-ref[2]) < tolerance ){
+      std::cout << "OK" << std::endl;
+      return true;
+   }
+   else{
+      std::cout << "FAIL | expected: " << ref[0] << "\t" << ref[1] << "\t" << ref[2] << "\t" << "\tobtained:  " << m[0] << "\t" << m[1] << "\t" << m[2] << std::endl;
+      return false;
+   }
+
+}
+
+//------------------------------------------------------------------------------
+// Test to verify that a parallel dipole solver run on a number of processors
+// gives the same magnetostatic energy (a sum over the dipole fields of all
+// cells) and magnetisation dynamics as a serial reference solver to within a
+// given relative tolerance
+//------------------------------------------------------------------------------
+bool parallel_dipole_solver_test(const std::string dir, const std::string reference_dir, const int num_processors, const double tolerance,
+                                 const std::string executable, const std::string parallel_executable){
+
+   // fixed-width output for prettiness
+   std::stringstream test_name;
+   test_name << "Testing dipole solver for " << dir << " (" << num_processors << " ranks)";
+   std::cout << std::setw(60) << std::left << test_name.str() << " : " << std::flush;
+
+   double m[3] = { 0.0, 0.0, 0.0 };
+   double ref[3] = { 0.0, 0.0, 0.0 };
+   double e = 0.0;
+   double ref_e = 0.0;
+
+   const std::string mpi_executable = "mpirun -np " + std::to_string(num_processors) + " " + parallel_executable;
+
+   if( !run_and_read_magnetisation(reference_dir, executable, ref, &ref_e) ) return false;
+   if( !run_and_read_magnetisation(dir, mpi_executable, m, &e) ) return false;
+
+   // now test value obtained from code
+   if( fabs(e-ref_e) < tolerance*fabs(ref_e) &&
+       fabs(m[0]-ref[0]) < tolerance && fabs(m[1]-ref[1]) < tolerance && fabs(m[2]-ref[2]) < tolerance ){
+      std::cout << "OK" << std::endl;
+      return true;
+   }
+   else{
+      std::cout << "FAIL | expected: " << ref[0] << "\t" << ref[1] << "\t" << ref[2] << "\t" << ref_e << "\t" << "\tobtained:  " << m[0] << "\t" << m[1] << "\t" << m[2] << "\t" << e << std::endl;
+      return false;
+   }
+
+}
@@ -70,3 +70,93 @@ bool exchange_test(std::string dir, double result, std::string executable){
    }
 
 }
+
+//------------------------------------------------------------------------------
+// Function to run vampire in directory and read data lines of output file
+//------------------------------------------------------------------------------
+bool run_and_read_output(const std::string dir, const std::string executable, std::vector<std::string>& data, bool& stencil){
+
+   // get root directory
+   std::string path = std::filesystem::current_path();
+
+   // change directory
+   if( !vt::chdir(path+"/data/"+dir) ) return false;
+
+   // run vampire
+   int vmp = vt::system(executable);
+   if( vmp != 0){
+      std::cerr << "Error running vampire. Returning as failed test." << std::endl;
+      vt::chdir(path);
+      return false;
+   }
+
+   std::string line;
+
+   // read all lines of output file after header
+   std::ifstream ifile;
+   ifile.open("output");
+   data.clear();
+   while( getline(ifile, line) ){
+      if(line.size() > 0 && line[0] != '#') data.push_back(line);
+   }
+   ifile.close();
+
+   // check if lattice stencil was used
+   std::ifstream lfile;
+   lfile.open("log");
+   stencil = false;
+   while( getline(lfile, line) ){
+      if(line.find("Lattice stencil used for") != std::string::npos) stencil = true;
+   }
+   lfile.close();
+
+   // cleanup
+   vt::system("rm output log");
+
+   // return to parent directory
+   return vt::chdir(path);
+
+}
+
+//------------------------------------------------------------------------------
+// Test to verify that the lattice stencil form of the exchange gives identical
+// results to the explicit neighbour lists for a crystal with surfaces
+//------------------------------------------------------------------------------
+bool exchange_stencil_test(const std::string dir, const std::string stencil_dir, const std::string executable){
+
+   // fixed-width output for prettiness
+   std::stringstream test_name;
+   test_name << "Testing exchange stencil for " << stencil_dir;
+   std::cout << std::setw(60) << std::left << test_name.str() << " : " << std::flush;
+
+   std::vector<std::string> data;
+   std::vector<std::string> stencil_data;
+   bool stencil = false;
+   bool stencil_used = false;
+
+   // run vampire with explicit neighbour lists and with lattice stencil
+   if( !run_and_read_output(dir, executable, data, stencil) ) return false;
+   if( !run_and_read_output(stencil_dir, executable, stencil_data, stencil_used) ) return false;
+
+   // stencil must be used in one calculation and not in the other
+   if( stencil || !stencil_used ){
+      std::cout << "FAIL | lattice stencil not used as expected" << std::endl;
+      return false;
+   }
+
+   // compare all output data written to full precision
+   if( data.size() == 0 || data.size() != stencil_data.size() ){
+      std::cout << "FAIL | expected: " << data.size() << " lines\tobtained:  " << stencil_data.size() << " lines" << std::endl;
+      return false;
+   }
+   for(size_t i = 0; i < data.size(); i++){
+      if( data[i] != stencil_data[i] ){
+         std::cout << "FAIL | expected: " << data[i] << "\tobtained:  " << stencil_data[i] << std::endl;
+         return false;
+      }
+   }
+
+   std::cout << "OK" << std::endl;
+   return true;
+
+}
@@ -19,6 +19,7 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 // module headers
 #include "internal.hpp"
@@ -32,5 +33,9 @@ namespace vt{
 // Test functions
 //------------------------------------------------------------------------------
 bool exchange_test(std::string dir, double result, std::string executable);
+bool exchange_stencil_test(const std::string dir, const std::string stencil_dir, const std::string executable);
+bool dipole_solver_test(const std::string dir, const std::string reference_dir, const double tolerance, const std::string executable);
+bool parallel_dipole_solver_test(const std::string dir, const std::string reference_dir, const int num_processors, const double tolerance,
+                                 const std::string executable, const std::string parallel_executable);
 bool integrator_test(const std::string dir, double rx, double ry, double rz, const std::string executable);
 bool material_atoms_test(const std::string dir, int n1, int n2, int n3, int n4, const std::string executable);
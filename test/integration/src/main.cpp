@@ -28,6 +28,10 @@ int main(){
 
    std::string exe = path_string+"/vampire-serial 1>/dev/null";
 
+   // parallel tests are only run if vampire-parallel has been compiled
+   const bool parallel = std::filesystem::exists(path_string+"/vampire-parallel");
+   std::string parallel_exe = path_string+"/vampire-parallel 1>/dev/null";
+
    //std::cout << exe << std::endl;
 
    //return 0;
@@ -40,6 +44,16 @@ int main(){
    // Exchange energy tests
    if( !exchange_test("crystals/sc" , -3.0e-17, exe ) ) fail += 1;
    if( !exchange_test("crystals/fcc", -2.4e-16, exe ) ) fail += 1;
+   if( !exchange_stencil_test("exchange/surface", "exchange/surface-stencil", exe ) ) fail += 1;
+
+   // Dipole solver tests
+   if( !dipole_solver_test("dipole/fmm", "dipole/tensor", 1.0e-5, exe ) ) fail += 1;
+
+   // Parallel dipole solver tests (need vampire-parallel compiled with -DFFT and FFTW-MPI)
+   if( parallel ){
+      if( !parallel_dipole_solver_test("dipole/distributed-fft", "dipole/tensor", 2, 1.0e-6, exe, parallel_exe ) ) fail += 1;
+      if( !parallel_dipole_solver_test("dipole/distributed-fft", "dipole/tensor", 4, 1.0e-6, exe, parallel_exe ) ) fail += 1;
+   }
 
    // Integrator tests
    if( !integrator_test("dynamics/heun",-0.106813,-0.337996,0.935067, exe ) ) fail += 1;
@@ -0,0 +1,236 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2024. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <iostream>
+#include <string>
+#include <vector>
+
+// vampire headers
+#include "atoms.hpp"
+#include "exchange.hpp"
+#include "../../../../src/exchange/internal.hpp"
+#include "../../../../src/montecarlo/internal.hpp"
+
+// include header for test functions
+#include "montecarlo_test.hpp"
+
+namespace ut{
+
+   namespace montecarlo{
+
+      // size of periodic simple cubic test lattice
+      const int L = 6;
+      const int num_atoms = L*L*L;
+
+      // atom id for periodic coordinates
+      int id(const int x, const int y, const int z){
+         return ((x+L)%L) + L*(((y+L)%L) + L*((z+L)%L));
+      }
+
+      //------------------------------------------------------------------------
+      // Function to generate neighbour list in vampire form from list of
+      // neighbour offsets
+      //------------------------------------------------------------------------
+      void generate_list(const std::vector<std::vector<int> >& offsets,
+                         std::vector<int>& start_index,
+                         std::vector<int>& end_index,
+                         std::vector<int>& list){
+
+         start_index.assign(num_atoms, 0);
+         end_index.assign(num_atoms, 0);
+         list.clear();
+
+         for(int z = 0; z < L; z++){
+            for(int y = 0; y < L; y++){
+               for(int x = 0; x < L; x++){
+                  const int atom = id(x, y, z);
+                  start_index[atom] = list.size();
+                  for(size_t n = 0; n < offsets.size(); n++) list.push_back(id(x+offsets[n][0], y+offsets[n][1], z+offsets[n][2]));
+                  end_index[atom] = list.size()-1; // inclusive end
+               }
+            }
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to check that no pair of atoms in list share a colour
+      //------------------------------------------------------------------------
+      int check_pairs(const std::vector<int>& colour,
+                      const std::vector<int>& start_index,
+                      const std::vector<int>& end_index,
+                      const std::vector<int>& list,
+                      const std::string name){
+
+         int ec = 0;
+
+         for(int atom = 0; atom < num_atoms; atom++){
+            for(int nn = start_index[atom]; nn <= end_index[atom]; nn++){
+               if(colour[atom] == colour[list[nn]]){
+                  std::cout << "FAIL: atoms " << atom << " and " << list[nn] << " interacting via " << name << " have the same colour " << colour[atom] << std::endl;
+                  ec++;
+               }
+            }
+         }
+
+         return ec;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to generate four spin quadruplets for square plaquettes in
+      // the xy plane, stored for each of the four atoms as central atom
+      //------------------------------------------------------------------------
+      void generate_quadruplets(std::vector<int>& start_index, std::vector<int>& neighbour_array){
+
+         std::vector<std::vector<int> > quadruplets(num_atoms);
+
+         for(int z = 0; z < L; z++){
+            for(int y = 0; y < L; y++){
+               for(int x = 0; x < L; x++){
+                  const int q[4] = { id(x, y, z), id(x+1, y, z), id(x+1, y+1, z), id(x, y+1, z) };
+                  for(int i = 0; i < 4; i++){
+                     for(int n = 1; n < 4; n++) quadruplets[q[i]].push_back(q[(i+n)%4]);
+                  }
+               }
+            }
+         }
+
+         start_index.assign(num_atoms+1, 0);
+         neighbour_array.clear();
+         for(int atom = 0; atom < num_atoms; atom++){
+            neighbour_array.insert(neighbour_array.end(), quadruplets[atom].begin(), quadruplets[atom].end());
+            start_index[atom+1] = neighbour_array.size()/3;
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to check that no two atoms in any quadruplet share a colour
+      //------------------------------------------------------------------------
+      int check_quadruplets(const std::vector<int>& colour,
+                            const std::vector<int>& start_index,
+                            const std::vector<int>& neighbour_array){
+
+         int ec = 0;
+
+         for(int atom = 0; atom < num_atoms; atom++){
+            for(int nn = start_index[atom]; nn < start_index[atom+1]; nn++){
+               const int q[4] = { atom, neighbour_array[3*nn+0], neighbour_array[3*nn+1], neighbour_array[3*nn+2] };
+               for(int i = 0; i < 4; i++){
+                  for(int j = i+1; j < 4; j++){
+                     if(colour[q[i]] == colour[q[j]]){
+                        std::cout << "FAIL: atoms " << q[i] << " and " << q[j] << " in four spin quadruplet of atom " << atom << " have the same colour " << colour[q[i]] << std::endl;
+                        ec++;
+                     }
+                  }
+               }
+            }
+         }
+
+         return ec;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to colour atoms and check that every atom has one colour
+      //------------------------------------------------------------------------
+      int colour_atoms(std::vector<int>& colour){
+
+         int ec = 0;
+
+         ::montecarlo::internal::colouring_initialised = false;
+         ::montecarlo::internal::initialize_colouring(num_atoms);
+
+         colour.assign(num_atoms, -1);
+         const std::vector<std::vector<int> >& colour_list = ::montecarlo::internal::colour_list;
+         for(size_t c = 0; c < colour_list.size(); c++){
+            for(size_t i = 0; i < colour_list[c].size(); i++){
+               const int atom = colour_list[c][i];
+               if(colour[atom] != -1){
+                  std::cout << "FAIL: atom " << atom << " has more than one colour" << std::endl;
+                  ec++;
+               }
+               colour[atom] = c;
+            }
+         }
+
+         for(int atom = 0; atom < num_atoms; atom++){
+            if(colour[atom] == -1){
+               std::cout << "FAIL: atom " << atom << " has not been coloured" << std::endl;
+               ec++;
+            }
+         }
+
+         return ec;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to test that atoms coupled by any term in the energy of a
+      // Monte Carlo move are given different colours
+      //------------------------------------------------------------------------
+      int test_colouring(const bool verbose){
+
+         int error_count = 0;
+
+         namespace ei = ::exchange::internal;
+
+         // nearest neighbour bilinear exchange
+         std::vector<std::vector<int> > nn_offsets = { {1,0,0}, {-1,0,0}, {0,1,0}, {0,-1,0}, {0,0,1}, {0,0,-1} };
+         generate_list(nn_offsets, atoms::neighbour_list_start_index, atoms::neighbour_list_end_index, atoms::neighbour_list_array);
+
+         ::exchange::biquadratic = false;
+         ::exchange::four_spin = false;
+         ei::fused_biquadratic = false;
+
+         std::vector<int> colour;
+
+         // bilinear exchange only
+         error_count += colour_atoms(colour);
+         error_count += check_pairs(colour, atoms::neighbour_list_start_index, atoms::neighbour_list_end_index, atoms::neighbour_list_array, "bilinear exchange");
+
+         // separate biquadratic exchange list of next nearest neighbours
+         std::vector<std::vector<int> > nnn_offsets = { {1,1,0}, {1,-1,0}, {-1,1,0}, {-1,-1,0},
+                                                        {1,0,1}, {1,0,-1}, {-1,0,1}, {-1,0,-1},
+                                                        {0,1,1}, {0,1,-1}, {0,-1,1}, {0,-1,-1} };
+         generate_list(nnn_offsets, ei::biquadratic_neighbour_list_start_index, ei::biquadratic_neighbour_list_end_index, ei::biquadratic_neighbour_list_array);
+         ::exchange::biquadratic = true;
+
+         error_count += colour_atoms(colour);
+         error_count += check_pairs(colour, atoms::neighbour_list_start_index, atoms::neighbour_list_end_index, atoms::neighbour_list_array, "bilinear exchange");
+         error_count += check_pairs(colour, ei::biquadratic_neighbour_list_start_index, ei::biquadratic_neighbour_list_end_index, ei::biquadratic_neighbour_list_array, "biquadratic exchange");
+
+         ::exchange::biquadratic = false;
+
+         // four spin exchange for square plaquettes
+         generate_quadruplets(ei::four_spin_start_index, ei::four_spin_neighbour_array);
+         ::exchange::four_spin = true;
+
+         error_count += colour_atoms(colour);
+         error_count += check_pairs(colour, atoms::neighbour_list_start_index, atoms::neighbour_list_end_index, atoms::neighbour_list_array, "bilinear exchange");
+         error_count += check_quadruplets(colour, ei::four_spin_start_index, ei::four_spin_neighbour_array);
+
+         ::exchange::four_spin = false;
+
+         return error_count;
+
+      }
+
+   } // end of montecarlo namespace
+
+} // end of ut namespace
@@ -0,0 +1,46 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) Richard F L Evans 2024. All rights reserved.
+//
+//   Email: richard.evans@york.ac.uk
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <iostream>
+
+// vampire headers
+#include "vio.hpp"
+
+// include header for test functions
+#include "montecarlo_test.hpp"
+
+namespace ut{
+//------------------------------------------------------------------------------
+// Function to test montecarlo module functions
+//------------------------------------------------------------------------------
+int montecarlo_tests(const bool verbose){
+
+   if(verbose) std::cout << "Testing montecarlo module" << std::endl;
+
+   int error_count = 0;
+
+   // open log file for messages from tested functions
+   if(!zlog.is_open()) vout::zLogTsInit("unit_tests");
+
+   error_count += ut::montecarlo::test_colouring(verbose);
+
+   if(verbose) std::cout <<          "================================" << std::endl;
+   if(error_count == 0) std::cout << " montecarlo          : PASS " << std::endl;
+   else std::cout <<                 " montecarlo          : FAIL " << error_count << std::endl;
+   if(verbose) std::cout <<          "================================" << std::endl;
+
+   return error_count;
+
+}
+
+}
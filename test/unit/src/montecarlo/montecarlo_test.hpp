@@ -0,0 +1,10 @@
+namespace ut{
+   namespace montecarlo{
+
+//------------------------------------------------------------------------------
+// Function to test colouring of atoms for coloured Monte Carlo
+//------------------------------------------------------------------------------
+int test_colouring(const bool verbose);
+
+}
+}
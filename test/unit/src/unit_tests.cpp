@@ -42,6 +42,7 @@ int main(int argc, char* argv[]){
    std::cout << "--------------------------------------------------" << std::endl;
 
    if( module.utility || all ) error_count += ut::utility_tests(verbose);
+   if( module.montecarlo || all ) error_count += ut::montecarlo_tests(verbose);
 
 
    // Summary
@@ -20,9 +20,11 @@ namespace ut{
    // simple struct specifying modules to test
    struct module_t {
       bool utility = false;
+      bool montecarlo = false;
    };
 
    // module level functions
    int utility_tests(const bool verbose);
+   int montecarlo_tests(const bool verbose);
 
 }